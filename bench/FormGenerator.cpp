@@ -0,0 +1,430 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: FormGenerator.cpp
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <random>
+
+#include "ui/layout/LayoutMetrics.h"
+#include "ui/layout/UiComponentConstraints.h"
+
+#include "FormGenerator.h"
+
+// The average width of a character of the default font.
+static const int AverageCharacterWidth = 7;
+
+void initFormSpec(FormSpec * formSpec)
+{
+  formSpec->rowCount = 100;
+  formSpec->uiComponentsPerRow = 4;
+  formSpec->labelMix = LabelMix::LeftLabels;
+  formSpec->sizeGroupCount = 0;
+  formSpec->sizeGroupFanout = 0;
+  formSpec->growXPercent = 0;
+  formSpec->growYPercent = 0;
+  formSpec->rowOrientationMix = RowOrientationMix::LeftRows;
+}
+
+BenchForm::BenchForm(int width,
+                     int height)
+:container(),
+ rowLayout(&container)
+{
+  container.setSize(width, height);
+  container.setPadding(11, 11, 11, 11);
+}
+
+BenchForm::~BenchForm()
+{
+  // The layout is destroyed after the labels and uiComponents, it never
+  // touches them again.
+  for(std::size_t i = 0; i < uiComponents.size(); ++i)
+  {
+    delete uiComponents.at(i);
+  }
+
+  for(std::size_t i = 0; i < labels.size(); ++i)
+  {
+    delete labels.at(i);
+  }
+}
+
+UiComponent * BenchForm::getContainer()
+{
+  return &container;
+}
+
+RowLayout * BenchForm::getRowLayout()
+{
+  return &rowLayout;
+}
+
+std::size_t BenchForm::getUiComponentCount() const
+{
+  return uiComponents.size();
+}
+
+UiComponent * BenchForm::createUiComponent(int preferredWidth,
+                                           int preferredHeight)
+{
+  uiComponents.push_back(new UiComponent(preferredWidth, preferredHeight));
+
+  return uiComponents.back();
+}
+
+Label * BenchForm::createLabel(const std::string& text)
+{
+  const LayoutMetrics& layoutMetrics = LayoutMetrics::getLayoutMetrics(LayoutMetrics::DefaultDpi);
+
+  labels.push_back(new Label(text,
+                             AverageCharacterWidth * static_cast<int>(text.size()),
+                             layoutMetrics.labelHeight));
+
+  return labels.back();
+}
+
+static RowOrientation::Value getRowOrientation(RowOrientationMix::Value rowOrientationMix,
+                                               std::size_t rowIndex)
+{
+  switch(rowOrientationMix)
+  {
+    case RowOrientationMix::CenterRows:
+      return RowOrientation::CenterRowOrientation;
+    case RowOrientationMix::RightRows:
+      return RowOrientation::RightRowOrientation;
+    case RowOrientationMix::MixedRows:
+      return static_cast<RowOrientation::Value>(rowIndex % 3);
+    default:
+      return RowOrientation::LeftRowOrientation;
+  }
+}
+
+// Returns false if the uiComponent at the specified index has no label.
+static bool getLabelOrientation(LabelMix::Value labelMix,
+                                std::size_t uiComponentIndex,
+                                LabelOrientation::Value * labelOrientation)
+{
+  switch(labelMix)
+  {
+    case LabelMix::NoLabels:
+      return false;
+    case LabelMix::RightLabels:
+      *labelOrientation = LabelOrientation::RightOrientation;
+      return true;
+    case LabelMix::TopLabels:
+      *labelOrientation = LabelOrientation::TopOrientation;
+      return true;
+    case LabelMix::BottomLabels:
+      *labelOrientation = LabelOrientation::BottomOrientation;
+      return true;
+    case LabelMix::MixedLabels:
+    {
+      static const LabelOrientation::Value labelOrientations[] = { LabelOrientation::LeftOrientation,
+                                                                   LabelOrientation::RightOrientation,
+                                                                   LabelOrientation::TopOrientation,
+                                                                   LabelOrientation::BottomOrientation };
+
+      const std::size_t index = uiComponentIndex % 5;
+
+      if(index == 4)
+      {
+        return false;
+      }
+
+      *labelOrientation = labelOrientations[index];
+      return true;
+    }
+    default:
+      *labelOrientation = LabelOrientation::LeftOrientation;
+      return true;
+  }
+}
+
+void generateSyntheticForm(BenchForm * benchForm,
+                           const FormSpec * formSpec,
+                           unsigned int seed)
+{
+  static const char * const labelTexts[] = { "Name:", "Address:", "Phone number:", "E-mail:", "City:", "Postal code:", "Country:", "Notes:" };
+
+  std::minstd_rand random(seed);
+
+  RowLayout * rowLayout = benchForm->getRowLayout();
+
+  const std::size_t uiComponentCount = formSpec->rowCount * formSpec->uiComponentsPerRow;
+
+  // Spread the members of each size group over the whole form.
+  const std::size_t sizeGroupMemberCount = formSpec->sizeGroupCount * formSpec->sizeGroupFanout;
+  const std::size_t sizeGroupStride = sizeGroupMemberCount > 0 && uiComponentCount > sizeGroupMemberCount ? uiComponentCount / sizeGroupMemberCount : 1;
+
+  std::size_t uiComponentIndex = 0;
+
+  for(std::size_t rowIndex = 0; rowIndex < formSpec->rowCount; ++rowIndex)
+  {
+    RowLayout::Row * row = rowLayout->addRow();
+
+    row->setRowOrientation(::getRowOrientation(formSpec->rowOrientationMix, rowIndex));
+
+    for(std::size_t i = 0; i < formSpec->uiComponentsPerRow; ++i, ++uiComponentIndex)
+    {
+      UiComponentConstraints uiComponentConstraints;
+      initUiComponentConstraints(&uiComponentConstraints);
+
+      if(uiComponentIndex % sizeGroupStride == 0)
+      {
+        const std::size_t member = uiComponentIndex / sizeGroupStride;
+
+        if(member < sizeGroupMemberCount)
+        {
+          uiComponentConstraints.sizeGroupId = static_cast<int>(member % formSpec->sizeGroupCount);
+          uiComponentConstraints.labelSizeGroupId = uiComponentConstraints.sizeGroupId + static_cast<int>(formSpec->sizeGroupCount);
+        }
+      }
+
+      if(static_cast<int>(random() % 100) < formSpec->growXPercent)
+      {
+        uiComponentConstraints.growX = 1 + static_cast<int>(random() % 3);
+      }
+
+      if(static_cast<int>(random() % 100) < formSpec->growYPercent)
+      {
+        uiComponentConstraints.growY = 1;
+      }
+
+      UiComponent * uiComponent = benchForm->createUiComponent(40 + static_cast<int>(random() % 120),
+                                                               15 + static_cast<int>(random() % 20));
+
+      LabelOrientation::Value labelOrientation = LabelOrientation::LeftOrientation;
+
+      if(::getLabelOrientation(formSpec->labelMix, uiComponentIndex, &labelOrientation))
+      {
+        uiComponentConstraints.labelOrientation = labelOrientation;
+        uiComponentConstraints.labelVerticalAlignment = static_cast<LabelVerticalAlignment::Value>(random() % 3);
+
+        row->addUiComponent(benchForm->createLabel(labelTexts[random() % 8]), uiComponent, &uiComponentConstraints);
+      }
+      else
+      {
+        row->addUiComponent(uiComponent, &uiComponentConstraints);
+      }
+    }
+  }
+}
+
+void generateDialogForm(BenchForm * benchForm,
+                        std::size_t sectionCount)
+{
+  enum
+  {
+    ButtonSizeGroup,
+    FieldLabelSizeGroup
+  };
+
+  static const char * const fieldTexts[] = { "User name:", "Server:", "Port:", "Proxy:", "Time-out in seconds:" };
+  static const char * const checkBoxTexts[] = { "Remember password", "Use a secure connection", "Reconnect automatically" };
+
+  const LayoutMetrics& layoutMetrics = LayoutMetrics::getLayoutMetrics(LayoutMetrics::DefaultDpi);
+
+  RowLayout * rowLayout = benchForm->getRowLayout();
+
+  for(std::size_t sectionIndex = 0; sectionIndex < sectionCount; ++sectionIndex)
+  {
+    UiComponentConstraints headingConstraints;
+    initUiComponentConstraints(&headingConstraints);
+
+    rowLayout->addRow()->addUiComponent(benchForm->createLabel("Connection settings"), &headingConstraints);
+
+    for(std::size_t fieldIndex = 0; fieldIndex < 5; ++fieldIndex)
+    {
+      UiComponentConstraints uiComponentConstraints;
+      initUiComponentConstraints(&uiComponentConstraints);
+
+      uiComponentConstraints.labelSizeGroupId = FieldLabelSizeGroup;
+      uiComponentConstraints.labelVerticalAlignment = LabelVerticalAlignment::MiddleAlignment;
+      uiComponentConstraints.growX = 1;
+
+      rowLayout->addRow()->addUiComponent(benchForm->createLabel(fieldTexts[fieldIndex]),
+                                          benchForm->createUiComponent(160, 23),
+                                          &uiComponentConstraints);
+    }
+
+    for(std::size_t checkBoxIndex = 0; checkBoxIndex < 3; ++checkBoxIndex)
+    {
+      UiComponentConstraints uiComponentConstraints;
+      initUiComponentConstraints(&uiComponentConstraints);
+
+      // A check box is a box with its text to the right.
+      uiComponentConstraints.labelOrientation = LabelOrientation::RightOrientation;
+
+      rowLayout->addRow()->addUiComponent(benchForm->createLabel(checkBoxTexts[checkBoxIndex]),
+                                          benchForm->createUiComponent(13, 13),
+                                          &uiComponentConstraints);
+    }
+  }
+
+  UiComponentConstraints notesConstraints;
+  initUiComponentConstraints(&notesConstraints);
+
+  notesConstraints.labelOrientation = LabelOrientation::TopOrientation;
+  notesConstraints.growX = 1;
+  notesConstraints.growY = 1;
+
+  rowLayout->addRow()->addUiComponent(benchForm->createLabel("Notes:"),
+                                      benchForm->createUiComponent(200, 80),
+                                      &notesConstraints);
+
+  RowLayout::Row * buttonRow = rowLayout->addRow();
+
+  buttonRow->setRowOrientation(RowOrientation::RightRowOrientation);
+
+  for(std::size_t buttonIndex = 0; buttonIndex < 3; ++buttonIndex)
+  {
+    UiComponentConstraints buttonConstraints;
+    initUiComponentConstraints(&buttonConstraints);
+
+    buttonConstraints.sizeGroupId = ButtonSizeGroup;
+
+    buttonRow->addUiComponent(benchForm->createUiComponent(layoutMetrics.buttonWidth - 10 + 10 * static_cast<int>(buttonIndex),
+                                                           layoutMetrics.buttonHeight),
+                              &buttonConstraints);
+  }
+}
+
+// Put the specified uiComponent and its label, if any, in the place of the
+// static layout or in a row of its own of the RowLayout of the form.
+template<std::size_t rowIndexT>
+static void addFixedDialogRow(BenchForm * benchForm,
+                              StaticDialogLayout * staticDialogLayout,
+                              Label * label,
+                              UiComponent * uiComponent,
+                              const UiComponentConstraints * uiComponentConstraints)
+{
+  if(staticDialogLayout)
+  {
+    staticDialogLayout->setUiComponent<rowIndexT, 0>(label, uiComponent);
+  }
+  else
+  {
+    benchForm->getRowLayout()->addRow()->addUiComponent(label, uiComponent, uiComponentConstraints);
+  }
+}
+
+void generateFixedDialogForm(BenchForm * benchForm,
+                             StaticDialogLayout * staticDialogLayout)
+{
+  const LayoutMetrics& layoutMetrics = LayoutMetrics::getLayoutMetrics(LayoutMetrics::DefaultDpi);
+
+  RowLayout * rowLayout = benchForm->getRowLayout();
+
+  UiComponentConstraints headingConstraints;
+  initUiComponentConstraints(&headingConstraints);
+
+  Label * heading = benchForm->createLabel("Connection settings");
+
+  if(staticDialogLayout)
+  {
+    staticDialogLayout->setUiComponent<0, 0>(heading);
+  }
+  else
+  {
+    rowLayout->addRow()->addUiComponent(heading, &headingConstraints);
+  }
+
+  UiComponentConstraints fieldConstraints;
+  initUiComponentConstraints(&fieldConstraints);
+
+  fieldConstraints.labelSizeGroupId = FixedDialogSizeGroup::FieldLabelSizeGroup;
+  fieldConstraints.labelVerticalAlignment = LabelVerticalAlignment::MiddleAlignment;
+
+  addFixedDialogRow<1>(benchForm, staticDialogLayout, benchForm->createLabel("User name:"), benchForm->createUiComponent(160, 23), &fieldConstraints);
+  addFixedDialogRow<2>(benchForm, staticDialogLayout, benchForm->createLabel("Server:"), benchForm->createUiComponent(160, 23), &fieldConstraints);
+  addFixedDialogRow<3>(benchForm, staticDialogLayout, benchForm->createLabel("Port:"), benchForm->createUiComponent(160, 23), &fieldConstraints);
+  addFixedDialogRow<4>(benchForm, staticDialogLayout, benchForm->createLabel("Proxy:"), benchForm->createUiComponent(160, 23), &fieldConstraints);
+  addFixedDialogRow<5>(benchForm, staticDialogLayout, benchForm->createLabel("Time-out in seconds:"), benchForm->createUiComponent(160, 23), &fieldConstraints);
+
+  // A check box is a box with its text to the right.
+  UiComponentConstraints checkBoxConstraints;
+  initUiComponentConstraints(&checkBoxConstraints);
+
+  checkBoxConstraints.labelOrientation = LabelOrientation::RightOrientation;
+
+  addFixedDialogRow<6>(benchForm, staticDialogLayout, benchForm->createLabel("Remember password"), benchForm->createUiComponent(13, 13), &checkBoxConstraints);
+  addFixedDialogRow<7>(benchForm, staticDialogLayout, benchForm->createLabel("Use a secure connection"), benchForm->createUiComponent(13, 13), &checkBoxConstraints);
+  addFixedDialogRow<8>(benchForm, staticDialogLayout, benchForm->createLabel("Reconnect automatically"), benchForm->createUiComponent(13, 13), &checkBoxConstraints);
+
+  UiComponentConstraints notesConstraints;
+  initUiComponentConstraints(&notesConstraints);
+
+  notesConstraints.labelOrientation = LabelOrientation::TopOrientation;
+
+  addFixedDialogRow<9>(benchForm, staticDialogLayout, benchForm->createLabel("Notes:"), benchForm->createUiComponent(200, 80), &notesConstraints);
+
+  UiComponent * buttons[3];
+
+  for(std::size_t buttonIndex = 0; buttonIndex < 3; ++buttonIndex)
+  {
+    buttons[buttonIndex] = benchForm->createUiComponent(layoutMetrics.buttonWidth - 10 + 10 * static_cast<int>(buttonIndex),
+                                                        layoutMetrics.buttonHeight);
+  }
+
+  if(staticDialogLayout)
+  {
+    staticDialogLayout->setUiComponent<10, 0>(buttons[0]);
+    staticDialogLayout->setUiComponent<10, 1>(buttons[1]);
+    staticDialogLayout->setUiComponent<10, 2>(buttons[2]);
+
+    return;
+  }
+
+  RowLayout::Row * buttonRow = rowLayout->addRow();
+
+  buttonRow->setRowOrientation(RowOrientation::RightRowOrientation);
+
+  UiComponentConstraints buttonConstraints;
+  initUiComponentConstraints(&buttonConstraints);
+
+  buttonConstraints.sizeGroupId = FixedDialogSizeGroup::ButtonSizeGroup;
+
+  for(std::size_t buttonIndex = 0; buttonIndex < 3; ++buttonIndex)
+  {
+    buttonRow->addUiComponent(buttons[buttonIndex], &buttonConstraints);
+  }
+}
+
+void generatePropertySheetForm(BenchForm * benchForm,
+                               std::size_t propertyCount)
+{
+  enum
+  {
+    NameSizeGroup
+  };
+
+  static const char * const nameTexts[] = { "Text", "Font", "Foreground color", "Background color", "Enabled", "Visible", "Tab index", "Tool tip" };
+
+  RowLayout * rowLayout = benchForm->getRowLayout();
+
+  for(std::size_t propertyIndex = 0; propertyIndex < propertyCount; ++propertyIndex)
+  {
+    UiComponentConstraints uiComponentConstraints;
+    initUiComponentConstraints(&uiComponentConstraints);
+
+    uiComponentConstraints.labelSizeGroupId = NameSizeGroup;
+    uiComponentConstraints.labelVerticalAlignment = LabelVerticalAlignment::MiddleAlignment;
+    uiComponentConstraints.horizontalGapLeft = 0;
+    uiComponentConstraints.growX = 1;
+
+    RowLayout::Row * row = rowLayout->addRow();
+
+    row->addUiComponent(benchForm->createLabel(nameTexts[propertyIndex % 8]),
+                        benchForm->createUiComponent(100, 21),
+                        &uiComponentConstraints);
+  }
+
+  rowLayout->setVerticalSpaceBetweenRows(1);
+}
@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: FormGenerator.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_BENCH_FORMGENERATOR_H_
+#define UI_LAYOUT_BENCH_FORMGENERATOR_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ui/UiComponent.h"
+#include "ui/Label.h"
+
+#include "ui/layout/RowLayout.h"
+#include "ui/layout/StaticRowLayout.h"
+
+/**
+ * The labels used by a synthetic form.
+ */
+struct LabelMix
+{
+  public:
+
+    enum Value
+    {
+      NoLabels,
+      LeftLabels,
+      RightLabels,
+      TopLabels,
+      BottomLabels,
+
+      /**
+       * Every label orientation and no label, in turn.
+       */
+      MixedLabels
+    };
+};
+
+/**
+ * The row orientations used by a synthetic form.
+ */
+struct RowOrientationMix
+{
+  public:
+
+    enum Value
+    {
+      LeftRows,
+      CenterRows,
+      RightRows,
+
+      /**
+       * Every row orientation, in turn.
+       */
+      MixedRows
+    };
+};
+
+/**
+ * The shape of a synthetic form.
+ */
+struct FormSpec
+{
+    std::size_t rowCount;
+
+    std::size_t uiComponentsPerRow;
+
+    LabelMix::Value labelMix;
+
+    /**
+     * The number of size groups, each with sizeGroupFanout uiComponents
+     * spread over the form. Their labels are in label size groups of the same
+     * shape.
+     */
+    std::size_t sizeGroupCount;
+
+    std::size_t sizeGroupFanout;
+
+    /**
+     * The percentage of the uiComponents that grow horizontally and
+     * vertically.
+     */
+    int growXPercent;
+
+    int growYPercent;
+
+    RowOrientationMix::Value rowOrientationMix;
+};
+
+void initFormSpec(FormSpec * formSpec);
+
+/**
+ * A headless container, its RowLayout and the labels and uiComponents it lays
+ * out.
+ */
+class BenchForm
+{
+  public:
+
+    BenchForm(int width,
+              int height);
+
+    ~BenchForm();
+
+    UiComponent * getContainer();
+
+    RowLayout * getRowLayout();
+
+    std::size_t getUiComponentCount() const;
+
+    UiComponent * createUiComponent(int preferredWidth,
+                                    int preferredHeight);
+
+    Label * createLabel(const std::string& text);
+
+  private:
+
+    BenchForm(const BenchForm&);
+
+    BenchForm& operator=(const BenchForm&);
+
+    UiComponent container;
+
+    RowLayout rowLayout;
+
+    std::vector<UiComponent *> uiComponents;
+
+    std::vector<Label *> labels;
+};
+
+/**
+ * Fill the specified form with random labels and uiComponents of the shape
+ * given by the specified spec. The same seed gives the same form.
+ */
+void generateSyntheticForm(BenchForm * benchForm,
+                           const FormSpec * formSpec,
+                           unsigned int seed);
+
+/**
+ * Fill the specified form with a settings dialog: sections of left labeled
+ * fields in label size groups, a check box column, a text area that grows and
+ * a row of OK, Cancel and Apply buttons of the same size.
+ */
+void generateDialogForm(BenchForm * benchForm,
+                        std::size_t sectionCount);
+
+/**
+ * The size groups of the fixed dialog form.
+ */
+struct FixedDialogSizeGroup
+{
+  public:
+
+    enum Value
+    {
+      ButtonSizeGroup,
+      FieldLabelSizeGroup
+    };
+};
+
+typedef StaticLabeledUiComponent<LabelOrientation::LeftOrientation,
+                                 LabelVerticalAlignment::MiddleAlignment,
+                                 -1,
+                                 -1,
+                                 -1,
+                                 FixedDialogSizeGroup::FieldLabelSizeGroup> StaticDialogField;
+
+typedef StaticLabeledUiComponent<LabelOrientation::RightOrientation> StaticDialogCheckBox;
+
+typedef StaticUiComponent<-1, -1, FixedDialogSizeGroup::ButtonSizeGroup> StaticDialogButton;
+
+/**
+ * The fixed dialog form as a StaticRowLayout: a heading, five left labeled
+ * fields, three check boxes, a text area with its label on top and a row of
+ * three buttons aligned to the right.
+ */
+typedef StaticRowLayout<-1,
+                        StaticRow<RowOrientation::LeftRowOrientation, 0, StaticUiComponent<> >,
+                        StaticRow<RowOrientation::LeftRowOrientation, 0, StaticDialogField>,
+                        StaticRow<RowOrientation::LeftRowOrientation, 0, StaticDialogField>,
+                        StaticRow<RowOrientation::LeftRowOrientation, 0, StaticDialogField>,
+                        StaticRow<RowOrientation::LeftRowOrientation, 0, StaticDialogField>,
+                        StaticRow<RowOrientation::LeftRowOrientation, 0, StaticDialogField>,
+                        StaticRow<RowOrientation::LeftRowOrientation, 0, StaticDialogCheckBox>,
+                        StaticRow<RowOrientation::LeftRowOrientation, 0, StaticDialogCheckBox>,
+                        StaticRow<RowOrientation::LeftRowOrientation, 0, StaticDialogCheckBox>,
+                        StaticRow<RowOrientation::LeftRowOrientation, 0, StaticLabeledUiComponent<LabelOrientation::TopOrientation> >,
+                        StaticRow<RowOrientation::RightRowOrientation, 0, StaticDialogButton, StaticDialogButton, StaticDialogButton> > StaticDialogLayout;
+
+/**
+ * Fill the specified form with one section of the settings dialog without
+ * anything that grows, the dialog a StaticRowLayout can lay out. If
+ * staticDialogLayout is not nullptr the labels and uiComponents are put in
+ * it, otherwise they are added to the RowLayout of the form.
+ */
+void generateFixedDialogForm(BenchForm * benchForm,
+                             StaticDialogLayout * staticDialogLayout);
+
+/**
+ * Fill the specified form with a property sheet: one row per property, the
+ * name to the left of a value field that takes the rest of the row.
+ */
+void generatePropertySheetForm(BenchForm * benchForm,
+                               std::size_t propertyCount);
+#endif /* UI_LAYOUT_BENCH_FORMGENERATOR_H_ */
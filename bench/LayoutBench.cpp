@@ -0,0 +1,582 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutBench.cpp
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "ui/layout/LayoutPhaseObserver.h"
+
+#include "ui/layout/private/LayoutKernels.h"
+
+#include "FormGenerator.h"
+
+// Every allocation of the process, counted by the replaced operator new.
+static std::atomic<std::size_t> allocationCount(0);
+
+void * operator new(std::size_t size)
+{
+  ++allocationCount;
+
+  void * memory = std::malloc(size > 0 ? size : 1);
+
+  if(!memory)
+  {
+    throw std::bad_alloc();
+  }
+
+  return memory;
+}
+
+void operator delete(void * memory) noexcept
+{
+  std::free(memory);
+}
+
+void * operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete[](void * memory) noexcept
+{
+  operator delete(memory);
+}
+
+void operator delete(void * memory, std::size_t) noexcept
+{
+  operator delete(memory);
+}
+
+void operator delete[](void * memory, std::size_t) noexcept
+{
+  operator delete(memory);
+}
+
+typedef std::chrono::steady_clock Clock;
+
+enum
+{
+  LayoutPhaseCount = LayoutPhase::ApplyBoundsPhase + 1
+};
+
+// The time spent in each phase over a number of layout passes.
+struct PhaseTimes
+{
+    Clock::time_point beginTimes[LayoutPhaseCount];
+
+    long long nanoseconds[LayoutPhaseCount];
+};
+
+static void beginLayoutPhase(LayoutPhase::Value layoutPhase, void * userData)
+{
+  static_cast<PhaseTimes *>(userData)->beginTimes[layoutPhase] = Clock::now();
+}
+
+static void endLayoutPhase(LayoutPhase::Value layoutPhase, void * userData)
+{
+  PhaseTimes * phaseTimes = static_cast<PhaseTimes *>(userData);
+
+  phaseTimes->nanoseconds[layoutPhase] += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - phaseTimes->beginTimes[layoutPhase]).count();
+}
+
+// The layout passes each form is timed with.
+enum LayoutPass
+{
+  // Measure and apply everything, like the first layout pass.
+  FullLayoutPass,
+
+  // Change the width of the container, every row is laid out again but
+  // nothing is measured.
+  ResizeLayoutPass,
+
+  // Change one uiComponent.
+  InvalidateLayoutPass
+};
+
+static const char * const layoutPassNames[] = { "full", "resize", "invalidate" };
+
+struct BenchOptions
+{
+    std::size_t threadCount;
+
+    // The number of uiComponents laid out per form and layout pass type,
+    // spread over as many layout passes as it takes.
+    std::size_t uiComponentBudget;
+
+    // The shape of the only grid to lay out, 0 rows to run every form and
+    // the layout kernels.
+    std::size_t gridRowCount;
+    std::size_t gridUiComponentsPerRow;
+};
+
+static void runLayoutPass(BenchForm * benchForm,
+                          LayoutPass layoutPass,
+                          std::size_t iteration)
+{
+  UiComponent * container = benchForm->getContainer();
+
+  if(layoutPass == FullLayoutPass)
+  {
+    benchForm->getRowLayout()->invalidateLayout();
+  }
+  else if(layoutPass == ResizeLayoutPass)
+  {
+    container->setSize(iteration % 2 == 0 ? 900 : 863, container->getHeight());
+  }
+  else
+  {
+    UiComponent * uiComponent = container->getUiComponentAt(iteration % container->getUiComponentCount());
+
+    benchForm->getRowLayout()->invalidateUiComponent(uiComponent);
+  }
+
+  benchForm->getRowLayout()->executeLayout(container);
+}
+
+static void benchForm(const char * name,
+                      BenchForm * benchForm,
+                      const BenchOptions * benchOptions)
+{
+  RowLayout * rowLayout = benchForm->getRowLayout();
+
+  rowLayout->setLayoutThreadCount(benchOptions->threadCount);
+
+  // The first layout pass applies every bounds and sizes the caches.
+  benchForm->getContainer()->doLayout();
+
+  const std::size_t uiComponentCount = benchForm->getUiComponentCount();
+
+  for(int layoutPass = FullLayoutPass; layoutPass <= InvalidateLayoutPass; ++layoutPass)
+  {
+    PhaseTimes phaseTimes;
+
+    std::memset(phaseTimes.nanoseconds, 0, sizeof(phaseTimes.nanoseconds));
+
+    const LayoutPhaseObserver layoutPhaseObserver = { &::beginLayoutPhase,
+                                                      &::endLayoutPhase,
+                                                      &phaseTimes };
+
+    const std::size_t iterationCount = std::max<std::size_t>(5, benchOptions->uiComponentBudget / (uiComponentCount > 0 ? uiComponentCount : 1));
+
+    // Warm up, then time.
+    runLayoutPass(benchForm, static_cast<LayoutPass>(layoutPass), 1);
+
+    rowLayout->setLayoutPhaseObserver(&layoutPhaseObserver);
+
+    const std::size_t firstAllocationCount = allocationCount;
+
+    for(std::size_t iteration = 0; iteration < iterationCount; ++iteration)
+    {
+      runLayoutPass(benchForm, static_cast<LayoutPass>(layoutPass), iteration);
+    }
+
+    const std::size_t layoutAllocationCount = allocationCount - firstAllocationCount;
+
+    rowLayout->setLayoutPhaseObserver(nullptr);
+
+    const double perUiComponent = 1.0 / (static_cast<double>(iterationCount) * static_cast<double>(uiComponentCount));
+
+    // The post layout phase contains the apply phase, report them apart.
+    std::printf("%-34s %-10s %7zu %9.1f %9.1f %9.1f %9.1f %9.1f %9.2f\n",
+                name,
+                layoutPassNames[layoutPass],
+                uiComponentCount,
+                static_cast<double>(phaseTimes.nanoseconds[LayoutPhase::PreLayoutPhase]) * perUiComponent,
+                static_cast<double>(phaseTimes.nanoseconds[LayoutPhase::SizeGroupPhase]) * perUiComponent,
+                static_cast<double>(phaseTimes.nanoseconds[LayoutPhase::PostLayoutPhase] - phaseTimes.nanoseconds[LayoutPhase::ApplyBoundsPhase]) * perUiComponent,
+                static_cast<double>(phaseTimes.nanoseconds[LayoutPhase::ApplyBoundsPhase]) * perUiComponent,
+                static_cast<double>(phaseTimes.nanoseconds[LayoutPhase::LayoutPassPhase]) * perUiComponent,
+                static_cast<double>(layoutAllocationCount) / static_cast<double>(iterationCount));
+  }
+}
+
+static void benchSyntheticForm(const char * name,
+                               const FormSpec * formSpec,
+                               const BenchOptions * benchOptions)
+{
+  BenchForm form(900, 100000);
+
+  generateSyntheticForm(&form, formSpec, 1);
+
+  ::benchForm(name, &form, benchOptions);
+}
+
+// A StaticRowLayout measures and lays out everything on every pass, so only
+// the whole layout pass is timed, to compare with the full layout pass of the
+// same form laid out by RowLayout.
+static void benchStaticDialogForm(const char * name,
+                                  const BenchOptions * benchOptions)
+{
+  BenchForm form(480, 2000);
+
+  StaticDialogLayout staticDialogLayout(form.getContainer());
+
+  generateFixedDialogForm(&form, &staticDialogLayout);
+
+  UiComponent * container = form.getContainer();
+
+  const std::size_t uiComponentCount = form.getUiComponentCount();
+
+  const std::size_t iterationCount = std::max<std::size_t>(5, benchOptions->uiComponentBudget / uiComponentCount);
+
+  // Warm up, then time.
+  container->doLayout();
+
+  const std::size_t firstAllocationCount = allocationCount;
+
+  const Clock::time_point startTime = Clock::now();
+
+  for(std::size_t iteration = 0; iteration < iterationCount; ++iteration)
+  {
+    container->doLayout();
+  }
+
+  const long long nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startTime).count();
+
+  const std::size_t layoutAllocationCount = allocationCount - firstAllocationCount;
+
+  const double perUiComponent = 1.0 / (static_cast<double>(iterationCount) * static_cast<double>(uiComponentCount));
+
+  std::printf("%-34s %-10s %7zu %9s %9s %9s %9s %9.1f %9.2f\n",
+              name,
+              layoutPassNames[FullLayoutPass],
+              uiComponentCount,
+              "-",
+              "-",
+              "-",
+              "-",
+              static_cast<double>(nanoseconds) * perUiComponent,
+              static_cast<double>(layoutAllocationCount) / static_cast<double>(iterationCount));
+}
+
+// Keeps the results of the kernels from being optimized away.
+static volatile int kernelResult;
+
+static void benchLayoutKernels(LayoutKernelLevel layoutKernelLevel,
+                               const char * name,
+                               std::size_t valueCount,
+                               const BenchOptions * benchOptions)
+{
+  // getLayoutKernels falls back to a lower level, which would be reported
+  // under the wrong name.
+  if(layoutKernelLevel > getSupportedLayoutKernelLevel())
+  {
+    std::printf("%-10s %9zu %13s\n", name, valueCount, "unsupported");
+
+    return;
+  }
+
+  const LayoutKernels& layoutKernels = getLayoutKernels(layoutKernelLevel);
+
+  // Coordinates and sizes as a layout pass sees them, some of them negative.
+  std::vector<int> values(valueCount);
+
+  for(std::size_t i = 0; i < valueCount; ++i)
+  {
+    values[i] = static_cast<int>((i * 7919) % 1000) - 100;
+  }
+
+  // The kernels are timed over the same number of values for every range
+  // size, the budget counts uiComponents as values.
+  const std::size_t iterationCount = std::max<std::size_t>(5, benchOptions->uiComponentBudget * 16 / valueCount);
+
+  long long nanoseconds[3];
+
+  // Warm up, then time. Adding and subtracting in turn keeps the values
+  // where they started.
+  layoutKernels.addToValues(values.data(), valueCount, 1);
+  layoutKernels.addToValues(values.data(), valueCount, -1);
+
+  Clock::time_point startTime = Clock::now();
+
+  for(std::size_t iteration = 0; iteration < iterationCount; ++iteration)
+  {
+    layoutKernels.addToValues(values.data(), valueCount, iteration % 2 == 0 ? 3 : -3);
+  }
+
+  nanoseconds[0] = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startTime).count();
+
+  int result = 0;
+
+  startTime = Clock::now();
+
+  for(std::size_t iteration = 0; iteration < iterationCount; ++iteration)
+  {
+    result += layoutKernels.getMaxValue(values.data(), valueCount, static_cast<int>(iteration % 2));
+  }
+
+  nanoseconds[1] = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startTime).count();
+
+  startTime = Clock::now();
+
+  for(std::size_t iteration = 0; iteration < iterationCount; ++iteration)
+  {
+    result += layoutKernels.getSumOfPositiveValues(values.data(), valueCount);
+  }
+
+  nanoseconds[2] = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startTime).count();
+
+  kernelResult = result;
+
+  const double perValue = 1.0 / (static_cast<double>(iterationCount) * static_cast<double>(valueCount));
+
+  std::printf("%-10s %9zu %13.3f %13.3f %13.3f\n",
+              name,
+              valueCount,
+              static_cast<double>(nanoseconds[0]) * perValue,
+              static_cast<double>(nanoseconds[1]) * perValue,
+              static_cast<double>(nanoseconds[2]) * perValue);
+}
+
+// Parse a count of at least 1 at the start of the specified text. Unlike
+// strtoul alone, no sign or white space is accepted.
+static bool parseCount(const char * text,
+                       char ** end,
+                       std::size_t * count)
+{
+  if(*text < '0' || *text > '9')
+  {
+    return false;
+  }
+
+  *count = static_cast<std::size_t>(std::strtoul(text, end, 10));
+
+  return *count > 0;
+}
+
+// Parse ROWSxCOLUMNS, the whole text must be consumed.
+static bool parseGridShape(const char * text,
+                           std::size_t * rowCount,
+                           std::size_t * uiComponentsPerRow)
+{
+  char * end = nullptr;
+
+  if(!parseCount(text, &end, rowCount) || *end != 'x')
+  {
+    return false;
+  }
+
+  return parseCount(end + 1, &end, uiComponentsPerRow) && *end == '\0';
+}
+
+static void printUsage(const char * program)
+{
+  std::printf("usage: %s [--threads=N] [--quick] [--grid=ROWSxCOLUMNS]\n"
+              "\n"
+              "Times the phases of RowLayout layout passes over synthetic and realistic forms\n"
+              "of headless uiComponents. Times are in nanoseconds per uiComponent, post is\n"
+              "postLayout without apply, total is the whole executeLayout.\n"
+              "\n"
+              "Then times every level of the layout kernels over large ranges of values, in\n"
+              "nanoseconds per value.\n"
+              "\n"
+              "--grid only lays out a grid of the specified shape, for example --grid=2500x20\n"
+              "for 50000 uiComponents, so that the process can be measured as a whole with\n"
+              "perf stat or valgrind --tool=cachegrind.\n",
+              program);
+}
+
+int main(int argc, char * argv[])
+{
+  BenchOptions benchOptions;
+
+  benchOptions.threadCount = 1;
+  benchOptions.uiComponentBudget = 2000000;
+  benchOptions.gridRowCount = 0;
+  benchOptions.gridUiComponentsPerRow = 0;
+
+  for(int i = 1; i < argc; ++i)
+  {
+    if(std::strncmp(argv[i], "--threads=", 10) == 0)
+    {
+      benchOptions.threadCount = static_cast<std::size_t>(std::strtoul(argv[i] + 10, nullptr, 10));
+    }
+    else if(std::strcmp(argv[i], "--quick") == 0)
+    {
+      benchOptions.uiComponentBudget = 100000;
+    }
+    else if(std::strncmp(argv[i], "--grid=", 7) == 0)
+    {
+      if(!parseGridShape(argv[i] + 7, &benchOptions.gridRowCount, &benchOptions.gridUiComponentsPerRow))
+      {
+        printUsage(argv[0]);
+
+        return 1;
+      }
+    }
+    else
+    {
+      printUsage(argv[0]);
+
+      return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+    }
+  }
+
+  std::printf("%-34s %-10s %7s %9s %9s %9s %9s %9s %9s\n",
+              "form", "pass", "count", "pre", "groups", "post", "apply", "total", "allocs");
+
+  char name[64];
+
+  if(benchOptions.gridRowCount > 0)
+  {
+    FormSpec formSpec;
+    initFormSpec(&formSpec);
+
+    formSpec.rowCount = benchOptions.gridRowCount;
+    formSpec.uiComponentsPerRow = benchOptions.gridUiComponentsPerRow;
+
+    std::snprintf(name, sizeof(name), "grid %zux%zu", formSpec.rowCount, formSpec.uiComponentsPerRow);
+
+    benchSyntheticForm(name, &formSpec, &benchOptions);
+
+    return 0;
+  }
+
+  // Rows x uiComponents per row.
+  static const std::size_t rowCounts[] = { 10, 100, 1000 };
+  static const std::size_t uiComponentsPerRowCounts[] = { 1, 4, 16 };
+
+  for(std::size_t i = 0; i < sizeof(rowCounts) / sizeof(rowCounts[0]); ++i)
+  {
+    for(std::size_t j = 0; j < sizeof(uiComponentsPerRowCounts) / sizeof(uiComponentsPerRowCounts[0]); ++j)
+    {
+      FormSpec formSpec;
+      initFormSpec(&formSpec);
+
+      formSpec.rowCount = rowCounts[i];
+      formSpec.uiComponentsPerRow = uiComponentsPerRowCounts[j];
+
+      std::snprintf(name, sizeof(name), "grid %zux%zu", formSpec.rowCount, formSpec.uiComponentsPerRow);
+
+      benchSyntheticForm(name, &formSpec, &benchOptions);
+    }
+  }
+
+  // Label orientations.
+  static const char * const labelMixNames[] = { "none", "left", "right", "top", "bottom", "mixed" };
+
+  for(int labelMix = LabelMix::NoLabels; labelMix <= LabelMix::MixedLabels; ++labelMix)
+  {
+    FormSpec formSpec;
+    initFormSpec(&formSpec);
+
+    formSpec.labelMix = static_cast<LabelMix::Value>(labelMix);
+
+    std::snprintf(name, sizeof(name), "labels %s", labelMixNames[labelMix]);
+
+    benchSyntheticForm(name, &formSpec, &benchOptions);
+  }
+
+  // Size group count x fanout.
+  static const std::size_t sizeGroupCounts[] = { 1, 8, 64 };
+  static const std::size_t sizeGroupFanouts[] = { 2, 16 };
+
+  for(std::size_t i = 0; i < sizeof(sizeGroupCounts) / sizeof(sizeGroupCounts[0]); ++i)
+  {
+    for(std::size_t j = 0; j < sizeof(sizeGroupFanouts) / sizeof(sizeGroupFanouts[0]); ++j)
+    {
+      FormSpec formSpec;
+      initFormSpec(&formSpec);
+
+      formSpec.sizeGroupCount = sizeGroupCounts[i];
+      formSpec.sizeGroupFanout = sizeGroupFanouts[j];
+
+      std::snprintf(name, sizeof(name), "size groups %zux%zu", formSpec.sizeGroupCount, formSpec.sizeGroupFanout);
+
+      benchSyntheticForm(name, &formSpec, &benchOptions);
+    }
+  }
+
+  // Grow constraints.
+  static const int growPercents[][2] = { { 25, 0 }, { 100, 0 }, { 25, 5 } };
+
+  for(std::size_t i = 0; i < sizeof(growPercents) / sizeof(growPercents[0]); ++i)
+  {
+    FormSpec formSpec;
+    initFormSpec(&formSpec);
+
+    formSpec.growXPercent = growPercents[i][0];
+    formSpec.growYPercent = growPercents[i][1];
+
+    std::snprintf(name, sizeof(name), "grow x %d%% y %d%%", formSpec.growXPercent, formSpec.growYPercent);
+
+    benchSyntheticForm(name, &formSpec, &benchOptions);
+  }
+
+  // Row orientations.
+  static const char * const rowOrientationMixNames[] = { "left", "center", "right", "mixed" };
+
+  for(int rowOrientationMix = RowOrientationMix::LeftRows; rowOrientationMix <= RowOrientationMix::MixedRows; ++rowOrientationMix)
+  {
+    FormSpec formSpec;
+    initFormSpec(&formSpec);
+
+    formSpec.rowOrientationMix = static_cast<RowOrientationMix::Value>(rowOrientationMix);
+
+    std::snprintf(name, sizeof(name), "rows %s", rowOrientationMixNames[rowOrientationMix]);
+
+    benchSyntheticForm(name, &formSpec, &benchOptions);
+  }
+
+  // Realistic forms.
+  {
+    BenchForm form(480, 2000);
+
+    generateDialogForm(&form, 2);
+
+    ::benchForm("dialog", &form, &benchOptions);
+  }
+
+  {
+    BenchForm form(480, 2000);
+
+    generateFixedDialogForm(&form, nullptr);
+
+    ::benchForm("fixed dialog", &form, &benchOptions);
+  }
+
+  benchStaticDialogForm("fixed dialog static", &benchOptions);
+
+  {
+    BenchForm form(300, 100000);
+
+    generatePropertySheetForm(&form, 2000);
+
+    ::benchForm("property sheet 2000", &form, &benchOptions);
+  }
+
+  // Layout kernels, over ranges from a long row to every uiComponent of a
+  // large form.
+  std::printf("\n%-10s %9s %13s %13s %13s\n",
+              "kernels", "values", "addToValues", "getMaxValue", "sumPositive");
+
+  static const LayoutKernelLevel layoutKernelLevels[] = { ScalarLayoutKernels, Sse2LayoutKernels, Avx2LayoutKernels };
+  static const char * const layoutKernelLevelNames[] = { "scalar", "sse2", "avx2" };
+  static const std::size_t valueCounts[] = { 4096, 65536, 1048576 };
+
+  for(std::size_t i = 0; i < sizeof(valueCounts) / sizeof(valueCounts[0]); ++i)
+  {
+    for(std::size_t j = 0; j < sizeof(layoutKernelLevels) / sizeof(layoutKernelLevels[0]); ++j)
+    {
+      benchLayoutKernels(layoutKernelLevels[j], layoutKernelLevelNames[j], valueCounts[i], &benchOptions);
+    }
+  }
+
+  return 0;
+}
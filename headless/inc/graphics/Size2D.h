@@ -0,0 +1,47 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: Size2D.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_HEADLESS_SIZE2D_H_
+#define UI_LAYOUT_HEADLESS_SIZE2D_H_
+
+/**
+ * A width and a height in pixels.
+ */
+class Size2D
+{
+  public:
+
+    Size2D();
+
+    Size2D(int width,
+           int height);
+
+    ~Size2D();
+
+    void setSize(int width,
+                 int height);
+
+    void setWidth(int width);
+
+    void setHeight(int height);
+
+    int getWidth() const;
+
+    int getHeight() const;
+
+  private:
+
+    int width;
+
+    int height;
+};
+#endif /* UI_LAYOUT_HEADLESS_SIZE2D_H_ */
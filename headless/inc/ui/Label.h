@@ -0,0 +1,53 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: Label.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_HEADLESS_LABEL_H_
+#define UI_LAYOUT_HEADLESS_LABEL_H_
+
+#include <string>
+
+#include "ui/UiComponent.h"
+
+/**
+ * An in-memory Label. The text is only stored, the preferred size must be set
+ * like the preferred size of any other headless UiComponent.
+ */
+class Label : public UiComponent
+{
+  public:
+
+    Label();
+
+    /**
+     * Create a new Label with the specified text and preferred size.
+     *
+     * @param[in] text the text of the label.
+     *
+     * @param[in] preferredWidth the preferred width in pixels.
+     *
+     * @param[in] preferredHeight the preferred height in pixels.
+     */
+    Label(const std::string& text,
+          int preferredWidth,
+          int preferredHeight);
+
+    virtual ~Label();
+
+    void setText(const std::string& text);
+
+    const std::string& getText() const;
+
+  private:
+
+    std::string text;
+};
+#endif /* UI_LAYOUT_HEADLESS_LABEL_H_ */
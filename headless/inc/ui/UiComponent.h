@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: UiComponent.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_HEADLESS_UICOMPONENT_H_
+#define UI_LAYOUT_HEADLESS_UICOMPONENT_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "graphics/Size2D.h"
+
+#include "ui/layout/ILayoutContainer.h"
+#include "ui/layout/IThreadSafeMeasurable.h"
+
+class ILayout;
+
+/**
+ * An in-memory UiComponent for running layouts without a windowing system,
+ * for example to compute the geometry of forms on a server or in snapshot
+ * tests. Its preferred size is whatever was last set with setPreferredSize and
+ * the bounds a layout gives it are only recorded.
+ *
+ * The preferred size can be computed on any thread, so layouts with more than
+ * one thread measure headless uiComponents in parallel. Subclasses that
+ * override getPreferredWidth or getPreferredHeight must override
+ * measurePreferredSize too. As a container, it takes the bounds of all of its
+ * changed children in one step.
+ */
+class UiComponent : public ILayoutContainer, public IThreadSafeMeasurable
+{
+  public:
+
+    UiComponent();
+
+    /**
+     * Create a new UiComponent with the specified preferred size.
+     *
+     * @param[in] preferredWidth the preferred width in pixels.
+     *
+     * @param[in] preferredHeight the preferred height in pixels.
+     */
+    UiComponent(int preferredWidth,
+                int preferredHeight);
+
+    virtual ~UiComponent();
+
+    virtual void addUiComponent(UiComponent * uiComponent);
+
+    virtual void removeUiComponent(UiComponent * uiComponent);
+
+    std::size_t getUiComponentCount() const;
+
+    UiComponent * getUiComponentAt(std::size_t index) const;
+
+    /**
+     * Return the container this uiComponent was added to or nullptr if it was
+     * not added to one.
+     */
+    UiComponent * getParent() const;
+
+    virtual void setLayout(ILayout * layout);
+
+    ILayout * getLayout() const;
+
+    /**
+     * Lay out the children of this uiComponent with its layout, if it has
+     * one. There is no windowing system to do it when this uiComponent is
+     * resized.
+     */
+    void doLayout();
+
+    virtual int getPreferredWidth();
+
+    virtual int getPreferredHeight();
+
+    Size2D getPreferredSize() const;
+
+    /**
+     * Set the size this uiComponent reports as its preferred size. A layout
+     * sets the preferred size of its container to the size its children
+     * need.
+     *
+     * @param[in] preferredWidth the preferred width in pixels.
+     *
+     * @param[in] preferredHeight the preferred height in pixels.
+     */
+    virtual void setPreferredSize(int preferredWidth,
+                                  int preferredHeight);
+
+    virtual void setSize(int width,
+                         int height);
+
+    virtual void setLocation(int x,
+                             int y);
+
+    int getX() const;
+
+    int getY() const;
+
+    int getWidth() const;
+
+    int getHeight() const;
+
+    Size2D getSize() const;
+
+    virtual void enableDrawing();
+
+    virtual void disableDrawing();
+
+    bool isDrawingEnabled() const;
+
+    void setPadding(int leftPadding,
+                    int rightPadding,
+                    int topPadding,
+                    int bottomPadding);
+
+    virtual int getLeftPadding();
+
+    virtual int getRightPadding();
+
+    virtual int getTopPadding();
+
+    virtual int getBottomPadding();
+
+    /**
+     * Return the width of the area of this uiComponent its children are laid
+     * out in, including the padding. A headless uiComponent has no border, so
+     * this is its width.
+     */
+    virtual int getClientWidth();
+
+    /**
+     * Return the height of the area of this uiComponent its children are laid
+     * out in, including the padding. A headless uiComponent has no border, so
+     * this is its height.
+     */
+    virtual int getClientHeight();
+
+    virtual void addUiComponents(UiComponent * const * uiComponents,
+                                 std::size_t count);
+
+    virtual void setBounds(const UiComponentBounds * uiComponentBounds,
+                           std::size_t count);
+
+    virtual void measurePreferredSize(int * preferredWidth,
+                                      int * preferredHeight) const;
+
+  private:
+
+    UiComponent(const UiComponent&);
+
+    UiComponent& operator=(const UiComponent&);
+
+    UiComponent * parent;
+
+    std::vector<UiComponent *> children;
+
+    ILayout * layout;
+
+    Size2D preferredSize;
+
+    int x;
+
+    int y;
+
+    Size2D size;
+
+    bool drawingEnabled;
+
+    int leftPadding;
+
+    int rightPadding;
+
+    int topPadding;
+
+    int bottomPadding;
+};
+#endif /* UI_LAYOUT_HEADLESS_UICOMPONENT_H_ */
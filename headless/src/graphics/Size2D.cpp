@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: Size2D.cpp
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "graphics/Size2D.h"
+
+Size2D::Size2D()
+:width(0),
+ height(0)
+{
+
+}
+
+Size2D::Size2D(int width,
+               int height)
+:width(width),
+ height(height)
+{
+
+}
+
+Size2D::~Size2D()
+{
+
+}
+
+void Size2D::setSize(int width,
+                     int height)
+{
+  this->width = width;
+  this->height = height;
+}
+
+void Size2D::setWidth(int width)
+{
+  this->width = width;
+}
+
+void Size2D::setHeight(int height)
+{
+  this->height = height;
+}
+
+int Size2D::getWidth() const
+{
+  return width;
+}
+
+int Size2D::getHeight() const
+{
+  return height;
+}
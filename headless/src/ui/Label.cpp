@@ -0,0 +1,43 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: Label.cpp
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ui/Label.h"
+
+Label::Label()
+:UiComponent()
+{
+
+}
+
+Label::Label(const std::string& text,
+             int preferredWidth,
+             int preferredHeight)
+:UiComponent(preferredWidth, preferredHeight),
+ text(text)
+{
+
+}
+
+Label::~Label()
+{
+
+}
+
+void Label::setText(const std::string& text)
+{
+  this->text = text;
+}
+
+const std::string& Label::getText() const
+{
+  return text;
+}
@@ -0,0 +1,272 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: UiComponent.cpp
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "ui/layout/ILayout.h"
+#include "ui/layout/UiComponentBounds.h"
+
+#include "ui/UiComponent.h"
+
+UiComponent::UiComponent()
+:parent(nullptr),
+ layout(nullptr),
+ x(0),
+ y(0),
+ drawingEnabled(true),
+ leftPadding(0),
+ rightPadding(0),
+ topPadding(0),
+ bottomPadding(0)
+{
+
+}
+
+UiComponent::UiComponent(int preferredWidth,
+                         int preferredHeight)
+:parent(nullptr),
+ layout(nullptr),
+ preferredSize(preferredWidth, preferredHeight),
+ x(0),
+ y(0),
+ drawingEnabled(true),
+ leftPadding(0),
+ rightPadding(0),
+ topPadding(0),
+ bottomPadding(0)
+{
+
+}
+
+UiComponent::~UiComponent()
+{
+  // The children are owned by the client, they only forget this container.
+  for(std::size_t i = 0; i < children.size(); ++i)
+  {
+    children.at(i)->parent = nullptr;
+  }
+
+  if(parent)
+  {
+    parent->removeUiComponent(this);
+  }
+}
+
+void UiComponent::addUiComponent(UiComponent * uiComponent)
+{
+  if(uiComponent->parent)
+  {
+    uiComponent->parent->removeUiComponent(uiComponent);
+  }
+
+  uiComponent->parent = this;
+
+  children.push_back(uiComponent);
+}
+
+void UiComponent::removeUiComponent(UiComponent * uiComponent)
+{
+  std::vector<UiComponent *>::iterator it = std::find(children.begin(), children.end(), uiComponent);
+
+  if(it != children.end())
+  {
+    (*it)->parent = nullptr;
+
+    children.erase(it);
+  }
+}
+
+std::size_t UiComponent::getUiComponentCount() const
+{
+  return children.size();
+}
+
+UiComponent * UiComponent::getUiComponentAt(std::size_t index) const
+{
+  return children.at(index);
+}
+
+UiComponent * UiComponent::getParent() const
+{
+  return parent;
+}
+
+void UiComponent::setLayout(ILayout * layout)
+{
+  this->layout = layout;
+}
+
+ILayout * UiComponent::getLayout() const
+{
+  return layout;
+}
+
+void UiComponent::doLayout()
+{
+  if(layout)
+  {
+    layout->executeLayout(this);
+  }
+}
+
+int UiComponent::getPreferredWidth()
+{
+  return preferredSize.getWidth();
+}
+
+int UiComponent::getPreferredHeight()
+{
+  return preferredSize.getHeight();
+}
+
+Size2D UiComponent::getPreferredSize() const
+{
+  return preferredSize;
+}
+
+void UiComponent::setPreferredSize(int preferredWidth,
+                                   int preferredHeight)
+{
+  preferredSize.setSize(preferredWidth, preferredHeight);
+}
+
+void UiComponent::setSize(int width,
+                          int height)
+{
+  size.setSize(width, height);
+}
+
+void UiComponent::setLocation(int x,
+                              int y)
+{
+  this->x = x;
+  this->y = y;
+}
+
+int UiComponent::getX() const
+{
+  return x;
+}
+
+int UiComponent::getY() const
+{
+  return y;
+}
+
+int UiComponent::getWidth() const
+{
+  return size.getWidth();
+}
+
+int UiComponent::getHeight() const
+{
+  return size.getHeight();
+}
+
+Size2D UiComponent::getSize() const
+{
+  return size;
+}
+
+void UiComponent::enableDrawing()
+{
+  drawingEnabled = true;
+}
+
+void UiComponent::disableDrawing()
+{
+  drawingEnabled = false;
+}
+
+bool UiComponent::isDrawingEnabled() const
+{
+  return drawingEnabled;
+}
+
+void UiComponent::setPadding(int leftPadding,
+                             int rightPadding,
+                             int topPadding,
+                             int bottomPadding)
+{
+  this->leftPadding = leftPadding;
+  this->rightPadding = rightPadding;
+  this->topPadding = topPadding;
+  this->bottomPadding = bottomPadding;
+}
+
+int UiComponent::getLeftPadding()
+{
+  return leftPadding;
+}
+
+int UiComponent::getRightPadding()
+{
+  return rightPadding;
+}
+
+int UiComponent::getTopPadding()
+{
+  return topPadding;
+}
+
+int UiComponent::getBottomPadding()
+{
+  return bottomPadding;
+}
+
+int UiComponent::getClientWidth()
+{
+  return size.getWidth();
+}
+
+int UiComponent::getClientHeight()
+{
+  return size.getHeight();
+}
+
+void UiComponent::addUiComponents(UiComponent * const * uiComponents,
+                                  std::size_t count)
+{
+  children.reserve(children.size() + count);
+
+  for(std::size_t i = 0; i < count; ++i)
+  {
+    addUiComponent(uiComponents[i]);
+  }
+}
+
+void UiComponent::setBounds(const UiComponentBounds * uiComponentBounds,
+                            std::size_t count)
+{
+  // Nothing is drawn, so the bounds are applied without disabling drawing.
+  for(std::size_t i = 0; i < count; ++i)
+  {
+    if(uiComponentBounds[i].changed & UiComponentBounds::SizeChanged)
+    {
+      uiComponentBounds[i].uiComponent->setSize(uiComponentBounds[i].width,
+                                                uiComponentBounds[i].height);
+    }
+
+    if(uiComponentBounds[i].changed & UiComponentBounds::LocationChanged)
+    {
+      uiComponentBounds[i].uiComponent->setLocation(uiComponentBounds[i].x,
+                                                    uiComponentBounds[i].y);
+    }
+  }
+}
+
+void UiComponent::measurePreferredSize(int * preferredWidth,
+                                       int * preferredHeight) const
+{
+  *preferredWidth = preferredSize.getWidth();
+  *preferredHeight = preferredSize.getHeight();
+}
@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: ILayoutContainer.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_ILAYOUTCONTAINER_H_
+#define UI_LAYOUT_ILAYOUTCONTAINER_H_
+
+#include <cstddef>
+
+class UiComponent;
+struct UiComponentBounds;
+
+/**
+ * Optional interface for containers that can handle many children in one
+ * step. A layout checks whether its container implements this interface and
+ * falls back to the regular UiComponent functions, one child at a time, if it
+ * does not.
+ */
+class ILayoutContainer
+{
+  protected:
+
+    ILayoutContainer()
+    {
+
+    }
+
+  public:
+
+    virtual ~ILayoutContainer()
+    {
+
+    }
+
+    /**
+     * Add the specified uiComponents to this container as children, in order.
+     *
+     * @param[in] uiComponents the uiComponents that will be added to this
+     * container.
+     *
+     * @param[in] count the number of uiComponents.
+     */
+    virtual void addUiComponents(UiComponent * const * uiComponents,
+                                 std::size_t count) = 0;
+
+    /**
+     * Move and resize the specified children of this container in one step,
+     * without redrawing any of them in between. Only the parts of the bounds
+     * specified by UiComponentBounds::changed need to be applied.
+     *
+     * @param[in] uiComponentBounds the new bounds of the children.
+     *
+     * @param[in] count the number of bounds.
+     */
+    virtual void setBounds(const UiComponentBounds * uiComponentBounds,
+                           std::size_t count) = 0;
+};
+#endif /* UI_LAYOUT_ILAYOUTCONTAINER_H_ */
@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: IMeasurableText.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_IMEASURABLETEXT_H_
+#define UI_LAYOUT_IMEASURABLETEXT_H_
+
+#include <string>
+
+/**
+ * Optional interface for labels whose preferred size only depends on their
+ * text and their font. A layout checks whether a label implements this
+ * interface and, if it does, reuses the size that was measured for any label
+ * with the same text and font instead of measuring the label again.
+ *
+ * When the text of such a label changes, the label must be invalidated in the
+ * layout as usual. When a font changes or is destroyed, the font must be
+ * invalidated in the layout, see RowLayout::invalidateFont.
+ */
+class IMeasurableText
+{
+  protected:
+
+    IMeasurableText()
+    {
+
+    }
+
+  public:
+
+    virtual ~IMeasurableText()
+    {
+
+    }
+
+    /**
+     * Return a value that identifies the font of this label, such as the
+     * address of the font object. Labels with the same font must return the
+     * same value.
+     *
+     * @return the identity of the font of this label.
+     */
+    virtual const void * getFontIdentity() const = 0;
+
+    /**
+     * Return the text of this label.
+     *
+     * @return the text of this label.
+     */
+    virtual const std::string& getText() const = 0;
+};
+#endif /* UI_LAYOUT_IMEASURABLETEXT_H_ */
@@ -0,0 +1,53 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: IThreadSafeMeasurable.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_ITHREADSAFEMEASURABLE_H_
+#define UI_LAYOUT_ITHREADSAFEMEASURABLE_H_
+
+/**
+ * Optional interface for labels and uiComponents whose preferred size can be
+ * computed on any thread. A layout checks whether a label or uiComponent
+ * implements this interface and, if the layout has more than one thread,
+ * measures it on the threads of the layout. Labels and uiComponents that do
+ * not implement it are measured with getPreferredWidth and
+ * getPreferredHeight on the thread that runs the layout pass.
+ */
+class IThreadSafeMeasurable
+{
+  protected:
+
+    IThreadSafeMeasurable()
+    {
+
+    }
+
+  public:
+
+    virtual ~IThreadSafeMeasurable()
+    {
+
+    }
+
+    /**
+     * Compute the preferred size of this label or uiComponent. May be called
+     * on any thread, at the same time as on other labels and uiComponents,
+     * so it must not touch state that is owned by the UI thread. Must give the
+     * same size as getPreferredWidth and getPreferredHeight.
+     *
+     * @param[out] preferredWidth the preferred width in pixels.
+     *
+     * @param[out] preferredHeight the preferred height in pixels.
+     */
+    virtual void measurePreferredSize(int * preferredWidth,
+                                      int * preferredHeight) const = 0;
+};
+#endif /* UI_LAYOUT_ITHREADSAFEMEASURABLE_H_ */
@@ -0,0 +1,42 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutAllocator.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_LAYOUTALLOCATOR_H_
+#define UI_LAYOUT_LAYOUTALLOCATOR_H_
+
+#include <cstddef>
+
+/**
+ * Hooks used by a layout to allocate the memory that holds its rows,
+ * uiComponent wrappers and constraints. The layout requests memory in large
+ * blocks and hands out the individual objects from those blocks itself.
+ */
+struct LayoutAllocator
+{
+    /**
+     * Return a block of at least the specified size in bytes that is suitably
+     * aligned for any object. Must not return nullptr.
+     */
+    void * (*allocate)(std::size_t size, void * userData);
+
+    /**
+     * Release a block that was returned by allocate. The specified size is the
+     * size that was passed to allocate.
+     */
+    void (*deallocate)(void * memory, std::size_t size, void * userData);
+
+    /**
+     * Passed as is to allocate and deallocate.
+     */
+    void * userData;
+};
+#endif /* UI_LAYOUT_LAYOUTALLOCATOR_H_ */
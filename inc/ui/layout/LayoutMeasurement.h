@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutMeasurement.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_LAYOUTMEASUREMENT_H_
+#define UI_LAYOUT_LAYOUTMEASUREMENT_H_
+
+#include <vector>
+
+/**
+ * The bounds of one row within the container, excluding the vertical space
+ * above the row.
+ */
+struct RowExtent
+{
+    int x;
+
+    int y;
+
+    int width;
+
+    int height;
+};
+
+/**
+ * The size a layout would give its container and the bounds of each of its
+ * rows, as computed by RowLayout::measure.
+ */
+struct LayoutMeasurement
+{
+    /**
+     * The width the container needs to fit every row, including its padding.
+     */
+    int preferredWidth;
+
+    /**
+     * The height the container needs to fit every row, including its padding.
+     */
+    int preferredHeight;
+
+    /**
+     * The bounds of every row, in row order.
+     */
+    std::vector<RowExtent> rowExtents;
+};
+#endif /* UI_LAYOUT_LAYOUTMEASUREMENT_H_ */
@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutMetrics.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_LAYOUTMETRICS_H_
+#define UI_LAYOUT_LAYOUTMETRICS_H_
+
+/**
+ * The platform default spacing and standard sizes in pixels at one DPI. The
+ * metrics of each DPI are built once from the values UiComponentSize gives for
+ * DefaultDpi and shared by every layout at that DPI.
+ */
+struct LayoutMetrics
+{
+    enum
+    {
+      // The DPI at which one pixel is one device independent pixel.
+      DefaultDpi = 96
+    };
+
+    /**
+     * Return the metrics for the specified DPI. The metrics are built on the
+     * first request for a DPI and never change afterwards. May be called on
+     * any thread.
+     *
+     * @param[in] dpi the DPI, DefaultDpi is used if it is not greater than 0.
+     *
+     * @return the metrics for the specified DPI.
+     */
+    static const LayoutMetrics& getLayoutMetrics(int dpi);
+
+    /**
+     * Scale the specified length in pixels from one DPI to another, rounding
+     * to the nearest pixel.
+     *
+     * @param[in] value the length in pixels at fromDpi.
+     *
+     * @param[in] fromDpi the DPI of the specified length.
+     *
+     * @param[in] toDpi the DPI to scale to.
+     *
+     * @return the length in pixels at toDpi.
+     */
+    static int scale(int value,
+                     int fromDpi,
+                     int toDpi);
+
+    int dpi;
+
+    /**
+     * The vertical space between unrelated rows, used by layouts whose
+     * vertical space between rows is not specified.
+     */
+    int verticalSpaceBetweenRows;
+
+    /**
+     * The horizontal gap between related uiComponents, used for the sides of
+     * uiComponents whose gap is not specified.
+     */
+    int horizontalGap;
+
+    int buttonWidth;
+
+    int buttonHeight;
+
+    int labelHeight;
+};
+#endif /* UI_LAYOUT_LAYOUTMETRICS_H_ */
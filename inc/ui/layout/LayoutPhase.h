@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutPhase.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_LAYOUTPHASE_H_
+#define UI_LAYOUT_LAYOUTPHASE_H_
+
+/**
+ * The phases of a layout pass of a RowLayout.
+ */
+struct LayoutPhase
+{
+  public:
+
+    enum Value
+    {
+      /**
+       * The whole layout pass, RowLayout::executeLayout. Contains the other
+       * phases.
+       */
+      LayoutPassPhase,
+
+      /**
+       * Measure the labels and uiComponents that changed and start the rows
+       * that are laid out again over from the measured sizes.
+       */
+      PreLayoutPhase,
+
+      /**
+       * Resize the labels and uiComponents of the size groups that changed.
+       */
+      SizeGroupPhase,
+
+      /**
+       * Fit the label rows above and below the rows that are laid out again
+       * to their labels, once the size groups are resized.
+       */
+      LabelRowPhase,
+
+      /**
+       * Place, grow and align the rows. Contains ApplyBoundsPhase.
+       */
+      PostLayoutPhase,
+
+      /**
+       * Apply the bounds that changed to the labels and uiComponents.
+       */
+      ApplyBoundsPhase
+    };
+};
+#endif /* UI_LAYOUT_LAYOUTPHASE_H_ */
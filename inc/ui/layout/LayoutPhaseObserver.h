@@ -0,0 +1,41 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutPhaseObserver.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_LAYOUTPHASEOBSERVER_H_
+#define UI_LAYOUT_LAYOUTPHASEOBSERVER_H_
+
+#include "ui/layout/LayoutPhase.h"
+
+/**
+ * Hooks called by a layout at the start and at the end of each phase of a
+ * layout pass, for example to time the phases. Phases nest, the end of a
+ * phase is reported before the end of the phase that contains it. Called on
+ * the thread that runs the layout pass.
+ */
+struct LayoutPhaseObserver
+{
+    /**
+     * Called when the specified phase starts.
+     */
+    void (*beginLayoutPhase)(LayoutPhase::Value layoutPhase, void * userData);
+
+    /**
+     * Called when the specified phase ends.
+     */
+    void (*endLayoutPhase)(LayoutPhase::Value layoutPhase, void * userData);
+
+    /**
+     * Passed as is to beginLayoutPhase and endLayoutPhase.
+     */
+    void * userData;
+};
+#endif /* UI_LAYOUT_LAYOUTPHASEOBSERVER_H_ */
@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutResult.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_LAYOUTRESULT_H_
+#define UI_LAYOUT_LAYOUTRESULT_H_
+
+#include <cstddef>
+
+#include "ui/layout/LayoutMeasurement.h"
+#include "ui/layout/UiComponentBounds.h"
+
+class LayoutResultPrivate;
+
+/**
+ * The outcome of a layout pass computed by RowLayout::computeLayout: the
+ * preferred size of the container, the bounds of every label and uiComponent
+ * and the bounds of every row. A result never changes once computed and is
+ * applied to the uiComponents with RowLayout::commit.
+ */
+class LayoutResult
+{
+  public:
+
+    LayoutResult();
+
+    LayoutResult(const LayoutResult& other);
+
+    LayoutResult& operator=(const LayoutResult& other);
+
+    ~LayoutResult();
+
+    int getPreferredWidth() const;
+
+    int getPreferredHeight() const;
+
+    /**
+     * Return the number of bounds in this result, one for every label and
+     * one for every uiComponent.
+     *
+     * @return the number of bounds in this result.
+     */
+    std::size_t getBoundsCount() const;
+
+    /**
+     * Return the bounds at the specified index. The bounds are in row order
+     * and the bounds of a label come right before the bounds of its
+     * uiComponent. Every bounds is marked as changed in both size and
+     * location.
+     *
+     * @param[in] index an index less than LayoutResult::getBoundsCount.
+     *
+     * @return the bounds at the specified index.
+     */
+    const UiComponentBounds& getBoundsAt(std::size_t index) const;
+
+    std::size_t getRowCount() const;
+
+    /**
+     * Return the bounds of the specified row within the container, after the
+     * row was aligned and grown.
+     *
+     * @param[in] row an index less than LayoutResult::getRowCount.
+     *
+     * @return the bounds of the specified row.
+     */
+    const RowExtent& getRowExtentAt(std::size_t row) const;
+
+  private:
+
+    LayoutResultPrivate * d;
+
+    friend class RowLayout;
+};
+#endif /* UI_LAYOUT_LAYOUTRESULT_H_ */
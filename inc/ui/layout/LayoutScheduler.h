@@ -0,0 +1,40 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutScheduler.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_LAYOUTSCHEDULER_H_
+#define UI_LAYOUT_LAYOUTSCHEDULER_H_
+
+class RowLayout;
+
+/**
+ * Hook used by a layout to ask the client to run a layout pass later, usually
+ * at the next tick of the event loop.
+ *
+ * Changing a layout only marks it as needing a layout pass. The first change
+ * after a layout pass calls scheduleLayout, later changes before the pending
+ * layout pass runs are coalesced into the same layout pass.
+ */
+struct LayoutScheduler
+{
+    /**
+     * Arrange for RowLayout::flushLayout to be called on the specified layout
+     * later. Must not lay out the layout before returning since the layout is
+     * still being changed when this is called.
+     */
+    void (*scheduleLayout)(RowLayout * rowLayout, void * userData);
+
+    /**
+     * Passed as is to scheduleLayout.
+     */
+    void * userData;
+};
+#endif /* UI_LAYOUT_LAYOUTSCHEDULER_H_ */
@@ -0,0 +1,45 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutSnapshot.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_LAYOUTSNAPSHOT_H_
+#define UI_LAYOUT_LAYOUTSNAPSHOT_H_
+
+class LayoutSnapshotPrivate;
+
+/**
+ * A copy of everything a layout pass needs to know about a layout: the
+ * preferred sizes and constraints of its uiComponents and the metrics of its
+ * container. Taken by RowLayout::takeSnapshot on the thread that owns the
+ * uiComponents.
+ *
+ * A snapshot does not refer back to the layout it was taken from, so it may
+ * be handed to RowLayout::computeLayout on any thread.
+ */
+class LayoutSnapshot
+{
+  public:
+
+    LayoutSnapshot();
+
+    LayoutSnapshot(const LayoutSnapshot& other);
+
+    LayoutSnapshot& operator=(const LayoutSnapshot& other);
+
+    ~LayoutSnapshot();
+
+  private:
+
+    LayoutSnapshotPrivate * d;
+
+    friend class RowLayout;
+};
+#endif /* UI_LAYOUT_LAYOUTSNAPSHOT_H_ */
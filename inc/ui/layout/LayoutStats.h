@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutStats.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_LAYOUTSTATS_H_
+#define UI_LAYOUT_LAYOUTSTATS_H_
+
+#include <cstddef>
+
+/**
+ * Where the time of one layout pass went and how much work it did, as
+ * recorded by RowLayout::executeLayout when RowLayout::setLayoutStatsEnabled
+ * is on. Durations are in nanoseconds. Each phase duration is the total of
+ * every time the phase ran during the layout pass. The phases do not overlap,
+ * but placing the uiComponents within their rows is not timed on its own, so
+ * the phase durations do not add up to layoutPassDuration.
+ */
+struct LayoutStats
+{
+    /**
+     * The duration of the whole layout pass.
+     */
+    long long layoutPassDuration;
+
+    /**
+     * The time spent asking the labels and uiComponents that changed for
+     * their preferred size.
+     */
+    long long measureDuration;
+
+    /**
+     * The time spent resizing the members of the size groups.
+     */
+    long long sizeGroupDuration;
+
+    /**
+     * The time spent sizing the label rows above and below the rows, timed
+     * once for the whole sweep over the rows of a layout pass.
+     */
+    long long labelRowDuration;
+
+    /**
+     * The time spent growing the uiComponents into the remaining width of
+     * their rows and the rows into the remaining height of the container.
+     */
+    long long growDuration;
+
+    /**
+     * The time spent applying the new bounds to the labels and uiComponents,
+     * mostly within setSize, setLocation or ILayoutContainer::setBounds.
+     */
+    long long applyBoundsDuration;
+
+    /**
+     * The number of rows that were laid out again.
+     */
+    std::size_t rowsLaidOut;
+
+    /**
+     * The number of uiComponents that were asked for their preferred size.
+     */
+    std::size_t uiComponentsMeasured;
+
+    /**
+     * The number of labels that were asked for their preferred size, labels
+     * whose size was found in the label measurement cache are not counted.
+     */
+    std::size_t labelsMeasured;
+
+    /**
+     * The number of setSize, setLocation and ILayoutContainer::setBounds
+     * calls.
+     */
+    std::size_t nativeCallCount;
+
+    /**
+     * The number of disableDrawing and enableDrawing calls.
+     */
+    std::size_t drawingToggleCount;
+
+    /**
+     * The number of times one of the buffers the layout keeps its own state
+     * in had to grow. Counts every time one of these vectors needed a larger
+     * capacity: the changed bounds, the hit bounds of a row, the changed size
+     * groups, the uiComponents and labels measured on the thread pool, the
+     * rows of a viewport layout pass and the per task results of a parallel
+     * layout pass. Also counts every width added to the row width index and
+     * every size added to the label measurement cache, once per entry even
+     * though a cache entry takes several allocations for its list node, its
+     * index node and its copy of the text.
+     *
+     * This is not a count of heap allocations. Memory allocated elsewhere,
+     * for example by the thread pool, the labels and the uiComponents, is not
+     * counted.
+     */
+    std::size_t bufferGrowthCount;
+};
+#endif /* UI_LAYOUT_LAYOUTSTATS_H_ */
@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutTracer.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_LAYOUTTRACER_H_
+#define UI_LAYOUT_LAYOUTTRACER_H_
+
+#include <cstddef>
+#include <string>
+
+#include "ui/layout/LayoutPhase.h"
+
+class LayoutTracerPrivate;
+
+/**
+ * Records the begin and the end of every phase of the layout passes of the
+ * layouts it is set on with RowLayout::setLayoutTracer, in the Chrome trace
+ * event format that chrome://tracing and Perfetto load. Every event carries
+ * the number of rows and uiComponents of the layout.
+ *
+ * The most recent events are kept in a ring buffer. While a file is open,
+ * every event is also written to the file as it is recorded. A tracer may be
+ * shared by layouts that lay out on different threads.
+ */
+class LayoutTracer
+{
+  public:
+
+    enum
+    {
+      DefaultEventCapacity = 65536
+    };
+
+    /**
+     * Create a LayoutTracer that keeps the most recent DefaultEventCapacity
+     * events.
+     */
+    LayoutTracer();
+
+    /**
+     * Create a LayoutTracer that keeps the specified number of the most recent
+     * events.
+     *
+     * @param[in] eventCapacity the number of events to keep, 0 to only write
+     * the events to the open file.
+     */
+    explicit LayoutTracer(std::size_t eventCapacity);
+
+    /**
+     * Closes the open file, if any.
+     */
+    ~LayoutTracer();
+
+    /**
+     * Write every event recorded from now on to the specified file, as a JSON
+     * array of trace events. Closes the file that was open, if any. The file
+     * is flushed at the end of every layout pass, so it holds every finished
+     * layout pass even if the process ends without closing it.
+     *
+     * @param[in] fileName the name of the file, it is overwritten.
+     *
+     * @return true if the file was opened, false otherwise.
+     */
+    bool openFile(const char * fileName);
+
+    /**
+     * Finish and close the open file, if any.
+     */
+    void closeFile();
+
+    /**
+     * Record the begin of the specified phase on the calling thread.
+     *
+     * @param[in] layoutPhase the phase that begins.
+     *
+     * @param[in] rowCount the number of rows of the layout.
+     *
+     * @param[in] uiComponentCount the number of uiComponents of the layout.
+     */
+    void beginLayoutPhase(LayoutPhase::Value layoutPhase,
+                          std::size_t rowCount,
+                          std::size_t uiComponentCount);
+
+    /**
+     * Record the end of the specified phase on the calling thread.
+     *
+     * @param[in] layoutPhase the phase that ends.
+     *
+     * @param[in] rowCount the number of rows of the layout.
+     *
+     * @param[in] uiComponentCount the number of uiComponents of the layout.
+     */
+    void endLayoutPhase(LayoutPhase::Value layoutPhase,
+                        std::size_t rowCount,
+                        std::size_t uiComponentCount);
+
+    /**
+     * Returns the number of events in the ring buffer.
+     *
+     * @return the number of events in the ring buffer.
+     */
+    std::size_t getEventCount() const;
+
+    /**
+     * Drop every event in the ring buffer.
+     */
+    void clear();
+
+    /**
+     * Returns the events in the ring buffer as a Chrome trace event JSON
+     * object. The end events whose begin event was dropped from the ring
+     * buffer are left out.
+     *
+     * @return the trace.
+     */
+    std::string getTraceJson() const;
+
+    /**
+     * Write the events in the ring buffer to the specified file as a Chrome
+     * trace event JSON object.
+     *
+     * @param[in] fileName the name of the file, it is overwritten.
+     *
+     * @return true if the trace was written, false otherwise.
+     */
+    bool writeTraceJson(const char * fileName) const;
+
+  private:
+
+    // Not copyable, the open file and the ring buffer are not shared.
+    LayoutTracer(const LayoutTracer& other);
+    LayoutTracer& operator=(const LayoutTracer& other);
+
+    LayoutTracerPrivate * d;
+};
+#endif /* UI_LAYOUT_LAYOUTTRACER_H_ */
@@ -16,12 +16,22 @@
 #include <cstddef>
 
 #include "ui/layout/ILayout.h"
+#include "ui/layout/LayoutMeasurement.h"
+#include "ui/layout/LayoutMetrics.h"
+#include "ui/layout/LayoutResult.h"
+#include "ui/layout/LayoutSnapshot.h"
+#include "ui/layout/LayoutStats.h"
 
 #include "ui/layout/RowOrientation.h"
 
 class UiComponent;
 class Label;
+struct LayoutAllocator;
+struct LayoutPhaseObserver;
+struct LayoutScheduler;
+class LayoutTracer;
 struct UiComponentConstraints;
+struct UiComponentEntry;
 class RowLayoutPrivate;
 
 class RowLayout : public ILayout
@@ -39,6 +49,19 @@ class RowLayout : public ILayout
      */
     RowLayout(UiComponent * uiComponent);
 
+    /**
+     * Create a new RowLayout whose internal bookkeeping is allocated with the
+     * specified allocator.
+     *
+     * @param[in] uiComponent the UiComponent that will be laid out.
+     *
+     * @param[in] layoutAllocator the allocator used for the memory of this
+     * layout or nullptr to use the global operator new. The allocator is
+     * copied.
+     */
+    RowLayout(UiComponent * uiComponent,
+              const LayoutAllocator * layoutAllocator);
+
     virtual ~RowLayout();
 
     /**
@@ -107,6 +130,61 @@ class RowLayout : public ILayout
      */
     int getVerticalSpaceBetweenRows() const;
 
+    /**
+     * Returns the number of setSize and setLocation calls that layout passes
+     * of this layout skipped because the bounds of the label or uiComponent
+     * were the same as the bounds that were last applied to it.
+     *
+     * @return the number of skipped setSize and setLocation calls.
+     */
+    std::size_t getSkippedBoundsCallCount() const;
+
+    /**
+     * Return the DPI this RowLayout lays out at.
+     *
+     * @return the DPI this RowLayout lays out at, LayoutMetrics::DefaultDpi
+     * unless setDpi was called.
+     */
+    int getDpi() const;
+
+    /**
+     * Return the platform default spacing and standard sizes at the DPI of
+     * this RowLayout.
+     *
+     * @return the metrics at the DPI of this RowLayout.
+     */
+    const LayoutMetrics& getLayoutMetrics() const;
+
+    /**
+     * Returns the number of times the size of a label that implements
+     * IMeasurableText was found in the label measurement cache of this layout
+     * instead of being measured.
+     *
+     * @return the number of label measurements that were found in the cache.
+     */
+    std::size_t getLabelMeasurementCacheHitCount() const;
+
+    /**
+     * Returns the number of times the size of a label that implements
+     * IMeasurableText was not found in the label measurement cache of this
+     * layout and the label was measured.
+     *
+     * @return the number of label measurements that were not found in the
+     * cache.
+     */
+    std::size_t getLabelMeasurementCacheMissCount() const;
+
+    /**
+     * Set the number of label sizes the label measurement cache of this layout
+     * holds. The sizes of labels that implement IMeasurableText are cached by
+     * font and text, so labels with the same text and font, and labels that
+     * are invalidated without changing their text, are only measured once.
+     * When the cache is full, the least recently used size is dropped.
+     *
+     * @param[in] capacity the number of label sizes or 0 to disable the cache.
+     */
+    void setLabelMeasurementCacheCapacity(std::size_t capacity);
+
     /**
      * Add a new Row to this RowLayout making the newly added Row, the
      * current row. Subsequent calls to addUiComponent, will add a UiComponent
@@ -116,6 +194,39 @@ class RowLayout : public ILayout
      */
     Row * addRow();
 
+    /**
+     * Reserve storage so that this layout can hold at least the specified
+     * number of rows and uiComponents without reallocating.
+     *
+     * @param[in] rowCount the total number of rows.
+     *
+     * @param[in] uiComponentCount the total number of uiComponents in all
+     * rows.
+     */
+    void reserve(std::size_t rowCount,
+                 std::size_t uiComponentCount);
+
+    /**
+     * Add the specified number of new rows to this RowLayout, filling each row
+     * with the next uiComponentCounts[i] entries of the specified entries. The
+     * last added Row becomes the current row.
+     *
+     * Storage for every row and uiComponent is reserved up front and the
+     * uiComponents of each row are added to the container in one step.
+     *
+     * @param[in] uiComponentEntries the uiComponents of all new rows, in row
+     * order.
+     *
+     * @param[in] uiComponentCounts the number of uiComponents in each new row.
+     *
+     * @param[in] rowCount the number of new rows.
+     *
+     * @return the last added Row or the current row if rowCount is 0.
+     */
+    Row * addRows(const UiComponentEntry * uiComponentEntries,
+                  const std::size_t * uiComponentCounts,
+                  std::size_t rowCount);
+
     /**
      * Add the specified UiComponent to this layout at the specified row.
      *
@@ -158,6 +269,22 @@ class RowLayout : public ILayout
      */
     void setVerticalSpaceBetweenRows(int verticalSpace);
 
+    /**
+     * Set the DPI this RowLayout lays out at, for example when the container
+     * moves to a monitor with a different DPI. The platform default spacing
+     * is taken from the LayoutMetrics of the DPI.
+     *
+     * The measured sizes are kept per DPI, so the uiComponents are not
+     * measured again when switching back to a DPI this layout was laid out at
+     * before. Otherwise the measured sizes are scaled from the current DPI.
+     * Call invalidateUiComponent for the uiComponents that do not scale
+     * linearly with the DPI. The label measurement cache is also kept per DPI.
+     *
+     * @param[in] dpi the DPI, LayoutMetrics::DefaultDpi is used if it is not
+     * greater than 0.
+     */
+    void setDpi(int dpi);
+
     /**
      * Remove the specified uiComponent from this layout. If a uiComponent was
      * added with a label using
@@ -175,6 +302,279 @@ class RowLayout : public ILayout
      */
     void removeAllUiComponents();
 
+    /**
+     * Find the location of the specified uiComponent or label within this
+     * layout.
+     *
+     * @param[in] uiComponent the uiComponent or label to find.
+     *
+     * @param[out] row the row that contains the specified uiComponent. Only set
+     * if the uiComponent is found.
+     *
+     * @param[out] index the index of the specified uiComponent within the row.
+     * A label shares the index of its associated uiComponent. Only set if the
+     * uiComponent is found.
+     *
+     * @return true if the specified uiComponent is in this layout, false
+     * otherwise.
+     */
+    bool findUiComponent(UiComponent * uiComponent,
+                         std::size_t * row,
+                         std::size_t * index);
+
+    /**
+     * Mark the specified uiComponent as changed so that it is measured and
+     * laid out again during the next layout pass. The specified uiComponent may
+     * be either a uiComponent or a label that was added to this layout.
+     *
+     * Only rows that contain invalidated uiComponents are measured and laid out
+     * again. Rows below an invalidated row are only moved if the height of the
+     * invalidated row changes.
+     *
+     * @param[in] uiComponent the uiComponent or label whose preferred size
+     * changed.
+     */
+    void invalidateUiComponent(UiComponent * uiComponent);
+
+    /**
+     * Forget the cached sizes of every text in the specified font and mark the
+     * labels in this layout that use the font as changed. Call this when a
+     * font changes or before it is destroyed.
+     *
+     * @param[in] fontIdentity the identity of the font as returned by
+     * IMeasurableText::getFontIdentity.
+     */
+    void invalidateFont(const void * fontIdentity);
+
+    /**
+     * Mark all of the uiComponents in the specified row as changed so that
+     * they are measured and laid out again during the next layout pass.
+     *
+     * @param[in] row the row within this layout that will be laid out again.
+     */
+    void invalidateRow(std::size_t row);
+
+    /**
+     * Mark every uiComponent in this layout as changed so that the next layout
+     * pass measures and lays out every row and applies the bounds of every
+     * uiComponent, even those whose bounds did not change.
+     */
+    void invalidateLayout();
+
+    /**
+     * Set the hook that is called when this layout changes and needs a layout
+     * pass. Without a scheduler, a pending layout pass only runs when
+     * RowLayout::flushLayout or RowLayout::executeLayout is called.
+     *
+     * @param[in] layoutScheduler the scheduler or nullptr to remove the
+     * current scheduler. The scheduler is copied.
+     */
+    void setLayoutScheduler(const LayoutScheduler * layoutScheduler);
+
+    /**
+     * Set the hooks that are called at the start and at the end of each phase
+     * of the layout passes of this layout.
+     *
+     * @param[in] layoutPhaseObserver the observer or nullptr to remove the
+     * current observer. The observer is copied.
+     */
+    void setLayoutPhaseObserver(const LayoutPhaseObserver * layoutPhaseObserver);
+
+    /**
+     * Set the tracer that records the begin and the end of each phase of the
+     * layout passes of this layout.
+     *
+     * @param[in] layoutTracer the tracer or nullptr to stop tracing. The
+     * tracer is not owned by this layout and must outlive it or be removed
+     * first.
+     */
+    void setLayoutTracer(LayoutTracer * layoutTracer);
+
+    /**
+     * Turn the recording of LayoutStats by RowLayout::executeLayout on or
+     * off. Off by default, a layout pass that does not record its stats only
+     * pays for checking this flag.
+     *
+     * @param[in] layoutStatsEnabled true to record the stats of every layout
+     * pass, false to stop recording them.
+     */
+    void setLayoutStatsEnabled(bool layoutStatsEnabled);
+
+    /**
+     * Returns true if RowLayout::executeLayout records LayoutStats.
+     *
+     * @return true if the stats of every layout pass are recorded, false
+     * otherwise.
+     */
+    bool isLayoutStatsEnabled() const;
+
+    /**
+     * Returns the stats of the last layout pass that recorded them. Measuring,
+     * taking a snapshot and committing a LayoutResult are not recorded.
+     *
+     * @return the stats of the last recorded layout pass, all 0 if no layout
+     * pass was recorded.
+     */
+    const LayoutStats& getLayoutStats() const;
+
+    /**
+     * Returns true if this layout changed since the last layout pass.
+     *
+     * @return true if a layout pass is pending, false otherwise.
+     */
+    bool isLayoutPending() const;
+
+    /**
+     * Lay out the container of this layout if a layout pass is pending. Every
+     * change since the last layout pass is handled by this one layout pass.
+     */
+    void flushLayout();
+
+    /**
+     * Compute the size this layout would give its container and the bounds
+     * of each row without laying out the container. No label or uiComponent
+     * is resized, moved or redrawn and the preferred size of the container is
+     * left alone.
+     *
+     * Only the uiComponents that changed since the last layout pass are asked
+     * for their preferred size, the sizes of the rest are reused. Rows are not
+     * grown vertically.
+     *
+     * @param[in] availableWidth the width the container would have. Rows that
+     * are narrower are grown or aligned within this width. A negative value
+     * leaves every row at its preferred width.
+     *
+     * @return the preferred size of the container and the bounds of every row.
+     */
+    LayoutMeasurement measure(int availableWidth);
+
+    /**
+     * Copy the preferred sizes and constraints of every uiComponent in this
+     * layout and the metrics of the specified container, so that a layout
+     * pass can be computed from the copy by RowLayout::computeLayout. Must be
+     * called on the thread that owns the uiComponents. Only the uiComponents
+     * that changed since the last layout pass are asked for their preferred
+     * size.
+     *
+     * @param[in] container the container that will be laid out.
+     *
+     * @return the snapshot of this layout.
+     */
+    LayoutSnapshot takeSnapshot(UiComponent * container);
+
+    /**
+     * Compute a whole layout pass from the specified snapshot. Only the
+     * snapshot is read, so this may be called on any thread, also while the
+     * layout the snapshot was taken from changes.
+     *
+     * @param[in] layoutSnapshot the snapshot taken by RowLayout::takeSnapshot.
+     *
+     * @return the bounds of every label, uiComponent and row.
+     */
+    static LayoutResult computeLayout(const LayoutSnapshot& layoutSnapshot);
+
+    /**
+     * Apply the specified result to the uiComponents of this layout and to the
+     * container the snapshot was taken for. Must be called on the thread that
+     * owns the uiComponents. Only the bounds that differ from the bounds that
+     * were last applied are applied.
+     *
+     * A result is rejected if it was not computed from a snapshot of this
+     * layout or if this layout changed after its snapshot was taken, take a
+     * new snapshot in that case.
+     *
+     * @param[in] layoutResult the result computed by RowLayout::computeLayout
+     * from a snapshot of this layout.
+     *
+     * @return true if the result was applied, false if it was rejected.
+     */
+    bool commit(const LayoutResult& layoutResult);
+
+    /**
+     * Set the number of threads, including the calling thread, that measure
+     * the uiComponents and lay out the rows of this layout during a layout
+     * pass. Only the labels and uiComponents that implement
+     * IThreadSafeMeasurable are measured on the other threads and only
+     * layouts with thousands of rows are laid out across threads. The bounds
+     * of every label and uiComponent are the same whatever the number of
+     * threads.
+     *
+     * @param[in] threadCount the number of threads, 0 or 1 to lay out every
+     * row on the calling thread, which is the default.
+     */
+    void setLayoutThreadCount(std::size_t threadCount);
+
+    /**
+     * Only lay out the rows that intersect the specified vertical range of the
+     * container, for containers that scroll through many rows. The rows out
+     * of view are neither measured nor given new bounds, each one takes up the
+     * height it had when it was last laid out, or the estimated height if it
+     * never was, until it scrolls into view. The preferred size of the
+     * container is computed from those heights and from the widths of the rows
+     * that were laid out.
+     *
+     * The size groups only know the sizes of the members that were in view at
+     * some point and uiComponents do not grow vertically while a viewport is
+     * set.
+     *
+     * @param[in] y the y-offset of the viewport within the container.
+     *
+     * @param[in] height the height of the viewport in pixels.
+     */
+    void setViewport(int y, int height);
+
+    /**
+     * Lay out every row again, starting with the next layout pass.
+     */
+    void clearViewport();
+
+    /**
+     * Return the index of the row at the specified y-offset within the
+     * container as of the last layout pass. The vertical space above a row
+     * is part of the row. Takes logarithmic time.
+     *
+     * @param[in] y the y-offset within the container.
+     *
+     * @return the index of the row or getRowCount() if there is no row at the
+     * specified y-offset.
+     */
+    std::size_t getRowAtY(int y) const;
+
+    /**
+     * Return the y-offset of the specified row within the container as of the
+     * last layout pass, excluding the vertical space above the row. Rows that
+     * were never laid out while a viewport is set take up the estimated row
+     * height. Takes logarithmic time.
+     *
+     * @param[in] row a row within this layout.
+     *
+     * @return the y-offset of the specified row.
+     */
+    int getRowTop(std::size_t row) const;
+
+    /**
+     * Return the label or uiComponent whose bounds as of the last layout pass
+     * contain the specified point of the container. Takes logarithmic time.
+     *
+     * @param[in] x the x-offset within the container.
+     *
+     * @param[in] y the y-offset within the container.
+     *
+     * @return the label or uiComponent at the specified point or nullptr if
+     * there is none.
+     */
+    UiComponent * getUiComponentAtPoint(int x, int y) const;
+
+    /**
+     * Set the height that is assumed for the rows that were never laid out
+     * while a viewport is set.
+     *
+     * @param[in] estimatedRowHeight the height of a row in pixels, the
+     * vertical space above the row included, or 0 to use the average height
+     * of the rows that were laid out, which is the default.
+     */
+    void setEstimatedRowHeight(int estimatedRowHeight);
+
     virtual void executeLayout(UiComponent * uiComponent);
 
   private:
@@ -220,6 +620,20 @@ class RowLayout : public ILayout
                              UiComponent* uiComponent,
                              const UiComponentConstraints * uiComponentConstraints);
 
+        /**
+         * Add the specified uiComponents and their associated labels, if any,
+         * to the end of this row. Storage is reserved up front and the
+         * uiComponents are added to the container in one step.
+         *
+         * @param[in] uiComponentEntries the uiComponents that will be added.
+         *
+         * @param[in] count the number of entries.
+         *
+         * @return this row.
+         */
+        Row * addUiComponents(const UiComponentEntry * uiComponentEntries,
+                              std::size_t count);
+
         void setHorizontalSpaceBetweenUiComponents(std::size_t horizontalSpace);
 
         /**
@@ -235,6 +649,21 @@ class RowLayout : public ILayout
 
         void removeUiComponentAt(std::size_t index);
 
+        /**
+         * Mark all of the uiComponents in this row as changed so that they are
+         * measured and laid out again during the next layout pass.
+         */
+        void invalidate();
+
+        /**
+         * Mark the uiComponent and its associated label, if any, at the
+         * specified index as changed so that they are measured and laid out
+         * again during the next layout pass.
+         *
+         * @param[in] index the index of the uiComponent within this row.
+         */
+        void invalidateUiComponentAt(std::size_t index);
+
       private:
 
         class RowPrivate;
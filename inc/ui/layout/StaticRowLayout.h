@@ -0,0 +1,942 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: StaticRowLayout.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_STATICROWLAYOUT_H_
+#define UI_LAYOUT_STATICROWLAYOUT_H_
+
+#include <climits>
+#include <cstddef>
+
+#include "ui/UiComponent.h"
+#include "ui/Label.h"
+
+#include "ui/layout/ILayout.h"
+#include "ui/layout/ILayoutContainer.h"
+#include "ui/layout/LabelOrientation.h"
+#include "ui/layout/LabelVerticalAlignment.h"
+#include "ui/layout/LayoutMetrics.h"
+#include "ui/layout/RowOrientation.h"
+#include "ui/layout/UiComponentBounds.h"
+
+/**
+ * Describes a uiComponent without a label within a StaticRow. The parameters
+ * have the same meaning as the fields of the same name in
+ * UiComponentConstraints.
+ */
+template<int horizontalGapLeftT = -1,
+         int horizontalGapRightT = -1,
+         int sizeGroupIdT = -1>
+struct StaticUiComponent
+{
+    static const LabelOrientation::Value labelOrientation = LabelOrientation::LeftOrientation;
+
+    static const LabelVerticalAlignment::Value labelVerticalAlignment = LabelVerticalAlignment::TopAlignment;
+
+    enum
+    {
+      hasLabel = 0,
+      horizontalGapLeft = horizontalGapLeftT,
+      horizontalGapRight = horizontalGapRightT,
+      sizeGroupId = sizeGroupIdT,
+      labelSizeGroupId = -1
+    };
+};
+
+/**
+ * Describes a uiComponent and its associated label within a StaticRow. The
+ * parameters have the same meaning as the fields of the same name in
+ * UiComponentConstraints.
+ */
+template<LabelOrientation::Value labelOrientationT = LabelOrientation::LeftOrientation,
+         LabelVerticalAlignment::Value labelVerticalAlignmentT = LabelVerticalAlignment::TopAlignment,
+         int horizontalGapLeftT = -1,
+         int horizontalGapRightT = -1,
+         int sizeGroupIdT = -1,
+         int labelSizeGroupIdT = -1>
+struct StaticLabeledUiComponent
+{
+    static const LabelOrientation::Value labelOrientation = labelOrientationT;
+
+    static const LabelVerticalAlignment::Value labelVerticalAlignment = labelVerticalAlignmentT;
+
+    enum
+    {
+      hasLabel = 1,
+      horizontalGapLeft = horizontalGapLeftT,
+      horizontalGapRight = horizontalGapRightT,
+      sizeGroupId = sizeGroupIdT,
+      labelSizeGroupId = labelSizeGroupIdT
+    };
+};
+
+template<typename... UiComponentsT>
+struct StaticRowLayoutList
+{
+
+};
+
+/**
+ * Describes one row of a StaticRowLayout.
+ *
+ * @tparam rowOrientationT the orientation of the row, see
+ * RowLayout::Row::setRowOrientation.
+ *
+ * @tparam horizontalSpaceT the horizontal space between the uiComponents of
+ * the row, see RowLayout::Row::setHorizontalSpaceBetweenUiComponents.
+ *
+ * @tparam UiComponentsT the StaticUiComponent and StaticLabeledUiComponent
+ * descriptions of the uiComponents of the row, from left to right.
+ */
+template<RowOrientation::Value rowOrientationT,
+         std::size_t horizontalSpaceT,
+         typename... UiComponentsT>
+struct StaticRow
+{
+    static const RowOrientation::Value rowOrientation = rowOrientationT;
+
+    enum
+    {
+      horizontalSpace = horizontalSpaceT,
+      uiComponentCount = sizeof...(UiComponentsT)
+    };
+
+    typedef StaticRowLayoutList<UiComponentsT...> UiComponents;
+};
+
+// The templates below implement StaticRowLayout. Every decision that only
+// depends on the description of the layout is a constant expression, so the
+// compiler is left with straight-line code for the layout pass.
+
+// The number of uiComponents in the specified rows.
+template<typename... RowsT>
+struct StaticRowLayoutCount;
+
+template<>
+struct StaticRowLayoutCount<>
+{
+    enum { value = 0 };
+};
+
+template<typename RowT, typename... RowsT>
+struct StaticRowLayoutCount<RowT, RowsT...>
+{
+    enum { value = RowT::uiComponentCount + StaticRowLayoutCount<RowsT...>::value };
+};
+
+// The specified row and the index of its first uiComponent among the
+// uiComponents of every row.
+template<std::size_t rowIndexT, typename... RowsT>
+struct StaticRowLayoutRowAt;
+
+template<typename RowT, typename... RowsT>
+struct StaticRowLayoutRowAt<0, RowT, RowsT...>
+{
+    typedef RowT Row;
+
+    enum { firstIndex = 0 };
+};
+
+template<std::size_t rowIndexT, typename RowT, typename... RowsT>
+struct StaticRowLayoutRowAt<rowIndexT, RowT, RowsT...>
+{
+    typedef typename StaticRowLayoutRowAt<rowIndexT - 1, RowsT...>::Row Row;
+
+    enum { firstIndex = RowT::uiComponentCount + StaticRowLayoutRowAt<rowIndexT - 1, RowsT...>::firstIndex };
+};
+
+// The description of the specified uiComponent of a list.
+template<std::size_t indexT, typename ListT>
+struct StaticRowLayoutUiComponentAt;
+
+template<typename UiComponentT, typename... UiComponentsT>
+struct StaticRowLayoutUiComponentAt<0, StaticRowLayoutList<UiComponentT, UiComponentsT...> >
+{
+    typedef UiComponentT Description;
+};
+
+template<std::size_t indexT, typename UiComponentT, typename... UiComponentsT>
+struct StaticRowLayoutUiComponentAt<indexT, StaticRowLayoutList<UiComponentT, UiComponentsT...> >
+{
+    typedef typename StaticRowLayoutUiComponentAt<indexT - 1, StaticRowLayoutList<UiComponentsT...> >::Description Description;
+};
+
+// The uiComponents of every row in one list.
+template<typename ListT, typename... RowsT>
+struct StaticRowLayoutFlatten;
+
+template<typename... UiComponentsT>
+struct StaticRowLayoutFlatten<StaticRowLayoutList<UiComponentsT...> >
+{
+    typedef StaticRowLayoutList<UiComponentsT...> List;
+};
+
+template<typename... UiComponentsT, typename RowT, typename... RowsT>
+struct StaticRowLayoutFlatten<StaticRowLayoutList<UiComponentsT...>, RowT, RowsT...>
+{
+    template<typename RowListT>
+    struct Append;
+
+    template<typename... RowUiComponentsT>
+    struct Append<StaticRowLayoutList<RowUiComponentsT...> >
+    {
+        typedef typename StaticRowLayoutFlatten<StaticRowLayoutList<UiComponentsT..., RowUiComponentsT...>, RowsT...>::List List;
+    };
+
+    typedef typename Append<typename RowT::UiComponents>::List List;
+};
+
+// The gap of one side of a uiComponent the way RowLayout fills it in, given
+// the platform default gap of the DPI of the layout. Like RowLayout, every
+// gap that is not specified is the gap between related uiComponents.
+template<int horizontalGapT>
+struct StaticRowLayoutGap
+{
+    static int getValue(int defaultGap)
+    {
+      return horizontalGapT < 0 ? defaultGap : (horizontalGapT == 0 ? -1 : horizontalGapT);
+    }
+};
+
+// The space in front of a uiComponent within its row, nothing for the first
+// uiComponent of a row.
+template<std::size_t horizontalSpaceT, typename PreviousT, typename CurrentT>
+struct StaticRowLayoutSpaceBefore
+{
+    static int getValue(int defaultGap)
+    {
+      const int previousGap = StaticRowLayoutGap<PreviousT::horizontalGapRight>::getValue(defaultGap);
+
+      const int currentGap = StaticRowLayoutGap<CurrentT::horizontalGapLeft>::getValue(defaultGap);
+
+      return static_cast<int>(horizontalSpaceT) + (previousGap > currentGap ? previousGap : currentGap);
+    }
+};
+
+template<std::size_t horizontalSpaceT, typename CurrentT>
+struct StaticRowLayoutSpaceBefore<horizontalSpaceT, void, CurrentT>
+{
+    static int getValue(int)
+    {
+      return 0;
+    }
+};
+
+/**
+ * The labels and uiComponents of a StaticRowLayout and their sizes and
+ * locations during a layout pass.
+ */
+template<std::size_t countT>
+struct StaticRowLayoutState
+{
+    Label * labels[countT];
+    UiComponent * uiComponents[countT];
+
+    // The preferred sizes reported by the labels and uiComponents.
+    int labelMeasuredWidth[countT];
+    int labelMeasuredHeight[countT];
+    int uiComponentMeasuredWidth[countT];
+    int uiComponentMeasuredHeight[countT];
+
+    // The sizes once the size groups are taken into account.
+    int labelWidth[countT];
+    int labelHeight[countT];
+    int uiComponentWidth[countT];
+    int uiComponentHeight[countT];
+
+    int labelX[countT];
+    int labelY[countT];
+    int uiComponentX[countT];
+    int uiComponentY[countT];
+
+    // The gap used for the sides of uiComponents whose gap is not specified.
+    int horizontalGap;
+
+    // The bounds that were last applied to each label, at 2 * index, and
+    // each uiComponent, at 2 * index + 1.
+    UiComponentBounds appliedBounds[2 * countT];
+};
+
+// The largest size of the members of the specified size group.
+template<int sizeGroupIdT, std::size_t indexT, typename ListT>
+struct StaticRowLayoutSizeGroup;
+
+template<int sizeGroupIdT, std::size_t indexT>
+struct StaticRowLayoutSizeGroup<sizeGroupIdT, indexT, StaticRowLayoutList<> >
+{
+    template<typename StateT>
+    static void getMaxSize(const StateT&, int *, int *)
+    {
+
+    }
+};
+
+template<int sizeGroupIdT, std::size_t indexT, typename UiComponentT, typename... UiComponentsT>
+struct StaticRowLayoutSizeGroup<sizeGroupIdT, indexT, StaticRowLayoutList<UiComponentT, UiComponentsT...> >
+{
+    template<typename StateT>
+    static void getMaxSize(const StateT& state, int * maxWidth, int * maxHeight)
+    {
+      if(UiComponentT::sizeGroupId == sizeGroupIdT)
+      {
+        *maxWidth = state.uiComponentMeasuredWidth[indexT] > *maxWidth ? state.uiComponentMeasuredWidth[indexT] : *maxWidth;
+        *maxHeight = state.uiComponentMeasuredHeight[indexT] > *maxHeight ? state.uiComponentMeasuredHeight[indexT] : *maxHeight;
+      }
+
+      // Like RowLayout, labels and uiComponents share the size group ids.
+      if(UiComponentT::hasLabel && UiComponentT::labelSizeGroupId == sizeGroupIdT)
+      {
+        *maxWidth = state.labelMeasuredWidth[indexT] > *maxWidth ? state.labelMeasuredWidth[indexT] : *maxWidth;
+        *maxHeight = state.labelMeasuredHeight[indexT] > *maxHeight ? state.labelMeasuredHeight[indexT] : *maxHeight;
+      }
+
+      StaticRowLayoutSizeGroup<sizeGroupIdT, indexT + 1, StaticRowLayoutList<UiComponentsT...> >::getMaxSize(state, maxWidth, maxHeight);
+    }
+};
+
+// Measure every label and uiComponent, then size the members of the size
+// groups.
+template<std::size_t indexT, typename ListT, typename AllT>
+struct StaticRowLayoutMeasure;
+
+template<std::size_t indexT, typename AllT>
+struct StaticRowLayoutMeasure<indexT, StaticRowLayoutList<>, AllT>
+{
+    template<typename StateT>
+    static void measure(StateT&)
+    {
+
+    }
+
+    template<typename StateT>
+    static void resize(StateT&)
+    {
+
+    }
+};
+
+template<std::size_t indexT, typename UiComponentT, typename... UiComponentsT, typename AllT>
+struct StaticRowLayoutMeasure<indexT, StaticRowLayoutList<UiComponentT, UiComponentsT...>, AllT>
+{
+    typedef StaticRowLayoutMeasure<indexT + 1, StaticRowLayoutList<UiComponentsT...>, AllT> Next;
+
+    template<typename StateT>
+    static void measure(StateT& state)
+    {
+      if(UiComponentT::hasLabel)
+      {
+        state.labelMeasuredWidth[indexT] = state.labels[indexT]->getPreferredWidth();
+        state.labelMeasuredHeight[indexT] = state.labels[indexT]->getPreferredHeight();
+      }
+      else
+      {
+        state.labelMeasuredWidth[indexT] = 0;
+        state.labelMeasuredHeight[indexT] = 0;
+      }
+
+      state.uiComponentMeasuredWidth[indexT] = state.uiComponents[indexT]->getPreferredWidth();
+      state.uiComponentMeasuredHeight[indexT] = state.uiComponents[indexT]->getPreferredHeight();
+
+      Next::measure(state);
+    }
+
+    template<typename StateT>
+    static void resize(StateT& state)
+    {
+      state.labelWidth[indexT] = state.labelMeasuredWidth[indexT];
+      state.labelHeight[indexT] = state.labelMeasuredHeight[indexT];
+      state.uiComponentWidth[indexT] = state.uiComponentMeasuredWidth[indexT];
+      state.uiComponentHeight[indexT] = state.uiComponentMeasuredHeight[indexT];
+
+      if(UiComponentT::sizeGroupId >= 0)
+      {
+        int maxWidth = 0;
+        int maxHeight = 0;
+
+        StaticRowLayoutSizeGroup<UiComponentT::sizeGroupId, 0, AllT>::getMaxSize(state, &maxWidth, &maxHeight);
+
+        state.uiComponentWidth[indexT] = maxWidth;
+        state.uiComponentHeight[indexT] = maxHeight;
+      }
+
+      if(UiComponentT::hasLabel && UiComponentT::labelSizeGroupId >= 0)
+      {
+        int maxWidth = 0;
+        int maxHeight = 0;
+
+        StaticRowLayoutSizeGroup<UiComponentT::labelSizeGroupId, 0, AllT>::getMaxSize(state, &maxWidth, &maxHeight);
+
+        state.labelWidth[indexT] = maxWidth;
+        state.labelHeight[indexT] = maxHeight;
+      }
+
+      Next::resize(state);
+    }
+};
+
+// Lay out the uiComponents of one row the way
+// RowLayoutPrivate::layoutUiComponentInRow does.
+template<std::size_t horizontalSpaceT, std::size_t indexT, typename PreviousT, typename ListT>
+struct StaticRowLayoutPlace;
+
+template<std::size_t horizontalSpaceT, std::size_t indexT, typename PreviousT>
+struct StaticRowLayoutPlace<horizontalSpaceT, indexT, PreviousT, StaticRowLayoutList<> >
+{
+    template<typename StateT>
+    static void getLabelRowHeights(const StateT&, int *, int *)
+    {
+
+    }
+
+    template<typename StateT>
+    static void place(StateT&, int, int, int *, int *)
+    {
+
+    }
+};
+
+template<std::size_t horizontalSpaceT, std::size_t indexT, typename PreviousT, typename UiComponentT, typename... UiComponentsT>
+struct StaticRowLayoutPlace<horizontalSpaceT, indexT, PreviousT, StaticRowLayoutList<UiComponentT, UiComponentsT...> >
+{
+    typedef StaticRowLayoutPlace<horizontalSpaceT, indexT + 1, UiComponentT, StaticRowLayoutList<UiComponentsT...> > Next;
+
+    enum
+    {
+      hasTopLabel = UiComponentT::hasLabel && UiComponentT::labelOrientation == LabelOrientation::TopOrientation,
+      hasLeftLabel = UiComponentT::hasLabel && UiComponentT::labelOrientation == LabelOrientation::LeftOrientation,
+      hasRightLabel = UiComponentT::hasLabel && UiComponentT::labelOrientation == LabelOrientation::RightOrientation,
+      hasBottomLabel = UiComponentT::hasLabel && UiComponentT::labelOrientation == LabelOrientation::BottomOrientation
+    };
+
+    // The heights of the rows of labels above and below the row.
+    template<typename StateT>
+    static void getLabelRowHeights(const StateT& state, int * topLabelRowHeight, int * bottomLabelRowHeight)
+    {
+      if(hasTopLabel && state.labelHeight[indexT] > *topLabelRowHeight)
+      {
+        *topLabelRowHeight = state.labelHeight[indexT];
+      }
+
+      if(hasBottomLabel && state.labelHeight[indexT] > *bottomLabelRowHeight)
+      {
+        *bottomLabelRowHeight = state.labelHeight[indexT];
+      }
+
+      Next::getLabelRowHeights(state, topLabelRowHeight, bottomLabelRowHeight);
+    }
+
+    template<typename StateT>
+    static void place(StateT& state,
+                      int yOffset,
+                      int topLabelRowHeight,
+                      int * xOffset,
+                      int * heightOfTallestUiComponentInRow)
+    {
+      *xOffset += StaticRowLayoutSpaceBefore<horizontalSpaceT, PreviousT, UiComponentT>::getValue(state.horizontalGap);
+
+      int finalUiComponentYOffset = topLabelRowHeight;
+
+      int uiComponentRowXOffset = 0;
+
+      if(hasTopLabel)
+      {
+        state.labelX[indexT] = *xOffset;
+        state.labelY[indexT] = yOffset;
+      }
+
+      int yLabelVAlignmentOffset = 0;
+      int yUiComponentPeerVAlignmentOffset = 0;
+
+      if(hasLeftLabel)
+      {
+        const int labelHeight = state.labelHeight[indexT];
+        const int uiComponentHeight = state.uiComponentHeight[indexT];
+
+        if(UiComponentT::labelVerticalAlignment == LabelVerticalAlignment::MiddleAlignment)
+        {
+          if(labelHeight < uiComponentHeight)
+          {
+            yLabelVAlignmentOffset = (uiComponentHeight - labelHeight) / 2;
+          }
+          else if(labelHeight > uiComponentHeight)
+          {
+            yUiComponentPeerVAlignmentOffset = (labelHeight - uiComponentHeight) / 2;
+          }
+        }
+        else if(UiComponentT::labelVerticalAlignment == LabelVerticalAlignment::BottomAlignment)
+        {
+          if(labelHeight < uiComponentHeight)
+          {
+            yLabelVAlignmentOffset = uiComponentHeight - labelHeight;
+          }
+          else if(labelHeight > uiComponentHeight)
+          {
+            yUiComponentPeerVAlignmentOffset = labelHeight - uiComponentHeight;
+          }
+        }
+
+        state.labelX[indexT] = *xOffset;
+        state.labelY[indexT] = yOffset + yLabelVAlignmentOffset + finalUiComponentYOffset;
+
+        uiComponentRowXOffset += state.labelWidth[indexT];
+
+        if(labelHeight > *heightOfTallestUiComponentInRow)
+        {
+          *heightOfTallestUiComponentInRow = labelHeight;
+        }
+      }
+
+      state.uiComponentX[indexT] = *xOffset + uiComponentRowXOffset;
+      state.uiComponentY[indexT] = yOffset + yUiComponentPeerVAlignmentOffset + finalUiComponentYOffset;
+
+      uiComponentRowXOffset += state.uiComponentWidth[indexT];
+
+      if(state.uiComponentHeight[indexT] > *heightOfTallestUiComponentInRow)
+      {
+        *heightOfTallestUiComponentInRow = state.uiComponentHeight[indexT];
+      }
+
+      if(hasRightLabel)
+      {
+        // Like RowLayout, a label to the right is not aligned vertically.
+        state.labelX[indexT] = *xOffset + uiComponentRowXOffset;
+        state.labelY[indexT] = yOffset + finalUiComponentYOffset;
+
+        uiComponentRowXOffset += state.labelWidth[indexT];
+
+        if(state.labelHeight[indexT] > *heightOfTallestUiComponentInRow)
+        {
+          *heightOfTallestUiComponentInRow = state.labelHeight[indexT];
+        }
+      }
+
+      finalUiComponentYOffset += state.uiComponentHeight[indexT];
+
+      if(hasBottomLabel)
+      {
+        state.labelX[indexT] = *xOffset;
+        state.labelY[indexT] = yOffset + finalUiComponentYOffset;
+
+        if(state.labelHeight[indexT] > *heightOfTallestUiComponentInRow)
+        {
+          *heightOfTallestUiComponentInRow = state.labelHeight[indexT];
+        }
+      }
+
+      *xOffset += uiComponentRowXOffset;
+
+      Next::place(state, yOffset, topLabelRowHeight, xOffset, heightOfTallestUiComponentInRow);
+    }
+};
+
+// Lay out the rows the way RowLayoutPrivate::postLayout does.
+template<std::size_t rowIndexT, std::size_t firstIndexT, typename... RowsT>
+struct StaticRowLayoutRows;
+
+template<std::size_t rowIndexT, std::size_t firstIndexT>
+struct StaticRowLayoutRows<rowIndexT, firstIndexT>
+{
+    template<typename StateT>
+    static void layout(StateT&, int, int, int *, int *, int *)
+    {
+
+    }
+
+    template<typename StateT>
+    static void align(StateT&, const int *, int)
+    {
+
+    }
+};
+
+template<std::size_t rowIndexT, std::size_t firstIndexT, typename RowT, typename... RowsT>
+struct StaticRowLayoutRows<rowIndexT, firstIndexT, RowT, RowsT...>
+{
+    typedef StaticRowLayoutPlace<RowT::horizontalSpace, firstIndexT, void, typename RowT::UiComponents> Place;
+
+    typedef StaticRowLayoutRows<rowIndexT + 1, firstIndexT + RowT::uiComponentCount, RowsT...> Next;
+
+    template<typename StateT>
+    static void layout(StateT& state,
+                       int initialXOffset,
+                       int verticalSpaceBetweenRows,
+                       int * initialYOffset,
+                       int * rowWidths,
+                       int * maxRowWidth)
+    {
+      int xOffset = initialXOffset;
+      int yOffset = *initialYOffset;
+
+      if(rowIndexT > 0)
+      {
+        yOffset += verticalSpaceBetweenRows;
+      }
+
+      int topLabelRowHeight = 0;
+      int bottomLabelRowHeight = 0;
+
+      Place::getLabelRowHeights(state, &topLabelRowHeight, &bottomLabelRowHeight);
+
+      int heightOfTallestUiComponentInRow = 0;
+
+      Place::place(state, yOffset, topLabelRowHeight, &xOffset, &heightOfTallestUiComponentInRow);
+
+      yOffset += topLabelRowHeight + bottomLabelRowHeight;
+
+      rowWidths[rowIndexT] = xOffset - initialXOffset;
+
+      *initialYOffset = yOffset + heightOfTallestUiComponentInRow;
+
+      if(rowWidths[rowIndexT] > *maxRowWidth)
+      {
+        *maxRowWidth = rowWidths[rowIndexT];
+      }
+
+      Next::layout(state, initialXOffset, verticalSpaceBetweenRows, initialYOffset, rowWidths, maxRowWidth);
+    }
+
+    template<typename StateT>
+    static void align(StateT& state,
+                      const int * rowWidths,
+                      int clientWidth)
+    {
+      if(RowT::rowOrientation != RowOrientation::LeftRowOrientation)
+      {
+        int remainingFreeSpace = clientWidth - rowWidths[rowIndexT];
+
+        if(RowT::rowOrientation == RowOrientation::CenterRowOrientation)
+        {
+          remainingFreeSpace = remainingFreeSpace / 2;
+        }
+
+        if(remainingFreeSpace > 0)
+        {
+          for(std::size_t index = firstIndexT; index < firstIndexT + RowT::uiComponentCount; ++index)
+          {
+            state.labelX[index] += remainingFreeSpace;
+            state.uiComponentX[index] += remainingFreeSpace;
+          }
+        }
+      }
+
+      Next::align(state, rowWidths, clientWidth);
+    }
+};
+
+/**
+ * A row layout whose rows, constraints and size groups are fixed at compile
+ * time. It lays out the same UiComponent and Label objects as RowLayout and
+ * gives them the same bounds as a RowLayout with the same rows and
+ * constraints, but every decision that only depends on the constraints is
+ * made by the compiler and no memory is allocated.
+ *
+ * Each pass measures and lays out every row, there is no incremental state,
+ * and uiComponents do not grow. Use RowLayout for layouts that change at run
+ * time.
+ *
+ * For example, a row with a text field and its label on the left, followed
+ * by a row with two buttons of the same size aligned to the right:
+ *
+ *   typedef StaticRowLayout<-1,
+ *                           StaticRow<RowOrientation::LeftRowOrientation, 0,
+ *                                     StaticLabeledUiComponent<> >,
+ *                           StaticRow<RowOrientation::RightRowOrientation, 0,
+ *                                     StaticUiComponent<-1, -1, 0>,
+ *                                     StaticUiComponent<-1, -1, 0> > > Layout;
+ *
+ * @tparam verticalSpaceT the vertical space between rows in pixels or -1 to
+ * use the platform default.
+ *
+ * @tparam RowsT the StaticRow descriptions of the rows, from top to bottom.
+ */
+template<int verticalSpaceT, typename... RowsT>
+class StaticRowLayout : public ILayout
+{
+  public:
+
+    enum
+    {
+      rowCount = sizeof...(RowsT),
+      uiComponentCount = StaticRowLayoutCount<RowsT...>::value
+    };
+
+    static_assert(uiComponentCount > 0, "a StaticRowLayout needs at least one uiComponent");
+
+    /**
+     * Create a new StaticRowLayout.
+     *
+     * @param[in] uiComponent the UiComponent that will be laid out.
+     */
+    StaticRowLayout(UiComponent * uiComponent)
+    :ILayout(),
+     container(uiComponent),
+     layoutMetrics(&LayoutMetrics::getLayoutMetrics(LayoutMetrics::DefaultDpi))
+    {
+      for(std::size_t index = 0; index < uiComponentCount; ++index)
+      {
+        state.labels[index] = nullptr;
+        state.uiComponents[index] = nullptr;
+      }
+
+      for(std::size_t index = 0; index < 2 * uiComponentCount; ++index)
+      {
+        state.appliedBounds[index].uiComponent = nullptr;
+        state.appliedBounds[index].x = INT_MIN;
+        state.appliedBounds[index].y = INT_MIN;
+        state.appliedBounds[index].width = INT_MIN;
+        state.appliedBounds[index].height = INT_MIN;
+        state.appliedBounds[index].changed = 0;
+      }
+
+      uiComponent->setLayout(this);
+    }
+
+    virtual ~StaticRowLayout()
+    {
+
+    }
+
+    /**
+     * Put the specified uiComponent in the specified place of this layout and
+     * add it to the container. The place must be described by a
+     * StaticUiComponent.
+     *
+     * @tparam rowIndexT the row of the uiComponent.
+     *
+     * @tparam indexT the index of the uiComponent within its row.
+     *
+     * @param[in] uiComponent the uiComponent.
+     */
+    template<std::size_t rowIndexT, std::size_t indexT>
+    void setUiComponent(UiComponent * uiComponent)
+    {
+      static_assert(!UiComponentAt<rowIndexT, indexT>::Description::hasLabel,
+                    "the uiComponent is described with a label");
+
+      const std::size_t index = StaticRowLayoutRowAt<rowIndexT, RowsT...>::firstIndex + indexT;
+
+      state.uiComponents[index] = uiComponent;
+
+      container->addUiComponent(uiComponent);
+    }
+
+    /**
+     * Put the specified uiComponent and its associated label in the specified
+     * place of this layout and add them to the container. The place must be
+     * described by a StaticLabeledUiComponent.
+     *
+     * @tparam rowIndexT the row of the uiComponent.
+     *
+     * @tparam indexT the index of the uiComponent within its row.
+     *
+     * @param[in] label the label of the uiComponent.
+     *
+     * @param[in] uiComponent the uiComponent.
+     */
+    template<std::size_t rowIndexT, std::size_t indexT>
+    void setUiComponent(Label * label,
+                        UiComponent * uiComponent)
+    {
+      static_assert(UiComponentAt<rowIndexT, indexT>::Description::hasLabel,
+                    "the uiComponent is described without a label");
+
+      const std::size_t index = StaticRowLayoutRowAt<rowIndexT, RowsT...>::firstIndex + indexT;
+
+      state.labels[index] = label;
+      state.uiComponents[index] = uiComponent;
+
+      container->addUiComponent(label);
+      container->addUiComponent(uiComponent);
+    }
+
+    /**
+     * Set the DPI this layout lays out at. The platform default spacing is
+     * taken from the LayoutMetrics of the DPI. The uiComponents are measured
+     * again by every layout pass, so there is nothing to rescale.
+     *
+     * @param[in] dpi the DPI, LayoutMetrics::DefaultDpi is used if it is not
+     * greater than 0.
+     */
+    void setDpi(int dpi)
+    {
+      layoutMetrics = &LayoutMetrics::getLayoutMetrics(dpi);
+    }
+
+    /**
+     * Return the DPI this layout lays out at.
+     */
+    int getDpi() const
+    {
+      return layoutMetrics->dpi;
+    }
+
+    /**
+     * Lay out every row. Every place of this layout must have been given its
+     * uiComponent.
+     */
+    virtual void executeLayout(UiComponent * uiComponent)
+    {
+      state.horizontalGap = layoutMetrics->horizontalGap;
+
+      Measure::measure(state);
+      Measure::resize(state);
+
+      int initialYOffset = uiComponent->getTopPadding();
+      int maxRowWidth = 0;
+      int rowWidths[rowCount > 0 ? rowCount : 1];
+
+      Rows::layout(state,
+                   uiComponent->getLeftPadding(),
+                   verticalSpaceT < 0 ? layoutMetrics->verticalSpaceBetweenRows : verticalSpaceT,
+                   &initialYOffset,
+                   rowWidths,
+                   &maxRowWidth);
+
+      uiComponent->setPreferredSize(uiComponent->getLeftPadding() + uiComponent->getRightPadding() + maxRowWidth,
+                                    initialYOffset + uiComponent->getBottomPadding());
+
+      Rows::align(state,
+                  rowWidths,
+                  uiComponent->getClientWidth() - uiComponent->getLeftPadding() - uiComponent->getRightPadding());
+
+      applyBounds(uiComponent);
+    }
+
+  private:
+
+    template<std::size_t rowIndexT, std::size_t indexT>
+    struct UiComponentAt
+    {
+        typedef typename StaticRowLayoutRowAt<rowIndexT, RowsT...>::Row Row;
+
+        static_assert(indexT < Row::uiComponentCount, "the row does not have that many uiComponents");
+
+        typedef typename StaticRowLayoutUiComponentAt<indexT, typename Row::UiComponents>::Description Description;
+    };
+
+    typedef typename StaticRowLayoutFlatten<StaticRowLayoutList<>, RowsT...>::List UiComponents;
+
+    typedef StaticRowLayoutMeasure<0, UiComponents, UiComponents> Measure;
+
+    typedef StaticRowLayoutRows<0, 0, RowsT...> Rows;
+
+    void addChangedBounds(UiComponent * uiComponent,
+                          int x,
+                          int y,
+                          int width,
+                          int height,
+                          UiComponentBounds * appliedBounds,
+                          UiComponentBounds * changedBounds,
+                          std::size_t * changedBoundsCount)
+    {
+      unsigned char changed = 0;
+
+      if(appliedBounds->width != width || appliedBounds->height != height)
+      {
+        changed |= UiComponentBounds::SizeChanged;
+      }
+
+      if(appliedBounds->x != x || appliedBounds->y != y)
+      {
+        changed |= UiComponentBounds::LocationChanged;
+      }
+
+      if(!changed)
+      {
+        return;
+      }
+
+      appliedBounds->uiComponent = uiComponent;
+      appliedBounds->x = x;
+      appliedBounds->y = y;
+      appliedBounds->width = width;
+      appliedBounds->height = height;
+      appliedBounds->changed = changed;
+
+      changedBounds[(*changedBoundsCount)++] = *appliedBounds;
+    }
+
+    // Apply the bounds that differ from the ones that were last applied, in
+    // the same order as RowLayout.
+    void applyBounds(UiComponent * uiComponent)
+    {
+      UiComponentBounds changedBounds[2 * uiComponentCount];
+      std::size_t changedBoundsCount = 0;
+
+      for(std::size_t index = 0; index < uiComponentCount; ++index)
+      {
+        if(state.labels[index])
+        {
+          addChangedBounds(state.labels[index],
+                           state.labelX[index],
+                           state.labelY[index],
+                           state.labelWidth[index],
+                           state.labelHeight[index],
+                           &state.appliedBounds[2 * index],
+                           changedBounds,
+                           &changedBoundsCount);
+        }
+
+        addChangedBounds(state.uiComponents[index],
+                         state.uiComponentX[index],
+                         state.uiComponentY[index],
+                         state.uiComponentWidth[index],
+                         state.uiComponentHeight[index],
+                         &state.appliedBounds[2 * index + 1],
+                         changedBounds,
+                         &changedBoundsCount);
+      }
+
+      if(changedBoundsCount == 0)
+      {
+        return;
+      }
+
+      ILayoutContainer * layoutContainer = dynamic_cast<ILayoutContainer *>(uiComponent);
+
+      if(layoutContainer)
+      {
+        // The container moves every child in one step, so nothing flickers.
+        layoutContainer->setBounds(changedBounds, changedBoundsCount);
+
+        return;
+      }
+
+      for(std::size_t i = 0; i < changedBoundsCount; ++i)
+      {
+        const UiComponentBounds& uiComponentBounds = changedBounds[i];
+
+        // To prevent flickering while applying the new bounds.
+        uiComponentBounds.uiComponent->disableDrawing();
+
+        if(uiComponentBounds.changed & UiComponentBounds::SizeChanged)
+        {
+          uiComponentBounds.uiComponent->setSize(uiComponentBounds.width,
+                                                 uiComponentBounds.height);
+        }
+
+        if(uiComponentBounds.changed & UiComponentBounds::LocationChanged)
+        {
+          uiComponentBounds.uiComponent->setLocation(uiComponentBounds.x,
+                                                     uiComponentBounds.y);
+        }
+
+        uiComponentBounds.uiComponent->enableDrawing();
+      }
+    }
+
+    UiComponent * container;
+
+    const LayoutMetrics * layoutMetrics;
+
+    StaticRowLayoutState<uiComponentCount> state;
+};
+#endif /* UI_LAYOUT_STATICROWLAYOUT_H_ */
@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: UiComponentBounds.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_UICOMPONENTBOUNDS_H_
+#define UI_LAYOUT_UICOMPONENTBOUNDS_H_
+
+class UiComponent;
+
+/**
+ * The new bounds of one uiComponent or label as computed by a layout pass.
+ * Only the parts specified by changed differ from the bounds that were last
+ * applied to the uiComponent.
+ */
+struct UiComponentBounds
+{
+    enum Change
+    {
+      SizeChanged = 1,
+      LocationChanged = 2
+    };
+
+    UiComponent * uiComponent;
+
+    int x;
+
+    int y;
+
+    int width;
+
+    int height;
+
+    /**
+     * A combination of Change values.
+     */
+    unsigned char changed;
+};
+#endif /* UI_LAYOUT_UICOMPONENTBOUNDS_H_ */
@@ -66,6 +66,12 @@ struct UiComponentConstraints
     /**
      * Controls how much a UiComponent grows. The default 0 means a
      * UiComponent will not grow.
+     *
+     * The width left over in a row is split among the UiComponents in that
+     * row with a growX greater than 0, in proportion to their growX. The
+     * height left over in the container is split among the rows with a
+     * UiComponent whose growY is greater than 0, in proportion to the largest
+     * growY in each row.
      */
     int growX;
     int growY;
@@ -0,0 +1,40 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: UiComponentEntry.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_UICOMPONENTENTRY_H_
+#define UI_LAYOUT_UICOMPONENTENTRY_H_
+
+class UiComponent;
+class Label;
+struct UiComponentConstraints;
+
+/**
+ * One uiComponent, its associated label, if any, and its constraints. Used to
+ * add many uiComponents to a layout in one call.
+ */
+struct UiComponentEntry
+{
+    /**
+     * The label associated with the uiComponent or nullptr if the uiComponent
+     * does not have a label.
+     */
+    Label * label;
+
+    UiComponent * uiComponent;
+
+    /**
+     * The constraints to which the uiComponent and its associated label are
+     * bound. The constraints are copied.
+     */
+    const UiComponentConstraints * uiComponentConstraints;
+};
+#endif /* UI_LAYOUT_UICOMPONENTENTRY_H_ */
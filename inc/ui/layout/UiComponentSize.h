@@ -13,6 +13,10 @@
 #ifndef UI_LAYOUT_UICOMPONENTSIZE_H_
 #define UI_LAYOUT_UICOMPONENTSIZE_H_
 
+/**
+ * The platform standard sizes and spacing in pixels at
+ * LayoutMetrics::DefaultDpi. Use LayoutMetrics for other DPIs.
+ */
 class UiComponentSize
 {
   public:
@@ -26,5 +30,16 @@ class UiComponentSize
     static int getButtonHeight();
 
     static int getLabelHeight();
+
+    /**
+     * Return the vertical space between unrelated rows.
+     */
+    static int getVerticalSpaceBetweenRows();
+
+    /**
+     * Return the horizontal gap between related uiComponents, the
+     * platform spacing between related controls.
+     */
+    static int getHorizontalGap();
 };
 #endif /* UI_LAYOUT_UICOMPONENTSIZE_H_ */
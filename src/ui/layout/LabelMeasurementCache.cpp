@@ -0,0 +1,196 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LabelMeasurementCache.cpp
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <functional>
+
+#include "ui/layout/private/LabelMeasurementCache.h"
+
+LabelMeasurementCache::LabelMeasurementCache()
+:capacity(DefaultCapacity),
+ hitCount(0),
+ missCount(0),
+ insertCount(0)
+{
+
+}
+
+LabelMeasurementCache::~LabelMeasurementCache()
+{
+
+}
+
+bool LabelMeasurementCache::find(const void * fontIdentity,
+                                 const std::string& text,
+                                 int * width,
+                                 int * height)
+{
+  typedef std::unordered_multimap<std::size_t, std::list<Entry>::iterator>::iterator EntryIndexIterator;
+
+  const std::pair<EntryIndexIterator, EntryIndexIterator> range = entryIndex.equal_range(getHash(fontIdentity, text));
+
+  for(EntryIndexIterator it = range.first; it != range.second; ++it)
+  {
+    const Entry& entry = *it->second;
+
+    if(entry.fontIdentity == fontIdentity && entry.text == text)
+    {
+      // Move the entry to the front without copying it.
+      entries.splice(entries.begin(), entries, it->second);
+
+      *width = entry.width;
+      *height = entry.height;
+
+      if(entry.width != NotMeasured)
+      {
+        ++hitCount;
+      }
+
+      return true;
+    }
+  }
+
+  ++missCount;
+
+  return false;
+}
+
+void LabelMeasurementCache::insert(const void * fontIdentity,
+                                   const std::string& text,
+                                   int width,
+                                   int height)
+{
+  if(capacity == 0)
+  {
+    return;
+  }
+
+  const std::size_t hash = getHash(fontIdentity, text);
+
+  typedef std::unordered_multimap<std::size_t, std::list<Entry>::iterator>::iterator EntryIndexIterator;
+
+  const std::pair<EntryIndexIterator, EntryIndexIterator> range = entryIndex.equal_range(hash);
+
+  for(EntryIndexIterator it = range.first; it != range.second; ++it)
+  {
+    Entry& entry = *it->second;
+
+    if(entry.fontIdentity == fontIdentity && entry.text == text)
+    {
+      entry.width = width;
+      entry.height = height;
+
+      entries.splice(entries.begin(), entries, it->second);
+
+      return;
+    }
+  }
+
+  if(entries.size() == capacity)
+  {
+    erase(--entries.end());
+  }
+
+  Entry entry;
+
+  entry.fontIdentity = fontIdentity;
+  entry.text = text;
+  entry.hash = hash;
+  entry.width = width;
+  entry.height = height;
+
+  entries.push_front(entry);
+
+  ++insertCount;
+
+  entryIndex.insert(std::pair<const std::size_t, std::list<Entry>::iterator>(hash, entries.begin()));
+}
+
+void LabelMeasurementCache::removeFont(const void * fontIdentity)
+{
+  for(std::list<Entry>::iterator it = entries.begin(); it != entries.end();)
+  {
+    std::list<Entry>::iterator entry = it++;
+
+    if(entry->fontIdentity == fontIdentity)
+    {
+      erase(entry);
+    }
+  }
+}
+
+void LabelMeasurementCache::clear()
+{
+  entries.clear();
+  entryIndex.clear();
+}
+
+void LabelMeasurementCache::setCapacity(std::size_t capacity)
+{
+  this->capacity = capacity;
+
+  while(entries.size() > capacity)
+  {
+    erase(--entries.end());
+  }
+}
+
+std::size_t LabelMeasurementCache::getCapacity() const
+{
+  return capacity;
+}
+
+std::size_t LabelMeasurementCache::size() const
+{
+  return entries.size();
+}
+
+std::size_t LabelMeasurementCache::getHitCount() const
+{
+  return hitCount;
+}
+
+std::size_t LabelMeasurementCache::getMissCount() const
+{
+  return missCount;
+}
+
+std::size_t LabelMeasurementCache::getInsertCount() const
+{
+  return insertCount;
+}
+
+std::size_t LabelMeasurementCache::getHash(const void * fontIdentity,
+                                           const std::string& text)
+{
+  const std::size_t textHash = std::hash<std::string>()(text);
+
+  return textHash ^ (std::hash<const void *>()(fontIdentity) + 0x9e3779b9 + (textHash << 6) + (textHash >> 2));
+}
+
+void LabelMeasurementCache::erase(std::list<Entry>::iterator entry)
+{
+  typedef std::unordered_multimap<std::size_t, std::list<Entry>::iterator>::iterator EntryIndexIterator;
+
+  const std::pair<EntryIndexIterator, EntryIndexIterator> range = entryIndex.equal_range(entry->hash);
+
+  for(EntryIndexIterator it = range.first; it != range.second; ++it)
+  {
+    if(it->second == entry)
+    {
+      entryIndex.erase(it);
+
+      break;
+    }
+  }
+
+  entries.erase(entry);
+}
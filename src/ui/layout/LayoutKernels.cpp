@@ -0,0 +1,344 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutKernels.cpp
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ui/layout/private/LayoutKernels.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || (defined(__i386__) && defined(__SSE2__))
+#define UI_LAYOUT_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// The AVX2 kernels are compiled for every x86 processor and only selected if
+// the processor and the operating system support AVX2.
+#if defined(UI_LAYOUT_HAS_SSE2) && (defined(_MSC_VER) || defined(__GNUC__))
+#define UI_LAYOUT_HAS_AVX2 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define UI_LAYOUT_AVX2_FUNCTION
+#else
+#define UI_LAYOUT_AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+#endif
+
+static void addToValuesScalar(int * values,
+                              std::size_t count,
+                              int distance)
+{
+  for(std::size_t i = 0; i < count; ++i)
+  {
+    values[i] += distance;
+  }
+}
+
+static int getMaxValueScalar(const int * values,
+                             std::size_t count,
+                             int initialValue)
+{
+  int maxValue = initialValue;
+
+  for(std::size_t i = 0; i < count; ++i)
+  {
+    maxValue = values[i] > maxValue ? values[i] : maxValue;
+  }
+
+  return maxValue;
+}
+
+static int getSumOfPositiveValuesScalar(const int * values,
+                                        std::size_t count)
+{
+  int sum = 0;
+
+  for(std::size_t i = 0; i < count; ++i)
+  {
+    sum += values[i] > 0 ? values[i] : 0;
+  }
+
+  return sum;
+}
+
+#if defined(UI_LAYOUT_HAS_SSE2)
+
+// SSE2 has no 32-bit integer max, so the larger lanes are selected with a
+// compare mask.
+static __m128i maxSse2(__m128i a, __m128i b)
+{
+  const __m128i aIsGreater = _mm_cmpgt_epi32(a, b);
+
+  return _mm_or_si128(_mm_and_si128(aIsGreater, a), _mm_andnot_si128(aIsGreater, b));
+}
+
+static void addToValuesSse2(int * values,
+                            std::size_t count,
+                            int distance)
+{
+  const __m128i distances = _mm_set1_epi32(distance);
+
+  std::size_t i = 0;
+
+  // Two vectors per iteration so that both store ports are used.
+  for(; i + 8 <= count; i += 8)
+  {
+    __m128i * p = reinterpret_cast<__m128i *>(values + i);
+
+    const __m128i first = _mm_add_epi32(_mm_loadu_si128(p), distances);
+    const __m128i second = _mm_add_epi32(_mm_loadu_si128(p + 1), distances);
+
+    _mm_storeu_si128(p, first);
+    _mm_storeu_si128(p + 1, second);
+  }
+
+  addToValuesScalar(values + i, count - i, distance);
+}
+
+static int getMaxValueSse2(const int * values,
+                           std::size_t count,
+                           int initialValue)
+{
+  // maxSse2 takes three dependent instructions, so four independent maxima
+  // are kept to hide its latency.
+  __m128i maxValues = _mm_set1_epi32(initialValue);
+  __m128i maxValues1 = maxValues;
+  __m128i maxValues2 = maxValues;
+  __m128i maxValues3 = maxValues;
+
+  std::size_t i = 0;
+
+  for(; i + 16 <= count; i += 16)
+  {
+    const __m128i * p = reinterpret_cast<const __m128i *>(values + i);
+
+    maxValues = maxSse2(maxValues, _mm_loadu_si128(p));
+    maxValues1 = maxSse2(maxValues1, _mm_loadu_si128(p + 1));
+    maxValues2 = maxSse2(maxValues2, _mm_loadu_si128(p + 2));
+    maxValues3 = maxSse2(maxValues3, _mm_loadu_si128(p + 3));
+  }
+
+  maxValues = maxSse2(maxSse2(maxValues, maxValues1), maxSse2(maxValues2, maxValues3));
+
+  for(; i + 4 <= count; i += 4)
+  {
+    maxValues = maxSse2(maxValues, _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i)));
+  }
+
+  maxValues = maxSse2(maxValues, _mm_shuffle_epi32(maxValues, _MM_SHUFFLE(1, 0, 3, 2)));
+  maxValues = maxSse2(maxValues, _mm_shuffle_epi32(maxValues, _MM_SHUFFLE(2, 3, 0, 1)));
+
+  return getMaxValueScalar(values + i, count - i, _mm_cvtsi128_si32(maxValues));
+}
+
+static int getSumOfPositiveValuesSse2(const int * values,
+                                      std::size_t count)
+{
+  const __m128i zeros = _mm_setzero_si128();
+
+  __m128i sums = zeros;
+  __m128i sums1 = zeros;
+
+  std::size_t i = 0;
+
+  for(; i + 8 <= count; i += 8)
+  {
+    const __m128i * p = reinterpret_cast<const __m128i *>(values + i);
+
+    const __m128i first = _mm_loadu_si128(p);
+    const __m128i second = _mm_loadu_si128(p + 1);
+
+    sums = _mm_add_epi32(sums, _mm_and_si128(first, _mm_cmpgt_epi32(first, zeros)));
+    sums1 = _mm_add_epi32(sums1, _mm_and_si128(second, _mm_cmpgt_epi32(second, zeros)));
+  }
+
+  sums = _mm_add_epi32(sums, sums1);
+
+  for(; i + 4 <= count; i += 4)
+  {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i));
+
+    sums = _mm_add_epi32(sums, _mm_and_si128(v, _mm_cmpgt_epi32(v, zeros)));
+  }
+
+  sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(1, 0, 3, 2)));
+  sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(2, 3, 0, 1)));
+
+  return _mm_cvtsi128_si32(sums) + getSumOfPositiveValuesScalar(values + i, count - i);
+}
+
+#endif
+
+#if defined(UI_LAYOUT_HAS_AVX2)
+
+UI_LAYOUT_AVX2_FUNCTION
+static void addToValuesAvx2(int * values,
+                            std::size_t count,
+                            int distance)
+{
+  const __m256i distances = _mm256_set1_epi32(distance);
+
+  std::size_t i = 0;
+
+  for(; i + 8 <= count; i += 8)
+  {
+    __m256i * p = reinterpret_cast<__m256i *>(values + i);
+
+    _mm256_storeu_si256(p, _mm256_add_epi32(_mm256_loadu_si256(p), distances));
+  }
+
+  addToValuesScalar(values + i, count - i, distance);
+}
+
+UI_LAYOUT_AVX2_FUNCTION
+static int getMaxValueAvx2(const int * values,
+                           std::size_t count,
+                           int initialValue)
+{
+  __m256i maxValues = _mm256_set1_epi32(initialValue);
+
+  std::size_t i = 0;
+
+  for(; i + 8 <= count; i += 8)
+  {
+    maxValues = _mm256_max_epi32(maxValues, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i)));
+  }
+
+  __m128i halves = _mm_max_epi32(_mm256_castsi256_si128(maxValues), _mm256_extracti128_si256(maxValues, 1));
+
+  halves = _mm_max_epi32(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(1, 0, 3, 2)));
+  halves = _mm_max_epi32(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+
+  return getMaxValueScalar(values + i, count - i, _mm_cvtsi128_si32(halves));
+}
+
+UI_LAYOUT_AVX2_FUNCTION
+static int getSumOfPositiveValuesAvx2(const int * values,
+                                      std::size_t count)
+{
+  const __m256i zeros = _mm256_setzero_si256();
+
+  __m256i sums = zeros;
+
+  std::size_t i = 0;
+
+  for(; i + 8 <= count; i += 8)
+  {
+    sums = _mm256_add_epi32(sums, _mm256_max_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i)), zeros));
+  }
+
+  __m128i halves = _mm_add_epi32(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+
+  halves = _mm_add_epi32(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(1, 0, 3, 2)));
+  halves = _mm_add_epi32(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+
+  return _mm_cvtsi128_si32(halves) + getSumOfPositiveValuesScalar(values + i, count - i);
+}
+
+static bool isAvx2Supported()
+{
+#if defined(_MSC_VER)
+  int cpuInfo[4];
+
+  __cpuid(cpuInfo, 0);
+
+  if(cpuInfo[0] < 7)
+  {
+    return false;
+  }
+
+  // The processor must support AVX and the operating system must save the
+  // AVX registers on a context switch.
+  __cpuid(cpuInfo, 1);
+
+  const int osxsaveAndAvx = (1 << 27) | (1 << 28);
+
+  if((cpuInfo[2] & osxsaveAndAvx) != osxsaveAndAvx || (_xgetbv(0) & 6) != 6)
+  {
+    return false;
+  }
+
+  __cpuidex(cpuInfo, 7, 0);
+
+  return (cpuInfo[1] & (1 << 5)) != 0;
+#else
+  __builtin_cpu_init();
+
+  return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif
+
+static LayoutKernelLevel detectLayoutKernelLevel()
+{
+#if defined(UI_LAYOUT_HAS_AVX2)
+  if(isAvx2Supported())
+  {
+    return Avx2LayoutKernels;
+  }
+#endif
+
+#if defined(UI_LAYOUT_HAS_SSE2)
+  return Sse2LayoutKernels;
+#else
+  return ScalarLayoutKernels;
+#endif
+}
+
+LayoutKernelLevel getSupportedLayoutKernelLevel()
+{
+  static const LayoutKernelLevel supportedLayoutKernelLevel = detectLayoutKernelLevel();
+
+  return supportedLayoutKernelLevel;
+}
+
+const LayoutKernels& getLayoutKernels(LayoutKernelLevel layoutKernelLevel)
+{
+  static const LayoutKernels scalarLayoutKernels = { addToValuesScalar,
+                                                     getMaxValueScalar,
+                                                     getSumOfPositiveValuesScalar };
+
+  if(layoutKernelLevel > getSupportedLayoutKernelLevel())
+  {
+    layoutKernelLevel = getSupportedLayoutKernelLevel();
+  }
+
+#if defined(UI_LAYOUT_HAS_AVX2)
+  static const LayoutKernels avx2LayoutKernels = { addToValuesAvx2,
+                                                   getMaxValueAvx2,
+                                                   getSumOfPositiveValuesAvx2 };
+
+  if(layoutKernelLevel == Avx2LayoutKernels)
+  {
+    return avx2LayoutKernels;
+  }
+#endif
+
+#if defined(UI_LAYOUT_HAS_SSE2)
+  static const LayoutKernels sse2LayoutKernels = { addToValuesSse2,
+                                                   getMaxValueSse2,
+                                                   getSumOfPositiveValuesSse2 };
+
+  if(layoutKernelLevel == Sse2LayoutKernels)
+  {
+    return sse2LayoutKernels;
+  }
+#endif
+
+  return scalarLayoutKernels;
+}
+
+const LayoutKernels& getLayoutKernels()
+{
+  static const LayoutKernels& layoutKernels = getLayoutKernels(getSupportedLayoutKernelLevel());
+
+  return layoutKernels;
+}
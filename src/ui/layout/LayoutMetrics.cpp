@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutMetrics.cpp
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <map>
+#include <mutex>
+
+#include "ui/layout/UiComponentSize.h"
+
+#include "ui/layout/LayoutMetrics.h"
+
+static LayoutMetrics buildLayoutMetrics(int dpi)
+{
+  LayoutMetrics layoutMetrics;
+
+  layoutMetrics.dpi = dpi;
+  layoutMetrics.verticalSpaceBetweenRows = LayoutMetrics::scale(UiComponentSize::getVerticalSpaceBetweenRows(), LayoutMetrics::DefaultDpi, dpi);
+  layoutMetrics.horizontalGap = LayoutMetrics::scale(UiComponentSize::getHorizontalGap(), LayoutMetrics::DefaultDpi, dpi);
+  layoutMetrics.buttonWidth = LayoutMetrics::scale(UiComponentSize::getButtonWidth(), LayoutMetrics::DefaultDpi, dpi);
+  layoutMetrics.buttonHeight = LayoutMetrics::scale(UiComponentSize::getButtonHeight(), LayoutMetrics::DefaultDpi, dpi);
+  layoutMetrics.labelHeight = LayoutMetrics::scale(UiComponentSize::getLabelHeight(), LayoutMetrics::DefaultDpi, dpi);
+
+  return layoutMetrics;
+}
+
+/*static*/ const LayoutMetrics& LayoutMetrics::getLayoutMetrics(int dpi)
+{
+  // The metrics are never removed, so the references handed out stay valid.
+  static std::mutex layoutMetricsMutex;
+  static std::map<int, LayoutMetrics> layoutMetricsByDpi;
+
+  if(dpi <= 0)
+  {
+    dpi = DefaultDpi;
+  }
+
+  std::lock_guard<std::mutex> lock(layoutMetricsMutex);
+
+  std::map<int, LayoutMetrics>::iterator it = layoutMetricsByDpi.find(dpi);
+
+  if(it == layoutMetricsByDpi.end())
+  {
+    it = layoutMetricsByDpi.insert(std::pair<const int, LayoutMetrics>(dpi, ::buildLayoutMetrics(dpi))).first;
+  }
+
+  return it->second;
+}
+
+/*static*/ int LayoutMetrics::scale(int value,
+                                    int fromDpi,
+                                    int toDpi)
+{
+  if(fromDpi == toDpi || fromDpi <= 0)
+  {
+    return value;
+  }
+
+  const long long scaled = static_cast<long long>(value) * toDpi;
+
+  // Round half away from zero.
+  if(scaled < 0)
+  {
+    return static_cast<int>((scaled - fromDpi / 2) / fromDpi);
+  }
+
+  return static_cast<int>((scaled + fromDpi / 2) / fromDpi);
+}
@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutResult.cpp
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ui/layout/private/LayoutResultPrivate.h"
+
+#include "ui/layout/LayoutResult.h"
+
+LayoutResultPrivate::LayoutResultPrivate()
+:rowLayoutPrivate(nullptr),
+ container(nullptr),
+ layoutRevision(0),
+ preferredWidth(0),
+ preferredHeight(0)
+{
+
+}
+
+LayoutResult::LayoutResult()
+:d(new LayoutResultPrivate())
+{
+
+}
+
+LayoutResult::LayoutResult(const LayoutResult& other)
+:d(new LayoutResultPrivate(*other.d))
+{
+
+}
+
+LayoutResult& LayoutResult::operator=(const LayoutResult& other)
+{
+  *d = *other.d;
+
+  return *this;
+}
+
+LayoutResult::~LayoutResult()
+{
+  delete d;
+  d = nullptr;
+}
+
+int LayoutResult::getPreferredWidth() const
+{
+  return d->preferredWidth;
+}
+
+int LayoutResult::getPreferredHeight() const
+{
+  return d->preferredHeight;
+}
+
+std::size_t LayoutResult::getBoundsCount() const
+{
+  return d->bounds.size();
+}
+
+const UiComponentBounds& LayoutResult::getBoundsAt(std::size_t index) const
+{
+  return d->bounds.at(index);
+}
+
+std::size_t LayoutResult::getRowCount() const
+{
+  return d->rowExtents.size();
+}
+
+const RowExtent& LayoutResult::getRowExtentAt(std::size_t row) const
+{
+  return d->rowExtents.at(row);
+}
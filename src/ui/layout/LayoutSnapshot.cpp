@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutSnapshot.cpp
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ui/layout/private/LayoutSnapshotPrivate.h"
+
+#include "ui/layout/LayoutSnapshot.h"
+
+LayoutSnapshotPrivate::LayoutSnapshotPrivate()
+:rowLayoutPrivate(nullptr),
+ container(nullptr),
+ containerClientWidth(0),
+ containerClientHeight(0),
+ verticalSpaceBetweenRows(0),
+ layoutRevision(0)
+{
+  containerPadding.leftPadding = 0;
+  containerPadding.rightPadding = 0;
+  containerPadding.topPadding = 0;
+  containerPadding.bottomPadding = 0;
+}
+
+LayoutSnapshot::LayoutSnapshot()
+:d(new LayoutSnapshotPrivate())
+{
+
+}
+
+LayoutSnapshot::LayoutSnapshot(const LayoutSnapshot& other)
+:d(new LayoutSnapshotPrivate(*other.d))
+{
+
+}
+
+LayoutSnapshot& LayoutSnapshot::operator=(const LayoutSnapshot& other)
+{
+  *d = *other.d;
+
+  return *this;
+}
+
+LayoutSnapshot::~LayoutSnapshot()
+{
+  delete d;
+  d = nullptr;
+}
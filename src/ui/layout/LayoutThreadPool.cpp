@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutThreadPool.cpp
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ui/layout/private/LayoutThreadPool.h"
+
+LayoutThreadPool::LayoutThreadPool()
+:generation(0),
+ stopping(false),
+ busyWorkerCount(0),
+ taskCount(0),
+ task(nullptr),
+ userData(nullptr),
+ nextTaskIndex(0)
+{
+
+}
+
+LayoutThreadPool::~LayoutThreadPool()
+{
+  stopWorkers();
+}
+
+void LayoutThreadPool::setThreadCount(std::size_t threadCount)
+{
+  stopWorkers();
+
+  // The calling thread is one of the threads. The workers are handed the
+  // current generation so that they cannot miss the tasks of the next one.
+  for(std::size_t i = 1; i < threadCount; ++i)
+  {
+    workers.push_back(std::thread(&LayoutThreadPool::workerLoop, this, generation));
+  }
+}
+
+std::size_t LayoutThreadPool::getThreadCount() const
+{
+  return workers.size() + 1;
+}
+
+void LayoutThreadPool::run(std::size_t taskCount,
+                           void (*task)(std::size_t taskIndex, void * userData),
+                           void * userData)
+{
+  if(workers.empty() || taskCount < 2)
+  {
+    for(std::size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+    {
+      task(taskIndex, userData);
+    }
+
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    this->taskCount = taskCount;
+    this->task = task;
+    this->userData = userData;
+
+    nextTaskIndex.store(0);
+
+    busyWorkerCount = workers.size();
+
+    ++generation;
+  }
+
+  workAvailable.notify_all();
+
+  runTasks();
+
+  std::unique_lock<std::mutex> lock(mutex);
+
+  while(busyWorkerCount > 0)
+  {
+    workDone.wait(lock);
+  }
+}
+
+void LayoutThreadPool::stopWorkers()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    stopping = true;
+  }
+
+  workAvailable.notify_all();
+
+  for(std::size_t i = 0; i < workers.size(); ++i)
+  {
+    workers.at(i).join();
+  }
+
+  workers.clear();
+
+  stopping = false;
+}
+
+void LayoutThreadPool::workerLoop(std::size_t lastGeneration)
+{
+  for(;;)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+
+      while(!stopping && generation == lastGeneration)
+      {
+        workAvailable.wait(lock);
+      }
+
+      if(stopping)
+      {
+        return;
+      }
+
+      lastGeneration = generation;
+    }
+
+    runTasks();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      if(--busyWorkerCount == 0)
+      {
+        workDone.notify_one();
+      }
+    }
+  }
+}
+
+void LayoutThreadPool::runTasks()
+{
+  // Every thread takes the next task that nobody took yet, so the threads
+  // stay busy even if some tasks take longer than others.
+  for(;;)
+  {
+    const std::size_t taskIndex = nextTaskIndex.fetch_add(1);
+
+    if(taskIndex >= taskCount)
+    {
+      return;
+    }
+
+    task(taskIndex, userData);
+  }
+}
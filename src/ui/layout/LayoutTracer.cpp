@@ -0,0 +1,295 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutTracer.cpp
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ui/layout/private/LayoutTracerPrivate.h"
+
+#include "ui/layout/LayoutTracer.h"
+
+// The names of the phases in a trace, the functions of RowLayout that run
+// them.
+static const char * getLayoutPhaseName(LayoutPhase::Value layoutPhase)
+{
+  switch(layoutPhase)
+  {
+    case LayoutPhase::LayoutPassPhase:
+      return "executeLayout";
+    case LayoutPhase::PreLayoutPhase:
+      return "preLayout";
+    case LayoutPhase::SizeGroupPhase:
+      return "resizeUiComponentsInSizeGroups";
+    case LayoutPhase::LabelRowPhase:
+      return "resizeLabelRows";
+    case LayoutPhase::PostLayoutPhase:
+      return "postLayout";
+    case LayoutPhase::ApplyBoundsPhase:
+      return "applyBounds";
+  }
+
+  return "unknown";
+}
+
+LayoutTracerPrivate::LayoutTracerPrivate(std::size_t eventCapacity)
+:startTime(std::chrono::steady_clock::now()),
+ eventCapacity(eventCapacity),
+ firstEvent(0),
+ eventCount(0),
+ file(nullptr),
+ fileEmpty(true)
+{
+
+}
+
+void LayoutTracerPrivate::addEvent(LayoutPhase::Value layoutPhase,
+                                   char eventType,
+                                   std::size_t rowCount,
+                                   std::size_t uiComponentCount)
+{
+  const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  LayoutTraceEvent layoutTraceEvent;
+  layoutTraceEvent.layoutPhase = layoutPhase;
+  layoutTraceEvent.eventType = eventType;
+  layoutTraceEvent.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(now - startTime).count();
+  layoutTraceEvent.threadId = getThreadId(std::this_thread::get_id());
+  layoutTraceEvent.rowCount = rowCount;
+  layoutTraceEvent.uiComponentCount = uiComponentCount;
+
+  if(file)
+  {
+    std::string json(fileEmpty ? "" : ",\n");
+
+    appendEvent(layoutTraceEvent, &json);
+
+    std::fwrite(json.data(), 1, json.size(), file);
+
+    // Flushing once per layout pass keeps the file up to date with the
+    // finished passes without a write for every phase.
+    if(layoutPhase == LayoutPhase::LayoutPassPhase && eventType == 'E')
+    {
+      std::fflush(file);
+    }
+
+    fileEmpty = false;
+  }
+
+  if(eventCapacity == 0)
+  {
+    return;
+  }
+
+  // The buffer only grows until it holds eventCapacity events, then the
+  // oldest event is overwritten.
+  if(events.size() < eventCapacity)
+  {
+    events.push_back(layoutTraceEvent);
+  }
+  else
+  {
+    events[(firstEvent + eventCount) % eventCapacity] = layoutTraceEvent;
+  }
+
+  if(eventCount < eventCapacity)
+  {
+    ++eventCount;
+  }
+  else
+  {
+    firstEvent = (firstEvent + 1) % eventCapacity;
+  }
+}
+
+std::size_t LayoutTracerPrivate::getThreadId(std::thread::id id)
+{
+  for(std::size_t i = 0; i < threadIds.size(); ++i)
+  {
+    if(threadIds.at(i) == id)
+    {
+      return i + 1;
+    }
+  }
+
+  threadIds.push_back(id);
+
+  return threadIds.size();
+}
+
+void LayoutTracerPrivate::appendEvent(const LayoutTraceEvent& layoutTraceEvent,
+                                      std::string * json)
+{
+  char buffer[256];
+
+  // The timestamps of the trace event format are in microseconds.
+  std::snprintf(buffer,
+                sizeof(buffer),
+                "{\"name\":\"%s\",\"cat\":\"layout\",\"ph\":\"%c\",\"ts\":%lld.%03lld,\"pid\":1,\"tid\":%zu,"
+                "\"args\":{\"rows\":%zu,\"uiComponents\":%zu}}",
+                ::getLayoutPhaseName(layoutTraceEvent.layoutPhase),
+                layoutTraceEvent.eventType,
+                layoutTraceEvent.timestamp / 1000,
+                layoutTraceEvent.timestamp % 1000,
+                layoutTraceEvent.threadId,
+                layoutTraceEvent.rowCount,
+                layoutTraceEvent.uiComponentCount);
+
+  json->append(buffer);
+}
+
+LayoutTracer::LayoutTracer()
+:d(new LayoutTracerPrivate(DefaultEventCapacity))
+{
+
+}
+
+LayoutTracer::LayoutTracer(std::size_t eventCapacity)
+:d(new LayoutTracerPrivate(eventCapacity))
+{
+
+}
+
+LayoutTracer::~LayoutTracer()
+{
+  closeFile();
+
+  delete d;
+}
+
+bool LayoutTracer::openFile(const char * fileName)
+{
+  closeFile();
+
+  std::FILE * file = std::fopen(fileName, "w");
+
+  if(!file)
+  {
+    return false;
+  }
+
+  // A JSON array of events may be loaded even if the file is not finished,
+  // for example when the process crashed.
+  std::fputs("[\n", file);
+
+  std::lock_guard<std::mutex> lock(d->mutex);
+
+  d->file = file;
+  d->fileEmpty = true;
+
+  return true;
+}
+
+void LayoutTracer::closeFile()
+{
+  std::lock_guard<std::mutex> lock(d->mutex);
+
+  if(!d->file)
+  {
+    return;
+  }
+
+  std::fputs("\n]\n", d->file);
+  std::fclose(d->file);
+
+  d->file = nullptr;
+}
+
+void LayoutTracer::beginLayoutPhase(LayoutPhase::Value layoutPhase,
+                                    std::size_t rowCount,
+                                    std::size_t uiComponentCount)
+{
+  d->addEvent(layoutPhase, 'B', rowCount, uiComponentCount);
+}
+
+void LayoutTracer::endLayoutPhase(LayoutPhase::Value layoutPhase,
+                                  std::size_t rowCount,
+                                  std::size_t uiComponentCount)
+{
+  d->addEvent(layoutPhase, 'E', rowCount, uiComponentCount);
+}
+
+std::size_t LayoutTracer::getEventCount() const
+{
+  std::lock_guard<std::mutex> lock(d->mutex);
+
+  return d->eventCount;
+}
+
+void LayoutTracer::clear()
+{
+  std::lock_guard<std::mutex> lock(d->mutex);
+
+  d->events.clear();
+  d->firstEvent = 0;
+  d->eventCount = 0;
+}
+
+std::string LayoutTracer::getTraceJson() const
+{
+  std::lock_guard<std::mutex> lock(d->mutex);
+
+  std::string json("{\"traceEvents\":[\n");
+
+  // The number of open phases of each thread.
+  std::vector<std::size_t> depths(d->threadIds.size() + 1, 0);
+
+  bool empty = true;
+
+  for(std::size_t i = 0; i < d->eventCount; ++i)
+  {
+    const LayoutTraceEvent& layoutTraceEvent = d->events.at((d->firstEvent + i) % d->eventCapacity);
+
+    std::size_t& depth = depths.at(layoutTraceEvent.threadId);
+
+    if(layoutTraceEvent.eventType == 'B')
+    {
+      ++depth;
+    }
+    else if(depth > 0)
+    {
+      --depth;
+    }
+    else
+    {
+      // The begin of this phase was overwritten.
+      continue;
+    }
+
+    if(!empty)
+    {
+      json.append(",\n");
+    }
+
+    LayoutTracerPrivate::appendEvent(layoutTraceEvent, &json);
+
+    empty = false;
+  }
+
+  json.append("\n],\"displayTimeUnit\":\"ns\"}\n");
+
+  return json;
+}
+
+bool LayoutTracer::writeTraceJson(const char * fileName) const
+{
+  const std::string json = getTraceJson();
+
+  std::FILE * file = std::fopen(fileName, "w");
+
+  if(!file)
+  {
+    return false;
+  }
+
+  const bool written = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+
+  return std::fclose(file) == 0 && written;
+}
@@ -11,29 +11,162 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <chrono>
 
 #include <vector>
 #include <map>
-#include <memory>
-
-#include "graphics/Size2D.h"
 
 #include "ui/UiComponent.h"
 #include "ui/Label.h"
 
+#include "ui/layout/ILayoutContainer.h"
+#include "ui/layout/IMeasurableText.h"
+#include "ui/layout/IThreadSafeMeasurable.h"
+#include "ui/layout/LayoutTracer.h"
 #include "ui/layout/UiComponentConstraints.h"
+#include "ui/layout/UiComponentEntry.h"
 
+#include "ui/layout/private/LayoutKernels.h"
+#include "ui/layout/private/LayoutResultPrivate.h"
+#include "ui/layout/private/LayoutSnapshotPrivate.h"
 #include "ui/layout/private/UiComponentWrapper.h"
 #include "ui/layout/private/UiComponentInternals.h"
 #include "ui/layout/private/RowLayoutPrivate.h"
 
 #include "ui/layout/RowLayout.h"
 
-static int getVerticalSpaceBetweenRowsToPlatformIfNeeded(int verticalSpace)
+// Reports a phase of a layout pass to the LayoutPhaseObserver and to the
+// LayoutTracer of a layout, if it has them, from construction to destruction.
+class LayoutPhaseScope
+{
+  public:
+
+    LayoutPhaseScope(const RowLayoutPrivate * rowLayoutPrivate,
+                     LayoutPhase::Value layoutPhase)
+    :rowLayoutPrivate(rowLayoutPrivate),
+     layoutPhase(layoutPhase)
+    {
+      if(rowLayoutPrivate->hasLayoutPhaseObserver)
+      {
+        rowLayoutPrivate->layoutPhaseObserver.beginLayoutPhase(layoutPhase, rowLayoutPrivate->layoutPhaseObserver.userData);
+      }
+
+      if(rowLayoutPrivate->layoutTracer)
+      {
+        rowLayoutPrivate->layoutTracer->beginLayoutPhase(layoutPhase,
+                                                         rowLayoutPrivate->rows.size(),
+                                                         rowLayoutPrivate->getUiComponentCount());
+      }
+    }
+
+    ~LayoutPhaseScope()
+    {
+      if(rowLayoutPrivate->hasLayoutPhaseObserver)
+      {
+        rowLayoutPrivate->layoutPhaseObserver.endLayoutPhase(layoutPhase, rowLayoutPrivate->layoutPhaseObserver.userData);
+      }
+
+      if(rowLayoutPrivate->layoutTracer)
+      {
+        rowLayoutPrivate->layoutTracer->endLayoutPhase(layoutPhase,
+                                                       rowLayoutPrivate->rows.size(),
+                                                       rowLayoutPrivate->getUiComponentCount());
+      }
+    }
+
+  private:
+
+    const RowLayoutPrivate * rowLayoutPrivate;
+
+    LayoutPhase::Value layoutPhase;
+};
+
+// Adds the time from construction to destruction to the specified duration of
+// the LayoutStats of a layout, if the layout is recording them.
+class LayoutStatsTimer
+{
+  public:
+
+    LayoutStatsTimer(RowLayoutPrivate * rowLayoutPrivate,
+                     long long LayoutStats::* duration)
+    :duration(rowLayoutPrivate->recordingLayoutStats ? &(rowLayoutPrivate->layoutStats.*duration) : nullptr)
+    {
+      if(this->duration)
+      {
+        startTime = std::chrono::steady_clock::now();
+      }
+    }
+
+    ~LayoutStatsTimer()
+    {
+      if(duration)
+      {
+        *duration += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+      }
+    }
+
+  private:
+
+    long long * duration;
+
+    std::chrono::steady_clock::time_point startTime;
+};
+
+// Records the LayoutStats of a layout pass from construction to destruction,
+// if the layout records them.
+class LayoutStatsScope
+{
+  public:
+
+    explicit LayoutStatsScope(RowLayoutPrivate * rowLayoutPrivate)
+    :rowLayoutPrivate(rowLayoutPrivate),
+     labelMeasurementCacheInsertCount(0)
+    {
+      if(!rowLayoutPrivate->layoutStatsEnabled)
+      {
+        return;
+      }
+
+      rowLayoutPrivate->layoutStats = LayoutStats();
+      rowLayoutPrivate->recordingLayoutStats = true;
+
+      labelMeasurementCacheInsertCount = rowLayoutPrivate->labelMeasurementCache->getInsertCount();
+
+      startTime = std::chrono::steady_clock::now();
+    }
+
+    ~LayoutStatsScope()
+    {
+      if(!rowLayoutPrivate->recordingLayoutStats)
+      {
+        return;
+      }
+
+      LayoutStats& layoutStats = rowLayoutPrivate->layoutStats;
+
+      layoutStats.layoutPassDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+
+      // Every size added to the cache adds an entry.
+      layoutStats.bufferGrowthCount += rowLayoutPrivate->labelMeasurementCache->getInsertCount() - labelMeasurementCacheInsertCount;
+
+      rowLayoutPrivate->recordingLayoutStats = false;
+    }
+
+  private:
+
+    RowLayoutPrivate * rowLayoutPrivate;
+
+    std::size_t labelMeasurementCacheInsertCount;
+
+    std::chrono::steady_clock::time_point startTime;
+};
+
+static int getVerticalSpaceBetweenRowsToPlatformIfNeeded(int verticalSpace,
+                                                         const LayoutMetrics * layoutMetrics)
 {
   if(verticalSpace < 0)
   {
-    return 11; // TODO: Do not hard code this value
+    return layoutMetrics->verticalSpaceBetweenRows;
   }
 
   return verticalSpace;
@@ -80,6 +213,21 @@ struct LabelRow
       labels.push_back(labelPair);
     }
 
+    void removeLabel(UiComponentWrapper * labelPair)
+    {
+      // The order of the labels does not matter, so fill the hole with the
+      // last label instead of shifting every label after it.
+      for(std::size_t i = 0; i < labels.size(); ++i)
+      {
+        if(labels.at(i) == labelPair)
+        {
+          labels.at(i) = labels.back();
+          labels.pop_back();
+          break;
+        }
+      }
+    }
+
     void removeAllLabels()
     {
       for(;!labels.empty();)
@@ -108,7 +256,21 @@ class RowLayout::Row::RowPrivate
      rowLayout(rowLayout),
      rowOrientation(RowOrientation::LeftRowOrientation),
      rowWidth(0),
-     rowHeight(0)
+     rowHeight(0),
+     rowTop(0),
+     growYWeight(0),
+     rowGrowth(0),
+     widestHitBounds(0),
+     rowIndex(rowLayout->d->rows.size()),
+     removedUiComponentCount(0),
+     firstUiComponentId(rowLayout->d->uiComponentInternals.size()),
+     needsLayout(true),
+     needsApply(true),
+     laidOut(false),
+     indexed(false),
+     indexedInEstimate(false),
+     indexedHeight(0),
+     indexedWidth(0)
     {
 
     }
@@ -120,43 +282,164 @@ class RowLayout::Row::RowPrivate
 
     UiComponentWrapper * getUiComponentWrapperAt(std::size_t index)
     {
+      compactUiComponents();
+
       return uiComponents.at(index);
     }
 
     UiComponentConstraints * getUiComponentConstraintsAt(std::size_t index)
     {
+      compactUiComponents();
+
       return uiComponents.at(index)->uiComponentConstraints;
     }
 
+    // Close the holes left by removed uiComponents so that the slots match
+    // the indices used by the public interface again.
+    void compactUiComponents()
+    {
+      if(removedUiComponentCount == 0)
+      {
+        return;
+      }
+
+      std::size_t count = 0;
+
+      for(std::size_t i = 0; i < uiComponents.size(); ++i)
+      {
+        if(uiComponents.at(i))
+        {
+          uiComponents.at(count) = uiComponents.at(i);
+          uiComponents.at(count)->slot = count;
+          ++count;
+        }
+      }
+
+      uiComponents.resize(count);
+
+      removedUiComponentCount = 0;
+    }
+
     void initUiComponentInternals(UiComponentWrapper * uiComponentWrapper)
     {
-      uiComponentWrapper->uiComponentInternals = new UiComponentInternals;
+      RowLayoutPrivate * rowLayoutPrivate = rowLayout->d;
+
+      uiComponentWrapper->id = rowLayoutPrivate->uiComponentInternals.add(uiComponentWrapper->uiComponent,
+                                                                          uiComponentWrapper->labelPeer);
+
+      rowLayoutPrivate->uiComponentInternals.uiComponentMeasurable[uiComponentWrapper->id] = dynamic_cast<IThreadSafeMeasurable *>(uiComponentWrapper->uiComponent);
+
+      if(uiComponentWrapper->labelPeer)
+      {
+        rowLayoutPrivate->uiComponentInternals.labelMeasurable[uiComponentWrapper->id] = dynamic_cast<IThreadSafeMeasurable *>(uiComponentWrapper->labelPeer);
+        rowLayoutPrivate->uiComponentInternals.labelText[uiComponentWrapper->id] = dynamic_cast<IMeasurableText *>(uiComponentWrapper->labelPeer);
+      }
+
+      // The ids of each row stay contiguous and in row order as long as
+      // uiComponents are only appended to the last row.
+      if(rowLayoutPrivate->rows.back() != uiComponentWrapper->row ||
+         (!uiComponents.empty() && uiComponents.back()->id + 1 != uiComponentWrapper->id))
+      {
+        rowLayoutPrivate->uiComponentIdsInRowOrder = false;
+      }
+
+      if(uiComponents.empty())
+      {
+        firstUiComponentId = uiComponentWrapper->id;
+      }
+    }
+
+    // Create the wrapper for the specified uiComponent and its associated
+    // label, if any, and append it to this row. The uiComponent is neither
+    // added to the container nor to its size groups.
+    UiComponentWrapper * createUiComponentWrapper(RowLayout::Row * row,
+                                                  Label * label,
+                                                  UiComponent * uiComponent,
+                                                  const UiComponentConstraints * uiComponentConstraints)
+    {
+      RowLayoutPrivate * rowLayoutPrivate = rowLayout->d;
+
+      // The checks against the last uiComponent below must not see a hole.
+      compactUiComponents();
+
+      UiComponentWrapper * uiComponentWrapper = new (rowLayoutPrivate->uiComponentWrapperPool.allocate()) UiComponentWrapper;
+      uiComponentWrapper->uiComponent = uiComponent;
+      uiComponentWrapper->labelPeer = label;
+      uiComponentWrapper->uiComponentConstraints = new (rowLayoutPrivate->uiComponentConstraintsPool.allocate()) UiComponentConstraints;
+      uiComponentWrapper->id = 0;
+      uiComponentWrapper->row = row;
+      uiComponentWrapper->slot = uiComponents.size();
+      uiComponentWrapper->sizeGroupIndex = 0;
+      uiComponentWrapper->sizeGroupSlot = 0;
+      uiComponentWrapper->labelSizeGroupIndex = 0;
+      uiComponentWrapper->labelSizeGroupSlot = 0;
+
+      ::initUiComponentConstraints(uiComponentWrapper->uiComponentConstraints);
+      initUiComponentInternals(uiComponentWrapper);
+
+      ::copyUiComponentConstraints(uiComponentWrapper->uiComponentConstraints,
+                                   uiComponentConstraints);
+
+      uiComponents.push_back(uiComponentWrapper);
+
+      // Keep the first wrapper if a uiComponent is added more than once.
+      rowLayoutPrivate->uiComponentIndex.insert(std::make_pair(uiComponent, uiComponentWrapper));
+
+      if(label)
+      {
+        rowLayoutPrivate->uiComponentIndex.insert(std::make_pair(label, uiComponentWrapper));
+      }
 
-      uiComponentWrapper->uiComponentInternals->labelPreferredWidth = 0;
-      uiComponentWrapper->uiComponentInternals->labelPreferredHeight = 0;
+      needsLayout = true;
 
-      uiComponentWrapper->uiComponentInternals->uiComponentPreferredWidth = 0;
-      uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight = 0;
+      rowLayoutPrivate->requestLayout(rowLayout);
 
-      uiComponentWrapper->uiComponentInternals->labelX = 0;
-      uiComponentWrapper->uiComponentInternals->labelY = 0;
+      if(uiComponentConstraints->growY > 0)
+      {
+        ++rowLayoutPrivate->growYCount;
+      }
+
+      if(label)
+      {
+        if(uiComponentWrapper->uiComponentConstraints->labelOrientation == LabelOrientation::TopOrientation)
+        {
+          if(previousLabelRow == nullptr)
+          {
+            previousLabelRow = rowLayoutPrivate->createLabelRow();
+          }
+
+          previousLabelRow->addLabel(uiComponentWrapper);
+        }
+        else if(uiComponentWrapper->uiComponentConstraints->labelOrientation == LabelOrientation::BottomOrientation)
+        {
+          if(nextLabelRow == nullptr)
+          {
+            nextLabelRow = rowLayoutPrivate->createLabelRow();
+          }
 
-      uiComponentWrapper->uiComponentInternals->uiComponentX = 0;
-      uiComponentWrapper->uiComponentInternals->uiComponentY = 0;
+          nextLabelRow->addLabel(uiComponentWrapper);
+        }
+      }
 
-      uiComponentWrapper->uiComponentInternals->horizontalGapLeft = -1;
-      uiComponentWrapper->uiComponentInternals->horizontalGapRight = -1;
+      return uiComponentWrapper;
     }
 
     void freeUiComponentWrapper(UiComponentWrapper * uiComponentWrapper)
     {
-      delete uiComponentWrapper->uiComponentConstraints;
+      if(uiComponentWrapper->uiComponentConstraints->growY > 0)
+      {
+        --rowLayout->d->growYCount;
+      }
+
+      rowLayout->d->uiComponentConstraintsPool.deallocate(uiComponentWrapper->uiComponentConstraints);
       uiComponentWrapper->uiComponentConstraints = nullptr;
 
-      delete uiComponentWrapper->uiComponentInternals;
-      uiComponentWrapper->uiComponentInternals = nullptr;
+      rowLayout->d->uiComponentInternals.remove(uiComponentWrapper->id);
 
-      delete uiComponentWrapper;
+      // The ids are compacted before the next layout pass.
+      rowLayout->d->uiComponentIdsInRowOrder = false;
+
+      rowLayout->d->uiComponentWrapperPool.deallocate(uiComponentWrapper);
       uiComponentWrapper = nullptr;
     }
 
@@ -191,10 +474,88 @@ class RowLayout::Row::RowPrivate
     int rowWidth;
 
     int rowHeight;
+
+    /**
+     * The y-offset of this row during the last layout pass.
+     */
+    int rowTop;
+
+    /**
+     * The largest growY of the uiComponents in this row during the last
+     * layout pass.
+     */
+    int growYWeight;
+
+    /**
+     * The height this row grew by during the last layout pass, which is not
+     * part of rowHeight.
+     */
+    int rowGrowth;
+
+    /**
+     * The bounds of the labels and uiComponents in this row as of the last
+     * layout pass, sorted by x-offset. The y-offsets are relative to rowTop.
+     * Used to find the uiComponent at a point.
+     */
+    std::vector<UiComponentBounds> hitBounds;
+
+    /**
+     * The width of the widest entry in hitBounds.
+     */
+    int widestHitBounds;
+
+    /**
+     * The index of this row within RowLayoutPrivate::rows.
+     */
+    std::size_t rowIndex;
+
+    /**
+     * The number of holes in uiComponents left by removed uiComponents. See
+     * compactUiComponents.
+     */
+    std::size_t removedUiComponentCount;
+
+    /**
+     * The id of the first uiComponent in this row. The uiComponents in this
+     * row have the ids [firstUiComponentId, firstUiComponentId +
+     * uiComponents.size()) while RowLayoutPrivate::uiComponentIdsInRowOrder
+     * is true.
+     */
+    std::size_t firstUiComponentId;
+
+    /**
+     * True if the uiComponents in this row must be laid out again during the
+     * next layout pass.
+     */
+    bool needsLayout;
+
+    /**
+     * True if the cached bounds of the uiComponents in this row changed and
+     * must be applied to the uiComponents during the next layout pass.
+     */
+    bool needsApply;
+
+    /**
+     * True if this row was laid out since it was last emptied, so rowWidth
+     * and rowHeight hold its real extent. Only rows that intersect the
+     * viewport are laid out while a viewport is set.
+     */
+    bool laidOut;
+
+    /**
+     * True if the height of this row is known to
+     * RowLayoutPrivate::rowOffsetIndex. indexedHeight and indexedWidth are
+     * the extent this row was indexed with and indexedInEstimate is true if
+     * indexedHeight is part of the estimated row height.
+     */
+    bool indexed;
+    bool indexedInEstimate;
+    int indexedHeight;
+    int indexedWidth;
 };
 
 RowLayout::Row::Row(RowLayout * rowLayout)
-:d(new RowLayout::Row::RowPrivate(rowLayout))
+:d(new (rowLayout->d->rowPrivatePool.allocate()) RowLayout::Row::RowPrivate(rowLayout))
 {
 
 }
@@ -214,46 +575,30 @@ RowOrientation::Value RowLayout::Row::getRowOrientation() const
 //       as "one" UiComponent and share an index.
 std::size_t RowLayout::Row::getUiComponentCount() const
 {
-  return d->uiComponents.size();
+  return d->uiComponents.size() - d->removedUiComponentCount;
 }
 
 UiComponent * RowLayout::Row::getUiComponentAt(std::size_t index)
 {
-  return d->uiComponents.at(index)->uiComponent;
+  return d->getUiComponentWrapperAt(index)->uiComponent;
 }
 
 Label * RowLayout::Row::getLabelAt(std::size_t index)
 {
-  return d->uiComponents.at(index)->labelPeer;
+  return d->getUiComponentWrapperAt(index)->labelPeer;
 }
 
 RowLayout::Row * RowLayout::Row::addUiComponent(UiComponent * uiComponent,
                                                 const UiComponentConstraints * uiComponentConstraints)
 {
-  UiComponentWrapper * uiComponentWrapper = new UiComponentWrapper;
-  uiComponentWrapper->uiComponent = uiComponent;
-  uiComponentWrapper->labelPeer = nullptr;
-  uiComponentWrapper->uiComponentConstraints = new UiComponentConstraints;
-  uiComponentWrapper->uiComponentInternals = nullptr;
-
-  ::initUiComponentConstraints(uiComponentWrapper->uiComponentConstraints);
-  d->initUiComponentInternals(uiComponentWrapper);
-
-  ::copyUiComponentConstraints(uiComponentWrapper->uiComponentConstraints,
-                               uiComponentConstraints);
-
-  d->uiComponents.push_back(uiComponentWrapper);
+  UiComponentWrapper * uiComponentWrapper = d->createUiComponentWrapper(this,
+                                                                        nullptr,
+                                                                        uiComponent,
+                                                                        uiComponentConstraints);
 
   d->rowLayout->d->rowLayoutContainer->addUiComponent(uiComponent);
 
-  // Get the index of the uiComponent and add it to the size group map if and
-  // only if a size group is specified.
-  const int sizeGroupId = uiComponentConstraints->sizeGroupId;
-
-  if(sizeGroupId >= 0)
-  {
-    d->rowLayout->d->sizeGroups[sizeGroupId].push_back(std::pair<SizeGroupIdentifier, UiComponentWrapper *>(UiComponentGroup, uiComponentWrapper));
-  }
+  d->rowLayout->d->addToSizeGroups(uiComponentWrapper);
 
   return this;
 }
@@ -262,62 +607,29 @@ RowLayout::Row * RowLayout::Row::addUiComponent(Label * label,
                                                 UiComponent* uiComponent,
                                                 const UiComponentConstraints * uiComponentConstraints)
 {
-  UiComponentWrapper * uiComponentWrapper = new UiComponentWrapper;
-  uiComponentWrapper->uiComponent = uiComponent;
-  uiComponentWrapper->labelPeer = label;
-  uiComponentWrapper->uiComponentConstraints = new UiComponentConstraints;
-  uiComponentWrapper->uiComponentInternals = nullptr;
-
-  ::initUiComponentConstraints(uiComponentWrapper->uiComponentConstraints);
-  d->initUiComponentInternals(uiComponentWrapper);
-
-  ::copyUiComponentConstraints(uiComponentWrapper->uiComponentConstraints,
-                               uiComponentConstraints);
-
-  d->uiComponents.push_back(uiComponentWrapper);
-
-  if(uiComponentWrapper->uiComponentConstraints->labelOrientation == LabelOrientation::TopOrientation)
-  {
-    if(d->previousLabelRow == nullptr)
-    {
-      d->previousLabelRow = new LabelRow;
-      d->previousLabelRow->maxHeightLabelInRow = 0;
-    }
-
-    d->previousLabelRow->addLabel(uiComponentWrapper);
-  }
-  else if(uiComponentWrapper->uiComponentConstraints->labelOrientation == LabelOrientation::BottomOrientation)
-  {
-    if(d->nextLabelRow == nullptr)
-    {
-      d->nextLabelRow = new LabelRow;
-      d->nextLabelRow->maxHeightLabelInRow = 0;
-    }
-
-    d->nextLabelRow->addLabel(uiComponentWrapper);
-  }
+  UiComponentWrapper * uiComponentWrapper = d->createUiComponentWrapper(this,
+                                                                        label,
+                                                                        uiComponent,
+                                                                        uiComponentConstraints);
 
   d->rowLayout->d->rowLayoutContainer->addUiComponent(label);
   d->rowLayout->d->rowLayoutContainer->addUiComponent(uiComponent);
 
-  // Get the index of the uiComponent and add it to the size group map if and
-  // only if a size group is specified.
+  d->rowLayout->d->addToSizeGroups(uiComponentWrapper);
 
-  const int sizeGroupId = uiComponentConstraints->sizeGroupId;
+  return this;
+}
 
-  const int labelSizeGroupId = uiComponentConstraints->labelSizeGroupId;
+RowLayout::Row * RowLayout::Row::addUiComponents(const UiComponentEntry * uiComponentEntries,
+                                                 std::size_t count)
+{
+  // Each entry adds a uiComponent and possibly a label to the container.
+  std::vector<UiComponent *> children;
+  children.reserve(count * 2);
 
-  if(sizeGroupId >= 0)
-  {
-    d->rowLayout->d->sizeGroups[sizeGroupId].push_back(std::pair<SizeGroupIdentifier,
-                                                       UiComponentWrapper *>(UiComponentGroup, uiComponentWrapper));
-  }
+  d->rowLayout->d->addUiComponentsToRow(this, uiComponentEntries, count, &children);
 
-  if(labelSizeGroupId >= 0)
-  {
-    d->rowLayout->d->sizeGroups[labelSizeGroupId].push_back(std::pair<SizeGroupIdentifier,
-                                                            UiComponentWrapper *>(LabelGroup, uiComponentWrapper));
-  }
+  d->rowLayout->d->attachUiComponents(children);
 
   return this;
 }
@@ -326,878 +638,3412 @@ void RowLayout::Row::setHorizontalSpaceBetweenUiComponents(std::size_t horizonta
 {
   // Now that the row exists, set the horizontal space
   d->horizontalSpaceBetweenUiComponents = horizontalSpace;
+
+  d->needsLayout = true;
+
+  d->rowLayout->d->requestLayout(d->rowLayout);
 }
 
 void RowLayout::Row::setRowOrientation(RowOrientation::Value rowOrientation)
 {
   d->rowOrientation = rowOrientation;
+
+  d->needsLayout = true;
+
+  d->rowLayout->d->requestLayout(d->rowLayout);
 }
 
 void RowLayout::Row::removeAllUiComponents()
 {
-  for(;!d->uiComponents.empty();)
+  for(std::size_t i = 0; i < d->uiComponents.size(); ++i)
   {
     // Don't delete the UiComponent since you don't own the memory, however
     // you must delete the UiComponent wrapper and the
     // UiComponentConstraints
 
-    UiComponentWrapper * uiComponentWrapper = d->uiComponents.back();
+    UiComponentWrapper * uiComponentWrapper = d->uiComponents.at(i);
 
-    d->freeUiComponentWrapper(uiComponentWrapper);
-
-    d->uiComponents.pop_back();
+    if(uiComponentWrapper)
+    {
+      d->rowLayout->d->removeUiComponentWrapper(uiComponentWrapper);
+    }
   }
+
+  d->uiComponents.clear();
+  d->removedUiComponentCount = 0;
+
+  d->needsLayout = true;
 }
 
 void RowLayout::Row::removeUiComponentAt(std::size_t index)
 {
-  UiComponentWrapper * uiComponentWrapper = d->uiComponents.at(index);
+  d->rowLayout->d->removeUiComponentWrapper(d->getUiComponentWrapperAt(index));
+}
+
+void RowLayout::Row::invalidate()
+{
+  for(std::size_t i = 0; i < d->uiComponents.size(); ++i)
+  {
+    // Skip the holes left by removed uiComponents.
+    if(d->uiComponents.at(i))
+    {
+      d->rowLayout->d->uiComponentInternals.needsMeasure[d->uiComponents.at(i)->id] = true;
+    }
+  }
 
-  d->uiComponents.erase(d->uiComponents.begin() + index);
+  d->needsLayout = true;
 
-  d->freeUiComponentWrapper(uiComponentWrapper);
+  d->rowLayout->d->requestLayout(d->rowLayout);
 }
 
-RowLayoutPrivate::RowLayoutPrivate(UiComponent * rowLayoutContainer)
-:rowLayoutContainer(rowLayoutContainer),
- currentRow(nullptr),
- verticalSpaceBetweenRows(-1)
+void RowLayout::Row::invalidateUiComponentAt(std::size_t index)
 {
+  d->rowLayout->d->uiComponentInternals.needsMeasure[d->getUiComponentWrapperAt(index)->id] = true;
+
+  d->needsLayout = true;
 
+  d->rowLayout->d->requestLayout(d->rowLayout);
 }
 
-RowLayoutPrivate::~RowLayoutPrivate()
+RowLayoutPrivate::RowLayoutPrivate(UiComponent * rowLayoutContainer,
+                                   const LayoutAllocator * layoutAllocator)
+:hasLayoutAllocator(layoutAllocator != nullptr),
+ rowLayoutContainer(rowLayoutContainer),
+ hasLayoutScheduler(false),
+ hasLayoutPhaseObserver(false),
+ layoutTracer(nullptr),
+ layoutStatsEnabled(false),
+ recordingLayoutStats(false),
+ layoutStats(),
+ layoutPending(false),
+ layoutRevision(0),
+ layoutMetrics(&LayoutMetrics::getLayoutMetrics(LayoutMetrics::DefaultDpi)),
+ labelMeasurementCache(&labelMeasurementCaches[LayoutMetrics::DefaultDpi]),
+ labelMeasurementCacheCapacity(LabelMeasurementCache::DefaultCapacity),
+ currentRow(nullptr),
+ uiComponentIdsInRowOrder(true),
+ verticalSpaceBetweenRows(-1),
+ verticalSpaceBetweenRowsChanged(false),
+ skippedBoundsCallCount(0),
+ growYCount(0),
+ grewVertically(false),
+ hasViewport(false),
+ viewportY(0),
+ viewportHeight(0),
+ estimatedRowHeight(0),
+ rowOffsetOrigin(0),
+ indexedEstimatedRowHeight(0),
+ indexedRowHeightSum(0),
+ indexedRowHeightCount(0),
+ lastContainer(nullptr),
+ lastContainerClientWidth(0),
+ lastContainerClientHeight(0)
 {
-  for(;!rows.empty();)
+  if(hasLayoutAllocator)
   {
-    RowLayout::Row * row = rows.back();
-
-    row->removeAllUiComponents();
+    this->layoutAllocator = *layoutAllocator;
 
-    delete row->d->previousLabelRow;
-    row->d->previousLabelRow = nullptr;
+    rowPool.setLayoutAllocator(&this->layoutAllocator);
+    rowPrivatePool.setLayoutAllocator(&this->layoutAllocator);
+    labelRowPool.setLayoutAllocator(&this->layoutAllocator);
+    uiComponentWrapperPool.setLayoutAllocator(&this->layoutAllocator);
+    uiComponentConstraintsPool.setLayoutAllocator(&this->layoutAllocator);
+  }
 
-    delete row->d->nextLabelRow;
-    row->d->nextLabelRow = nullptr;
+  lastContainerPadding.leftPadding = 0;
+  lastContainerPadding.rightPadding = 0;
+  lastContainerPadding.topPadding = 0;
+  lastContainerPadding.bottomPadding = 0;
+}
 
-    delete row;
-    row = nullptr;
+RowLayoutPrivate::~RowLayoutPrivate()
+{
+  for(;!rows.empty();)
+  {
+    // The wrappers and constraints of each row are released in bulk when the
+    // pools are destroyed.
+    destroyRow(rows.back());
 
     rows.pop_back();
   }
 }
 
-std::auto_ptr<Size2D> RowLayoutPrivate::getMaxUiComponentSize(const std::vector<std::pair<SizeGroupIdentifier, UiComponentWrapper *> >& uiComponentWrappers)
+RowLayout::Row * RowLayoutPrivate::createRow(RowLayout * thisRowLayout)
 {
-  std::auto_ptr<Size2D> maxSize(new Size2D(0, 0));
+  return new (rowPool.allocate()) RowLayout::Row(thisRowLayout);
+}
 
-  for(std::size_t i = 0; i < uiComponentWrappers.size(); ++i)
-  {
-    UiComponentWrapper * uiComponentWrapper = uiComponentWrappers.at(i).second;
+void RowLayoutPrivate::destroyRow(RowLayout::Row * row)
+{
+  destroyLabelRow(row->d->previousLabelRow);
+  row->d->previousLabelRow = nullptr;
 
-    if(uiComponentWrappers.at(i).first == LabelGroup)
-    {
-      maxSize->setSize(std::max(uiComponentWrapper->uiComponentInternals->labelPreferredWidth,
-                                maxSize->getWidth()),
-                       std::max(uiComponentWrapper->uiComponentInternals->labelPreferredHeight,
-                                maxSize->getHeight()));
-    }
-    else
-    {
-      maxSize->setSize(std::max(uiComponentWrapper->uiComponentInternals->uiComponentPreferredWidth,
-                                maxSize->getWidth()),
-                       std::max(uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight,
-                                maxSize->getHeight()));
-    }
-  }
+  destroyLabelRow(row->d->nextLabelRow);
+  row->d->nextLabelRow = nullptr;
+
+  row->d->~RowPrivate();
+  rowPrivatePool.deallocate(row->d);
 
-  return maxSize;
-} // end RowLayoutPrivate::getMaxUiComponentSize
+  row->~Row();
+  rowPool.deallocate(row);
+}
 
-void RowLayoutPrivate::resizeUiComponentsInSizeGroup(const std::vector<std::pair<SizeGroupIdentifier, UiComponentWrapper *> >& uiComponentWrappers,
-                                                     std::auto_ptr<Size2D> maxSize)
+LabelRow * RowLayoutPrivate::createLabelRow()
 {
-  for(std::size_t i = 0; i < uiComponentWrappers.size(); ++i)
-  {
-    UiComponentWrapper * uiComponentWrapper = uiComponentWrappers.at(i).second;
+  LabelRow * labelRow = new (labelRowPool.allocate()) LabelRow;
+  labelRow->maxHeightLabelInRow = 0;
 
-    if(uiComponentWrappers.at(i).first == LabelGroup)
-    {
-      uiComponentWrapper->uiComponentInternals->labelPreferredWidth = maxSize->getWidth();
-      uiComponentWrapper->uiComponentInternals->labelPreferredHeight = maxSize->getHeight();
-    }
-    else
-    {
-      uiComponentWrapper->uiComponentInternals->uiComponentPreferredWidth = maxSize->getWidth();
-      uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight = maxSize->getHeight();
-    }
+  return labelRow;
+}
+
+void RowLayoutPrivate::destroyLabelRow(LabelRow * labelRow)
+{
+  if(labelRow)
+  {
+    labelRow->~LabelRow();
+    labelRowPool.deallocate(labelRow);
   }
-} // end RowLayoutPrivate::resizeUiComponentsInSizeGroup
+}
 
-void RowLayoutPrivate::resizeUiComponentsInSizeGroups()
+void RowLayoutPrivate::requestLayout(RowLayout * thisRowLayout)
 {
-  std::map<int, std::vector<std::pair<SizeGroupIdentifier, UiComponentWrapper *> > >::iterator it = sizeGroups.begin();
+  ++layoutRevision;
 
-  for(; it != sizeGroups.end(); ++it)
+  // Only the first change after a layout pass schedules a layout pass, the
+  // pending layout pass handles every later change too.
+  if(layoutPending)
   {
-    // Get the max size for all of the UiComponents within this size group
-    // container
-    std::auto_ptr<Size2D> maxSize(getMaxUiComponentSize(it->second));
+    return;
+  }
 
-    // Resize all of the UiComponents within this size group container
-    resizeUiComponentsInSizeGroup(it->second, maxSize);
+  layoutPending = true;
+
+  if(hasLayoutScheduler)
+  {
+    layoutScheduler.scheduleLayout(thisRowLayout, layoutScheduler.userData);
   }
-} //end RowLayoutPrivate::resizeUiComponentsInSizeGroups
+}
 
-void RowLayoutPrivate::resizePreviousAndNextLabelRows(RowLayout * thisRowLayout)
+void RowLayoutPrivate::addToSizeGroups(UiComponentWrapper * uiComponentWrapper)
 {
-  for(std::size_t rowIndex = 0; rowIndex < thisRowLayout->getRowCount(); ++rowIndex)
-  {
-    if(rows.at(rowIndex)->d->previousLabelRow) // TODO: Do not use the rows variable directly, access it with a function.
-    {
-      LabelRow * prev = rows.at(rowIndex)->d->previousLabelRow;
+  // Get the index of the uiComponent and add it to the size group map if and
+  // only if a size group is specified.
 
-      for(std::size_t i = 0; i < prev->getLabelCount(); ++i)
-      {
-        prev->maxHeightLabelInRow = std::max(prev->maxHeightLabelInRow,
-                                             prev->getWrapperForLabelAt(i)->uiComponentInternals->labelPreferredHeight);
-      }
-    }
+  const int sizeGroupId = uiComponentWrapper->uiComponentConstraints->sizeGroupId;
 
-    if(rows.at(rowIndex)->d->nextLabelRow) // TODO: Do not use the rows variable directly, access it with a function.
-    {
-      LabelRow * next = rows.at(rowIndex)->d->nextLabelRow;
+  const int labelSizeGroupId = uiComponentWrapper->uiComponentConstraints->labelSizeGroupId;
 
-      for(std::size_t i = 0; i < next->getLabelCount(); ++i)
-      {
-        next->maxHeightLabelInRow = std::max(next->maxHeightLabelInRow,
-                                             next->getWrapperForLabelAt(i)->uiComponentInternals->labelPreferredHeight);
-      }
-    }
-  } // end for loop
-} // end RowLayoutPrivate::resizePreviousAndNextLabelRows
+  if(sizeGroupId >= 0)
+  {
+    uiComponentWrapper->sizeGroupIndex = getSizeGroupIndex(sizeGroupId);
+    uiComponentWrapper->sizeGroupSlot = sizeGroups.at(uiComponentWrapper->sizeGroupIndex).add(UiComponentGroup,
+                                                                                              uiComponentWrapper);
+  }
 
-// This stage is only concerned with grabbing the preferred sizes and
-// setting those sizes to the actual size.
-//
-// We also specify any gaps if gaps have not been specified. However we do
-// not apply gaps, that is done in the post layout stage.
-//
-// We make no adjustments to the location of any uiComponent.
-//
-// We make no adjustments to the container during this stage.
-void RowLayoutPrivate::preLayout(RowLayout * thisRowLayout)
+  // Only a uiComponent with a label can be part of a label size group.
+  if(uiComponentWrapper->labelPeer && labelSizeGroupId >= 0)
+  {
+    uiComponentWrapper->labelSizeGroupIndex = getSizeGroupIndex(labelSizeGroupId);
+    uiComponentWrapper->labelSizeGroupSlot = sizeGroups.at(uiComponentWrapper->labelSizeGroupIndex).add(LabelGroup,
+                                                                                                        uiComponentWrapper);
+  }
+}
+
+std::size_t RowLayoutPrivate::getSizeGroupIndex(int sizeGroupId)
 {
-  for(std::size_t rowIndex = 0; rowIndex < thisRowLayout->getRowCount(); ++rowIndex)
+  std::map<int, std::size_t>::iterator it = sizeGroupIndices.find(sizeGroupId);
+
+  if(it != sizeGroupIndices.end())
   {
-    std::size_t componentIndex = 0;
+    return it->second;
+  }
 
-    // Start Fencepost block, because the post fencepost loop will add in
-    // the uiComponent gaps if any.
-    if(thisRowLayout->getUiComponentCountAtRow(rowIndex) > 0) // there is at least one uiComponent in this row
-    {
-      RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
-      UiComponentWrapper * uiComponentWrapper = rowLayoutRow->d->getUiComponentWrapperAt(componentIndex);
+  sizeGroups.push_back(SizeGroup());
+  sizeGroupIndices[sizeGroupId] = sizeGroups.size() - 1;
 
-      if(uiComponentWrapper->labelPeer)
-      {
-        // this is a label/uiComponent pair
+  return sizeGroups.size() - 1;
+}
 
-        // Since the uiComponents were added to this layout manager, the
-        // width and height are under the control of the layout manager. So
-        // the width and height must be set accordingly.
+void RowLayoutPrivate::markSizeGroupChanged(std::size_t sizeGroupIndex)
+{
+  SizeGroup& sizeGroup = sizeGroups.at(sizeGroupIndex);
 
-        uiComponentWrapper->uiComponentInternals->labelPreferredWidth = uiComponentWrapper->labelPeer->getPreferredWidth();
-        uiComponentWrapper->uiComponentInternals->labelPreferredHeight = uiComponentWrapper->labelPeer->getPreferredHeight();
-      }
+  if(!sizeGroup.changed)
+  {
+    sizeGroup.changed = true;
 
-      // Now configure the uiComponent
+    countBufferGrowth(changedSizeGroups.size() + 1, changedSizeGroups.capacity());
 
-      // Since the uiComponents were added to this layout manager, the width
-      // and height are under the control of the layout manager. So the
-      // width and height must be set accordingly.
+    changedSizeGroups.push_back(sizeGroupIndex);
+  }
+}
 
-      uiComponentWrapper->uiComponentInternals->uiComponentPreferredWidth = uiComponentWrapper->uiComponent->getPreferredWidth();
-      uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight = uiComponentWrapper->uiComponent->getPreferredHeight();
-    }
-    // End Fencepost block
+void RowLayoutPrivate::updateSizeGroups(UiComponentWrapper * uiComponentWrapper)
+{
+  const std::size_t id = uiComponentWrapper->id;
+  const UiComponentConstraints * constraints = uiComponentWrapper->uiComponentConstraints;
 
-    ++componentIndex;
+  if(constraints->sizeGroupId >= 0 &&
+     sizeGroups.at(uiComponentWrapper->sizeGroupIndex).update(uiComponentWrapper->sizeGroupSlot,
+                                                              uiComponentInternals.uiComponentMeasuredWidth[id],
+                                                              uiComponentInternals.uiComponentMeasuredHeight[id]))
+  {
+    markSizeGroupChanged(uiComponentWrapper->sizeGroupIndex);
+  }
 
-    // Check for all of the uiComponents in the current row.
-    for(; componentIndex < thisRowLayout->getUiComponentCountAtRow(rowIndex); ++componentIndex)
-    {
-      RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
-      UiComponentWrapper * uiComponentWrapper = rowLayoutRow->d->getUiComponentWrapperAt(componentIndex);
+  if(uiComponentWrapper->labelPeer && constraints->labelSizeGroupId >= 0 &&
+     sizeGroups.at(uiComponentWrapper->labelSizeGroupIndex).update(uiComponentWrapper->labelSizeGroupSlot,
+                                                                   uiComponentInternals.labelMeasuredWidth[id],
+                                                                   uiComponentInternals.labelMeasuredHeight[id]))
+  {
+    markSizeGroupChanged(uiComponentWrapper->labelSizeGroupIndex);
+  }
+}
 
-      if(uiComponentWrapper->labelPeer)
-      {
-        // this is a label/uiComponent pair
+void RowLayoutPrivate::removeUiComponentWrapper(UiComponentWrapper * uiComponentWrapper)
+{
+  RowLayout::Row * row = uiComponentWrapper->row;
 
-        // Since the uiComponents were added to this layout manager, the
-        // width and height are under the control of the layout manager. So
-        // the width and height must be set accordingly.
+  // Do not forget to remove the uiComponent from the size groups if they are
+  // specified.
+  const UiComponentConstraints * constraints = uiComponentWrapper->uiComponentConstraints;
 
-        uiComponentWrapper->uiComponentInternals->labelPreferredWidth = uiComponentWrapper->labelPeer->getPreferredWidth();
-        uiComponentWrapper->uiComponentInternals->labelPreferredHeight = uiComponentWrapper->labelPeer->getPreferredHeight();
-      }
+  if(constraints->sizeGroupId >= 0)
+  {
+    sizeGroups.at(uiComponentWrapper->sizeGroupIndex).remove(uiComponentWrapper->sizeGroupSlot);
+
+    markSizeGroupChanged(uiComponentWrapper->sizeGroupIndex);
+  }
 
-      // Now configure the uiComponent
+  if(uiComponentWrapper->labelPeer && constraints->labelSizeGroupId >= 0)
+  {
+    sizeGroups.at(uiComponentWrapper->labelSizeGroupIndex).remove(uiComponentWrapper->labelSizeGroupSlot);
 
-      // Since the uiComponents were added to this layout manager, the width
-      // and height are under the control of the layout manager. So the
-      // width and height must be set accordingly.
+    markSizeGroupChanged(uiComponentWrapper->labelSizeGroupIndex);
+  }
 
-      uiComponentWrapper->uiComponentInternals->uiComponentPreferredWidth = uiComponentWrapper->uiComponent->getPreferredWidth();
-      uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight = uiComponentWrapper->uiComponent->getPreferredHeight();
+  if(uiComponentWrapper->labelPeer)
+  {
+    if(constraints->labelOrientation == LabelOrientation::TopOrientation)
+    {
+      row->d->previousLabelRow->removeLabel(uiComponentWrapper);
+    }
+    else if(constraints->labelOrientation == LabelOrientation::BottomOrientation)
+    {
+      row->d->nextLabelRow->removeLabel(uiComponentWrapper);
+    }
+  }
 
-      // Set the gap if a gap has not already been specified. Note since
-      // a gap by definition is the space between two uiComponents, you will
-      // need to get the gap between the previous uiComponent and the
-      // current uiComponent, setting only the right gap of the previous
-      // uiComponent and the left gap of the current uiComponent.
-      UiComponentWrapper * previousUiComponent = rowLayoutRow->d->getUiComponentWrapperAt(componentIndex - 1);
-      UiComponentWrapper * currentUiComponent = rowLayoutRow->d->getUiComponentWrapperAt(componentIndex);
+  // Only forget the uiComponent and the label if they map to this wrapper,
+  // they may have been added more than once.
+  std::unordered_map<const UiComponent *, UiComponentWrapper *>::iterator it = uiComponentIndex.find(uiComponentWrapper->uiComponent);
 
-      if(previousUiComponent->uiComponentConstraints->horizontalGapRight < 0)
-      {
-        // the client did not specify the gap, so we will need to specify
-        // a gap
+  if(it != uiComponentIndex.end() && it->second == uiComponentWrapper)
+  {
+    uiComponentIndex.erase(it);
+  }
 
-        // Leave the user constraint unspecified, only change the internal
-        // constraint because the user left the constraint unspecified.
-        previousUiComponent->uiComponentInternals->horizontalGapRight = 7; // TODO: Do not hard code, also you need to factor in related/unrelated
-      }
+  if(uiComponentWrapper->labelPeer)
+  {
+    it = uiComponentIndex.find(uiComponentWrapper->labelPeer);
 
-      if(currentUiComponent->uiComponentConstraints->horizontalGapLeft < 0)
-      {
-        // the client did not specify the gap, so we will need to specify
-        // a gap
+    if(it != uiComponentIndex.end() && it->second == uiComponentWrapper)
+    {
+      uiComponentIndex.erase(it);
+    }
+  }
 
-        // Leave the user constraint unspecified, only change the internal
-        // constraint because the user left the constraint unspecified.
-        currentUiComponent->uiComponentInternals->horizontalGapLeft = 7; // TODO: Do not hard code, also you need to factor in related/unrelated
-      }
+  // Leave a hole instead of shifting every later uiComponent in the row. The
+  // holes are closed the next time the row is accessed by index.
+  row->d->uiComponents.at(uiComponentWrapper->slot) = nullptr;
+  ++row->d->removedUiComponentCount;
 
-    }// end current row loop
+  row->d->freeUiComponentWrapper(uiComponentWrapper);
 
-    // Now that we have the sizes set for all uiComponents within this row
-    // check to see if there are any labels in the previous or next rows
-    // so that we can calculate the maximum height of those rows if they
-    // exist.
-    resizePreviousAndNextLabelRows(thisRowLayout);
+  row->d->needsLayout = true;
 
-  }// end all rows loop
-} // end RowLayoutPrivate::preLayout
+  requestLayout(row->d->rowLayout);
+} // end RowLayoutPrivate::removeUiComponentWrapper
 
-int RowLayoutPrivate::getUiComponentGap(std::size_t rowIndex,
-                                        std::size_t previousUiComponentIndex,
-                                        std::size_t currentUiComponentIndex)
+UiComponentWrapper * RowLayoutPrivate::findUiComponentWrapper(const UiComponent * uiComponent) const
 {
-  RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
-  UiComponentWrapper * previousUiComponent = rowLayoutRow->d->getUiComponentWrapperAt(previousUiComponentIndex);
-  UiComponentWrapper * currentUiComponent = rowLayoutRow->d->getUiComponentWrapperAt(currentUiComponentIndex);
+  std::unordered_map<const UiComponent *, UiComponentWrapper *>::const_iterator it = uiComponentIndex.find(uiComponent);
 
-  if(previousUiComponent->uiComponentConstraints->horizontalGapRight > 0)
+  if(it == uiComponentIndex.end())
   {
-    // the client specified a gap for the previous uiComponent
+    return nullptr;
+  }
 
-    if(currentUiComponent->uiComponentConstraints->horizontalGapLeft > 0)
-    {
-      // the client specified a gap for the current uiComponent
+  return it->second;
+}
 
-      // the gap
-      return std::max(previousUiComponent->uiComponentConstraints->horizontalGapRight,
-                      currentUiComponent->uiComponentConstraints->horizontalGapLeft);
-    }
-    else
-    {
-      // the client did not specify a gap for the current uiComponent
+void RowLayoutPrivate::addUiComponentsToRow(RowLayout::Row * row,
+                                            const UiComponentEntry * uiComponentEntries,
+                                            std::size_t count,
+                                            std::vector<UiComponent *> * children)
+{
+  row->d->uiComponents.reserve(row->d->uiComponents.size() + count);
+  uiComponentInternals.reserve(uiComponentInternals.size() + count);
 
-      // the gap
-      return std::max(previousUiComponent->uiComponentConstraints->horizontalGapRight,
-                      currentUiComponent->uiComponentInternals->horizontalGapLeft);
-    }
-  }
-  else
+  for(std::size_t i = 0; i < count; ++i)
   {
-    // the client did not specify a gap for the previous uiComponent
+    const UiComponentEntry& uiComponentEntry = uiComponentEntries[i];
 
-    if(currentUiComponent->uiComponentConstraints->horizontalGapLeft > 0)
-    {
-      // the client specified a gap for the current uiComponent
+    UiComponentWrapper * uiComponentWrapper = row->d->createUiComponentWrapper(row,
+                                                                               uiComponentEntry.label,
+                                                                               uiComponentEntry.uiComponent,
+                                                                               uiComponentEntry.uiComponentConstraints);
 
-      // the gap
-      return std::max(previousUiComponent->uiComponentInternals->horizontalGapRight,
-                      currentUiComponent->uiComponentConstraints->horizontalGapLeft);
-    }
-    else
-    {
-      // the client did not specify a gap for the current uiComponent
+    addToSizeGroups(uiComponentWrapper);
 
-      // the gap
-      return std::max(previousUiComponent->uiComponentInternals->horizontalGapRight,
-                      currentUiComponent->uiComponentInternals->horizontalGapLeft);
+    if(uiComponentEntry.label)
+    {
+      children->push_back(uiComponentEntry.label);
     }
+
+    children->push_back(uiComponentEntry.uiComponent);
   }
-} // end RowLayoutPrivate::getUiComponentGap
+}
 
-void RowLayoutPrivate::applyCenterRowAlignment(RowLayout * thisRowLayout,
-                                               std::size_t rowIndex,
-                                               int containerWidth,
-                                               int containerLeftPadding,
-                                               int containerRightPadding)
+void RowLayoutPrivate::attachUiComponents(const std::vector<UiComponent *>& uiComponents)
 {
-  int remainingFreeSpace = containerWidth - rows.at(rowIndex)->d->rowWidth - containerLeftPadding - containerRightPadding;
+  if(uiComponents.empty())
+  {
+    return;
+  }
 
-  remainingFreeSpace  = remainingFreeSpace / 2;
+  ILayoutContainer * layoutContainer = dynamic_cast<ILayoutContainer *>(rowLayoutContainer);
 
-  if(remainingFreeSpace > 0)
+  if(layoutContainer)
   {
-    for(std::size_t uiComponentIndex = 0; uiComponentIndex < thisRowLayout->getUiComponentCountAtRow(rowIndex); ++uiComponentIndex)
+    layoutContainer->addUiComponents(&uiComponents.at(0), uiComponents.size());
+  }
+  else
+  {
+    for(std::size_t i = 0; i < uiComponents.size(); ++i)
     {
-      UiComponentWrapper * uiComponentWrapper = rows.at(rowIndex)->d->getUiComponentWrapperAt(uiComponentIndex);
-
-      if(uiComponentWrapper->labelPeer)
-      {
-        uiComponentWrapper->uiComponentInternals->labelX = uiComponentWrapper->uiComponentInternals->labelX + remainingFreeSpace;
-      }
-
-      uiComponentWrapper->uiComponentInternals->uiComponentX = uiComponentWrapper->uiComponentInternals->uiComponentX + remainingFreeSpace;
+      rowLayoutContainer->addUiComponent(uiComponents.at(i));
     }
   }
-} // end RowLayoutPrivate::applyCenterRowAlignment
+}
 
-void RowLayoutPrivate::applyRightRowAlignment(RowLayout * thisRowLayout,
-                                              std::size_t rowIndex,
-                                              int containerWidth,
-                                              int containerLeftPadding,
-                                              int containerRightPadding)
+void RowLayoutPrivate::markRowsOfChangedSizeGroups()
 {
-  int remainingFreeSpace = containerWidth - rows.at(rowIndex)->d->rowWidth - containerLeftPadding - containerRightPadding;
+  LayoutStatsTimer layoutStatsTimer(this, &LayoutStats::sizeGroupDuration);
 
-  if(remainingFreeSpace > 0)
+  // Only the size groups whose members changed can have a new max size.
+  for(std::size_t i = 0; i < changedSizeGroups.size(); ++i)
   {
-    for(std::size_t uiComponentIndex = 0; uiComponentIndex < thisRowLayout->getUiComponentCountAtRow(rowIndex); ++uiComponentIndex)
-    {
-      UiComponentWrapper * uiComponentWrapper = rows.at(rowIndex)->d->getUiComponentWrapperAt(uiComponentIndex);
+    SizeGroup& sizeGroup = sizeGroups.at(changedSizeGroups.at(i));
 
-      if(uiComponentWrapper->labelPeer)
+    sizeGroup.changed = false;
+
+    if(sizeGroup.lastMaxWidth != sizeGroup.getMaxWidth() ||
+       sizeGroup.lastMaxHeight != sizeGroup.getMaxHeight())
+    {
+      // The size of the group changed so every row with a member of this
+      // group must be laid out again.
+      for(std::size_t slot = 0; slot < sizeGroup.getMemberCount(); ++slot)
       {
-        uiComponentWrapper->uiComponentInternals->labelX = uiComponentWrapper->uiComponentInternals->labelX + remainingFreeSpace;
+        markRowForLayout(sizeGroup.getUiComponentWrapperAt(slot)->row);
       }
 
-      uiComponentWrapper->uiComponentInternals->uiComponentX = uiComponentWrapper->uiComponentInternals->uiComponentX + remainingFreeSpace;
+      sizeGroup.lastMaxWidth = sizeGroup.getMaxWidth();
+      sizeGroup.lastMaxHeight = sizeGroup.getMaxHeight();
     }
   }
-} // end RowLayoutPrivate::applyRightRowAlignment
 
-void RowLayoutPrivate::handleVerticalAlignment(UiComponentWrapper * uiComponentWrapper,
-                                               int * yLabelVAlignmentOffset,
-                                               int * yUiComponentPeerVAlignmentOffset)
+  changedSizeGroups.clear();
+} // end RowLayoutPrivate::markRowsOfChangedSizeGroups
+
+void RowLayoutPrivate::resizeUiComponentsInRowToSizeGroups(RowLayout::Row * row)
 {
-  if(uiComponentWrapper->uiComponentConstraints->labelVerticalAlignment == LabelVerticalAlignment::MiddleAlignment)
+  LayoutStatsTimer layoutStatsTimer(this, &LayoutStats::sizeGroupDuration);
+
+  for(std::size_t uiComponentIndex = 0; uiComponentIndex < row->getUiComponentCount(); ++uiComponentIndex)
   {
-    if(uiComponentWrapper->uiComponentInternals->labelPreferredHeight < uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight)
+    UiComponentWrapper * uiComponentWrapper = row->d->getUiComponentWrapperAt(uiComponentIndex);
+    const UiComponentConstraints * constraints = uiComponentWrapper->uiComponentConstraints;
+    const std::size_t id = uiComponentWrapper->id;
+
+    if(constraints->sizeGroupId >= 0)
     {
-      *yLabelVAlignmentOffset = (uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight - uiComponentWrapper->uiComponentInternals->labelPreferredHeight) / 2;
+      const SizeGroup& sizeGroup = sizeGroups.at(uiComponentWrapper->sizeGroupIndex);
+
+      uiComponentInternals.uiComponentPreferredWidth[id] = sizeGroup.lastMaxWidth;
+      uiComponentInternals.uiComponentPreferredHeight[id] = sizeGroup.lastMaxHeight;
     }
-    else if(uiComponentWrapper->uiComponentInternals->labelPreferredHeight > uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight)
+
+    if(uiComponentWrapper->labelPeer && constraints->labelSizeGroupId >= 0)
     {
-      *yUiComponentPeerVAlignmentOffset = (uiComponentWrapper->uiComponentInternals->labelPreferredHeight - uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight) / 2;
+      const SizeGroup& sizeGroup = sizeGroups.at(uiComponentWrapper->labelSizeGroupIndex);
+
+      uiComponentInternals.labelPreferredWidth[id] = sizeGroup.lastMaxWidth;
+      uiComponentInternals.labelPreferredHeight[id] = sizeGroup.lastMaxHeight;
     }
   }
-  else if(uiComponentWrapper->uiComponentConstraints->labelVerticalAlignment == LabelVerticalAlignment::BottomAlignment)
+} // end RowLayoutPrivate::resizeUiComponentsInRowToSizeGroups
+
+void RowLayoutPrivate::resizeUiComponentsInSizeGroups()
+{
+  LayoutPhaseScope layoutPhaseScope(this, LayoutPhase::SizeGroupPhase);
+
+  markRowsOfChangedSizeGroups();
+
+  // Marking a row for layout resets its sizes, so only resize once every
+  // size group has had a chance to mark its rows. Rows that are not laid out
+  // again keep the sizes from the last layout pass.
+  for(std::size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
   {
-    if(uiComponentWrapper->uiComponentInternals->labelPreferredHeight < uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight)
-    {
-      *yLabelVAlignmentOffset = (uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight - uiComponentWrapper->uiComponentInternals->labelPreferredHeight);
-    }
-    else if(uiComponentWrapper->uiComponentInternals->labelPreferredHeight > uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight)
+    if(rows.at(rowIndex)->d->needsLayout)
     {
-      *yUiComponentPeerVAlignmentOffset = (uiComponentWrapper->uiComponentInternals->labelPreferredHeight - uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight);
+      resizeUiComponentsInRowToSizeGroups(rows.at(rowIndex));
     }
   }
-} // end RowLayoutPrivate::handleVerticalAlignment
+} //end RowLayoutPrivate::resizeUiComponentsInSizeGroups
 
-void RowLayoutPrivate::layoutUiComponentInRow(RowLayout * thisRowLayout,
-                                              std::size_t rowIndex,
-                                              std::size_t uiComponentIndex,
-                                              int * xOffset,
-                                              int * yOffset,
-                                              int * heightOfTallestUiComponentInRow,
-                                              bool insertGaps)
+void RowLayoutPrivate::resizePreviousAndNextLabelRows(UiComponentWrapper * uiComponentWrapper)
 {
-  if(insertGaps)
+  if(!uiComponentWrapper->labelPeer)
   {
-    int temp = thisRowLayout->getHorizontalSpaceBetweenUiComponents(rowIndex);
+    return;
+  }
 
-    *xOffset += temp;
+  // Only labels above or below their uiComponent are part of a label row.
+  LabelRow * labelRow = nullptr;
 
-    // Now we must insert the gap from the previous uiComponent if any and
-    // the current uiComponent gap if any before we set the location of
-    // the current uiComponent.
-    temp = getUiComponentGap(rowIndex,
-                             uiComponentIndex - 1, // previous uiComponent
-                             uiComponentIndex);    // current uiComponent
-    *xOffset += temp;
+  if(uiComponentWrapper->uiComponentConstraints->labelOrientation == LabelOrientation::TopOrientation)
+  {
+    labelRow = uiComponentWrapper->row->d->previousLabelRow;
+  }
+  else if(uiComponentWrapper->uiComponentConstraints->labelOrientation == LabelOrientation::BottomOrientation)
+  {
+    labelRow = uiComponentWrapper->row->d->nextLabelRow;
   }
 
-  UiComponentWrapper * uiComponentWrapper = rows.at(rowIndex)->d->getUiComponentWrapperAt(uiComponentIndex);
+  if(labelRow)
+  {
+    labelRow->maxHeightLabelInRow = std::max(labelRow->maxHeightLabelInRow,
+                                             uiComponentInternals.labelPreferredHeight[uiComponentWrapper->id]);
+  }
+} // end RowLayoutPrivate::resizePreviousAndNextLabelRows
 
-  std::size_t finalUiComponentYOffset = 0;
+void RowLayoutPrivate::resizeLabelRows(std::size_t firstRowIndex, std::size_t endRowIndex)
+{
+  LayoutPhaseScope layoutPhaseScope(this, LayoutPhase::LabelRowPhase);
+  LayoutStatsTimer layoutStatsTimer(this, &LayoutStats::labelRowDuration);
 
-  if(rows.at(rowIndex)->d->previousLabelRow)
+  // The label rows of these rows were emptied when the rows were reset and
+  // the labels now have their final size, size groups included.
+  for(std::size_t rowIndex = firstRowIndex; rowIndex < endRowIndex; ++rowIndex)
   {
-    finalUiComponentYOffset = rows.at(rowIndex)->d->previousLabelRow->maxHeightLabelInRow;
+    RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+
+    if(!rowLayoutRow->d->needsLayout)
+    {
+      continue;
+    }
+
+    for(std::size_t uiComponentIndex = 0; uiComponentIndex < rowLayoutRow->getUiComponentCount(); ++uiComponentIndex)
+    {
+      resizePreviousAndNextLabelRows(rowLayoutRow->d->getUiComponentWrapperAt(uiComponentIndex));
+    }
   }
+} // end RowLayoutPrivate::resizeLabelRows
 
-  std::size_t uiComponentRowXOffset = 0;
+void RowLayoutPrivate::compactUiComponentIds()
+{
+  // Copy the state of every uiComponent that is still in this layout in row
+  // order, dropping the state of removed uiComponents.
+  UiComponentInternals compacted;
 
-  // 1) Handle labels on the top.
-  if(uiComponentWrapper->labelPeer &&
-      uiComponentWrapper->uiComponentConstraints->labelOrientation == LabelOrientation::TopOrientation)
+  compacted.reserve(uiComponentInternals.size());
+
+  for(std::size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
   {
-    // this is a label from the uiComponent/label pair above its uiComponent
-    uiComponentWrapper->uiComponentInternals->labelX = *xOffset;
-    uiComponentWrapper->uiComponentInternals->labelY = *yOffset;
+    RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
 
-    // Do not adjust the xOffset since the label is directly above its
-    // uiComponent pair.
+    rowLayoutRow->d->firstUiComponentId = compacted.size();
+
+    for(std::size_t uiComponentIndex = 0; uiComponentIndex < rowLayoutRow->getUiComponentCount(); ++uiComponentIndex)
+    {
+      UiComponentWrapper * uiComponentWrapper = rowLayoutRow->d->getUiComponentWrapperAt(uiComponentIndex);
+
+      uiComponentWrapper->id = compacted.addCopy(uiComponentInternals, uiComponentWrapper->id);
+    }
   }
 
-  // 2) Handle uiComponents and in-line labels(labels to the left or right)
-  //    Left label, uiComponent then right label in that order
+  uiComponentInternals.swap(compacted);
 
-  int yLabelVAlignmentOffset = 0;
-  int yUiComponentPeerVAlignmentOffset = 0;
+  uiComponentIdsInRowOrder = true;
+} // end RowLayoutPrivate::compactUiComponentIds
 
-  if(uiComponentWrapper->labelPeer &&
-      uiComponentWrapper->uiComponentConstraints->labelOrientation == LabelOrientation::LeftOrientation)
+void RowLayoutPrivate::markRowForLayout(RowLayout::Row * row)
+{
+  if(!row->d->needsLayout)
   {
-    // this is a label from the uiComponent/label pair
-    uiComponentWrapper->uiComponentInternals->labelX = *xOffset + uiComponentRowXOffset;
-
-    // handle vertical alignment if any
-    handleVerticalAlignment(uiComponentWrapper, &yLabelVAlignmentOffset, &yUiComponentPeerVAlignmentOffset);
+    row->d->needsLayout = true;
 
-    uiComponentWrapper->uiComponentInternals->labelY = *yOffset + yLabelVAlignmentOffset + finalUiComponentYOffset;
+    // The preferred sizes of this row still hold the results of the last
+    // layout pass, start over from the measured sizes.
+    resetUiComponentsInRow(row);
+  }
+}
 
-    uiComponentRowXOffset += uiComponentWrapper->uiComponentInternals->labelPreferredWidth;
+void RowLayoutPrivate::invalidateAllRows()
+{
+  for(std::size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
+  {
+    markRowForLayout(rows.at(rowIndex));
+  }
+}
 
-    *heightOfTallestUiComponentInRow = std::max(*heightOfTallestUiComponentInRow, uiComponentWrapper->uiComponentInternals->labelPreferredHeight);
+void RowLayoutPrivate::invalidateIfContainerChanged(UiComponent * container)
+{
+  const int clientWidth = container->getClientWidth();
+  const int clientHeight = container->getClientHeight();
+
+  if(container != lastContainer ||
+     clientWidth != lastContainerClientWidth ||
+     clientHeight != lastContainerClientHeight ||
+     verticalSpaceBetweenRowsChanged ||
+     container->getLeftPadding() != lastContainerPadding.leftPadding ||
+     container->getRightPadding() != lastContainerPadding.rightPadding ||
+     container->getTopPadding() != lastContainerPadding.topPadding ||
+     container->getBottomPadding() != lastContainerPadding.bottomPadding ||
+     growYCount > 0 ||
+     grewVertically)
+  {
+    // Row alignment and growing depend on the container, so every row must be
+    // laid out again. The measured sizes are still valid.
+    invalidateAllRows();
   }
 
-  // Now configure the uiComponent
-  uiComponentWrapper->uiComponentInternals->uiComponentX = *xOffset + uiComponentRowXOffset;
-  uiComponentWrapper->uiComponentInternals->uiComponentY = *yOffset + yUiComponentPeerVAlignmentOffset + finalUiComponentYOffset;
+  verticalSpaceBetweenRowsChanged = false;
 
-  uiComponentRowXOffset += uiComponentWrapper->uiComponentInternals->uiComponentPreferredWidth;
+  // The rows below a uiComponent that grows vertically are moved without
+  // updating their cached offsets, so the next layout pass starts over too.
+  grewVertically = growYCount > 0;
 
-  *heightOfTallestUiComponentInRow = std::max(*heightOfTallestUiComponentInRow, uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight);
+  lastContainer = container;
+  lastContainerClientWidth = clientWidth;
+  lastContainerClientHeight = clientHeight;
+  lastContainerPadding.leftPadding = container->getLeftPadding();
+  lastContainerPadding.rightPadding = container->getRightPadding();
+  lastContainerPadding.topPadding = container->getTopPadding();
+  lastContainerPadding.bottomPadding = container->getBottomPadding();
+}
 
-  if(uiComponentWrapper->labelPeer &&
-      uiComponentWrapper->uiComponentConstraints->labelOrientation == LabelOrientation::RightOrientation)
+bool RowLayoutPrivate::findLabelMeasurement(std::size_t id,
+                                            bool * measuring)
+{
+  *measuring = false;
+
+  const IMeasurableText * labelText = uiComponentInternals.labelText[id];
+
+  if(!labelText || labelMeasurementCache->getCapacity() == 0)
   {
-    // this is a label from the uiComponent/label pair
-    uiComponentWrapper->uiComponentInternals->labelX = *xOffset + uiComponentRowXOffset;
+    return false;
+  }
+
+  int width = 0;
+  int height = 0;
+
+  if(!labelMeasurementCache->find(labelText->getFontIdentity(), labelText->getText(), &width, &height))
+  {
+    return false;
+  }
+
+  // A label with the same font and text is being measured on the pool.
+  if(width == LabelMeasurementCache::NotMeasured)
+  {
+    *measuring = true;
+
+    return false;
+  }
+
+  uiComponentInternals.labelMeasuredWidth[id] = width;
+  uiComponentInternals.labelMeasuredHeight[id] = height;
+
+  return true;
+} // end RowLayoutPrivate::findLabelMeasurement
+
+void RowLayoutPrivate::cacheLabelMeasurement(std::size_t id)
+{
+  const IMeasurableText * labelText = uiComponentInternals.labelText[id];
+
+  if(labelText)
+  {
+    labelMeasurementCache->insert(labelText->getFontIdentity(),
+                                  labelText->getText(),
+                                  uiComponentInternals.labelMeasuredWidth[id],
+                                  uiComponentInternals.labelMeasuredHeight[id]);
+  }
+} // end RowLayoutPrivate::cacheLabelMeasurement
+
+void RowLayoutPrivate::measureUiComponent(std::size_t id)
+{
+  bool measuring = false;
+
+  if(uiComponentInternals.labelPeer[id] && !findLabelMeasurement(id, &measuring))
+  {
+    // this is a label/uiComponent pair
+
+    // Since the uiComponents were added to this layout manager, the
+    // width and height are under the control of the layout manager. So
+    // the width and height must be set accordingly.
+
+    uiComponentInternals.labelMeasuredWidth[id] = uiComponentInternals.labelPeer[id]->getPreferredWidth();
+    uiComponentInternals.labelMeasuredHeight[id] = uiComponentInternals.labelPeer[id]->getPreferredHeight();
+
+    cacheLabelMeasurement(id);
+
+    if(recordingLayoutStats)
+    {
+      ++layoutStats.labelsMeasured;
+    }
+  }
+
+  // Now configure the uiComponent
+
+  // Since the uiComponents were added to this layout manager, the width
+  // and height are under the control of the layout manager. So the
+  // width and height must be set accordingly.
+
+  uiComponentInternals.uiComponentMeasuredWidth[id] = uiComponentInternals.uiComponent[id]->getPreferredWidth();
+  uiComponentInternals.uiComponentMeasuredHeight[id] = uiComponentInternals.uiComponent[id]->getPreferredHeight();
+
+  if(recordingLayoutStats)
+  {
+    ++layoutStats.uiComponentsMeasured;
+  }
+
+  forgetMeasuredSizes(id);
+} // end RowLayoutPrivate::measureUiComponent
+
+void RowLayoutPrivate::forgetMeasuredSizes(std::size_t id)
+{
+  // The uiComponent changed since the sizes at the other DPIs were measured.
+  for(std::map<int, MeasuredSizes>::iterator it = measuredSizesByDpi.begin(); it != measuredSizesByDpi.end(); ++it)
+  {
+    if(id < it->second.uiComponent.size())
+    {
+      it->second.uiComponent[id] = nullptr;
+    }
+  }
+} // end RowLayoutPrivate::forgetMeasuredSizes
+
+void RowLayoutPrivate::saveMeasuredSizes()
+{
+  MeasuredSizes& measuredSizes = measuredSizesByDpi[layoutMetrics->dpi];
+
+  measuredSizes.uiComponent = uiComponentInternals.uiComponent;
+  measuredSizes.labelWidth = uiComponentInternals.labelMeasuredWidth;
+  measuredSizes.labelHeight = uiComponentInternals.labelMeasuredHeight;
+  measuredSizes.uiComponentWidth = uiComponentInternals.uiComponentMeasuredWidth;
+  measuredSizes.uiComponentHeight = uiComponentInternals.uiComponentMeasuredHeight;
+
+  // The uiComponents that were never measured have no sizes to save.
+  for(std::size_t id = 0; id < measuredSizes.uiComponent.size(); ++id)
+  {
+    if(uiComponentInternals.needsMeasure[id])
+    {
+      measuredSizes.uiComponent[id] = nullptr;
+    }
+  }
+} // end RowLayoutPrivate::saveMeasuredSizes
+
+void RowLayoutPrivate::restoreMeasuredSizes(int previousDpi)
+{
+  const int dpi = layoutMetrics->dpi;
+
+  std::map<int, MeasuredSizes>::const_iterator it = measuredSizesByDpi.find(dpi);
+
+  const MeasuredSizes * measuredSizes = it != measuredSizesByDpi.end() ? &it->second : nullptr;
+
+  for(std::size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
+  {
+    RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+
+    for(std::size_t uiComponentIndex = 0; uiComponentIndex < rowLayoutRow->getUiComponentCount(); ++uiComponentIndex)
+    {
+      UiComponentWrapper * uiComponentWrapper = rowLayoutRow->d->getUiComponentWrapperAt(uiComponentIndex);
+
+      const std::size_t id = uiComponentWrapper->id;
+
+      if(uiComponentInternals.needsMeasure[id])
+      {
+        continue;
+      }
+
+      if(measuredSizes &&
+         id < measuredSizes->uiComponent.size() &&
+         measuredSizes->uiComponent[id] == uiComponentInternals.uiComponent[id])
+      {
+        uiComponentInternals.labelMeasuredWidth[id] = measuredSizes->labelWidth[id];
+        uiComponentInternals.labelMeasuredHeight[id] = measuredSizes->labelHeight[id];
+        uiComponentInternals.uiComponentMeasuredWidth[id] = measuredSizes->uiComponentWidth[id];
+        uiComponentInternals.uiComponentMeasuredHeight[id] = measuredSizes->uiComponentHeight[id];
+      }
+      else
+      {
+        // Never measured at this DPI or changed since, scale instead of
+        // measuring again.
+        uiComponentInternals.labelMeasuredWidth[id] = LayoutMetrics::scale(uiComponentInternals.labelMeasuredWidth[id], previousDpi, dpi);
+        uiComponentInternals.labelMeasuredHeight[id] = LayoutMetrics::scale(uiComponentInternals.labelMeasuredHeight[id], previousDpi, dpi);
+        uiComponentInternals.uiComponentMeasuredWidth[id] = LayoutMetrics::scale(uiComponentInternals.uiComponentMeasuredWidth[id], previousDpi, dpi);
+        uiComponentInternals.uiComponentMeasuredHeight[id] = LayoutMetrics::scale(uiComponentInternals.uiComponentMeasuredHeight[id], previousDpi, dpi);
+      }
+
+      updateSizeGroups(uiComponentWrapper);
+    }
+  }
+} // end RowLayoutPrivate::restoreMeasuredSizes
+
+void RowLayoutPrivate::measureUiComponentsInRow(RowLayout::Row * row)
+{
+  const std::size_t firstId = row->d->firstUiComponentId;
+  const std::size_t endId = firstId + row->getUiComponentCount();
+
+  for(std::size_t id = firstId; id < endId; ++id)
+  {
+    if(!uiComponentInternals.needsMeasure[id])
+    {
+      continue;
+    }
+
+    measureUiComponent(id);
+
+    uiComponentInternals.needsMeasure[id] = 0;
+
+    // Keep the max sizes of the size groups of this uiComponent up to date.
+    updateSizeGroups(row->d->getUiComponentWrapperAt(id - firstId));
+  }
+} // end RowLayoutPrivate::measureUiComponentsInRow
+
+// A task of RowLayoutPrivate::measureUiComponents. Measures the uiComponents
+// [taskIndex * MeasurementsPerTask, (taskIndex + 1) * MeasurementsPerTask) of
+// RowLayoutPrivate::threadSafeMeasurements.
+static void measureUiComponentsTask(std::size_t taskIndex, void * userData)
+{
+  RowLayoutPrivate * rowLayoutPrivate = static_cast<RowLayoutPrivate *>(userData);
+  UiComponentInternals& uiComponentInternals = rowLayoutPrivate->uiComponentInternals;
+
+  const std::size_t endIndex = std::min(rowLayoutPrivate->threadSafeMeasurements.size(),
+                                        (taskIndex + 1) * RowLayoutPrivate::MeasurementsPerTask);
+
+  for(std::size_t i = taskIndex * RowLayoutPrivate::MeasurementsPerTask; i < endIndex; ++i)
+  {
+    const std::size_t id = rowLayoutPrivate->threadSafeMeasurements.at(i)->id;
+
+    // Every task writes the sizes of different uiComponents.
+    if(rowLayoutPrivate->threadSafeLabelMeasurements.at(i) == RowLayoutPrivate::LabelMeasuredByPool)
+    {
+      uiComponentInternals.labelMeasurable[id]->measurePreferredSize(&uiComponentInternals.labelMeasuredWidth[id],
+                                                                     &uiComponentInternals.labelMeasuredHeight[id]);
+    }
+
+    uiComponentInternals.uiComponentMeasurable[id]->measurePreferredSize(&uiComponentInternals.uiComponentMeasuredWidth[id],
+                                                                         &uiComponentInternals.uiComponentMeasuredHeight[id]);
+  }
+}
+
+void RowLayoutPrivate::measureUiComponents(std::size_t firstRowIndex,
+                                           std::size_t endRowIndex)
+{
+  LayoutStatsTimer layoutStatsTimer(this, &LayoutStats::measureDuration);
+
+  if(layoutThreadPool.getThreadCount() < 2)
+  {
+    for(std::size_t rowIndex = firstRowIndex; rowIndex < endRowIndex; ++rowIndex)
+    {
+      if(rows.at(rowIndex)->d->needsLayout)
+      {
+        measureUiComponentsInRow(rows.at(rowIndex));
+      }
+    }
+
+    return;
+  }
+
+  // The uiComponents whose label, if any, and uiComponent are both thread
+  // safe are measured on the threads of the pool. The rest are measured here.
+  threadSafeMeasurements.clear();
+  threadSafeLabelMeasurements.clear();
+
+  for(std::size_t rowIndex = firstRowIndex; rowIndex < endRowIndex; ++rowIndex)
+  {
+    RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+
+    if(!rowLayoutRow->d->needsLayout)
+    {
+      continue;
+    }
+
+    const std::size_t firstId = rowLayoutRow->d->firstUiComponentId;
+    const std::size_t endId = firstId + rowLayoutRow->getUiComponentCount();
+
+    for(std::size_t id = firstId; id < endId; ++id)
+    {
+      if(!uiComponentInternals.needsMeasure[id])
+      {
+        continue;
+      }
+
+      UiComponentWrapper * uiComponentWrapper = rowLayoutRow->d->getUiComponentWrapperAt(id - firstId);
+
+      if(uiComponentInternals.uiComponentMeasurable[id] &&
+         (!uiComponentInternals.labelPeer[id] || uiComponentInternals.labelMeasurable[id]))
+      {
+        countBufferGrowth(threadSafeMeasurements.size() + 1, threadSafeMeasurements.capacity());
+
+        threadSafeMeasurements.push_back(uiComponentWrapper);
+
+        // The cache is only used on this thread, so the labels whose size is
+        // cached are looked up here and the rest are measured on the pool.
+        // Labels with the same font and text are only measured once.
+        LabelMeasurement labelMeasurement = LabelMeasured;
+        bool measuring = false;
+
+        if(uiComponentInternals.labelPeer[id] && !findLabelMeasurement(id, &measuring))
+        {
+          if(measuring)
+          {
+            labelMeasurement = LabelMeasuredByPeer;
+          }
+          else
+          {
+            labelMeasurement = LabelMeasuredByPool;
+
+            if(uiComponentInternals.labelText[id] && labelMeasurementCache->getCapacity() > 0)
+            {
+              labelMeasurementCache->insert(uiComponentInternals.labelText[id]->getFontIdentity(),
+                                            uiComponentInternals.labelText[id]->getText(),
+                                            LabelMeasurementCache::NotMeasured,
+                                            LabelMeasurementCache::NotMeasured);
+            }
+          }
+        }
+
+        countBufferGrowth(threadSafeLabelMeasurements.size() + 1, threadSafeLabelMeasurements.capacity());
+
+        threadSafeLabelMeasurements.push_back(static_cast<unsigned char>(labelMeasurement));
+
+        continue;
+      }
+
+      measureUiComponent(id);
+
+      uiComponentInternals.needsMeasure[id] = 0;
+
+      updateSizeGroups(uiComponentWrapper);
+    }
+  }
+
+  const std::size_t taskCount = (threadSafeMeasurements.size() + MeasurementsPerTask - 1) / MeasurementsPerTask;
+
+  layoutThreadPool.run(taskCount, &::measureUiComponentsTask, this);
+
+  for(std::size_t i = 0; i < threadSafeMeasurements.size(); ++i)
+  {
+    if(threadSafeLabelMeasurements.at(i) == LabelMeasuredByPool)
+    {
+      cacheLabelMeasurement(threadSafeMeasurements.at(i)->id);
+
+      if(recordingLayoutStats)
+      {
+        ++layoutStats.labelsMeasured;
+      }
+    }
+  }
+
+  if(recordingLayoutStats)
+  {
+    layoutStats.uiComponentsMeasured += threadSafeMeasurements.size();
+  }
+
+  // The size groups are only resolved once every measurement is done.
+  for(std::size_t i = 0; i < threadSafeMeasurements.size(); ++i)
+  {
+    const std::size_t id = threadSafeMeasurements.at(i)->id;
+
+    bool measuring = false;
+
+    // The size of a label that was measured by its peer may have been
+    // dropped from a small cache in the meantime.
+    if(threadSafeLabelMeasurements.at(i) == LabelMeasuredByPeer && !findLabelMeasurement(id, &measuring))
+    {
+      uiComponentInternals.labelMeasuredWidth[id] = uiComponentInternals.labelPeer[id]->getPreferredWidth();
+      uiComponentInternals.labelMeasuredHeight[id] = uiComponentInternals.labelPeer[id]->getPreferredHeight();
+
+      cacheLabelMeasurement(id);
+
+      if(recordingLayoutStats)
+      {
+        ++layoutStats.labelsMeasured;
+      }
+    }
+
+    forgetMeasuredSizes(id);
+
+    uiComponentInternals.needsMeasure[id] = 0;
+
+    updateSizeGroups(threadSafeMeasurements.at(i));
+  }
+} // end RowLayoutPrivate::measureUiComponents
+
+void RowLayoutPrivate::resetUiComponentsInRow(RowLayout::Row * row)
+{
+  const std::size_t firstId = row->d->firstUiComponentId;
+  const std::size_t endId = firstId + row->getUiComponentCount();
+
+  // Start over from the measured sizes.
+  std::copy(uiComponentInternals.labelMeasuredWidth.begin() + firstId,
+            uiComponentInternals.labelMeasuredWidth.begin() + endId,
+            uiComponentInternals.labelPreferredWidth.begin() + firstId);
+
+  std::copy(uiComponentInternals.labelMeasuredHeight.begin() + firstId,
+            uiComponentInternals.labelMeasuredHeight.begin() + endId,
+            uiComponentInternals.labelPreferredHeight.begin() + firstId);
+
+  std::copy(uiComponentInternals.uiComponentMeasuredWidth.begin() + firstId,
+            uiComponentInternals.uiComponentMeasuredWidth.begin() + endId,
+            uiComponentInternals.uiComponentPreferredWidth.begin() + firstId);
+
+  std::copy(uiComponentInternals.uiComponentMeasuredHeight.begin() + firstId,
+            uiComponentInternals.uiComponentMeasuredHeight.begin() + endId,
+            uiComponentInternals.uiComponentPreferredHeight.begin() + firstId);
+
+  // The label rows are sized from scratch by resizeLabelRows so that they
+  // shrink along with their labels.
+  if(row->d->previousLabelRow)
+  {
+    row->d->previousLabelRow->maxHeightLabelInRow = 0;
+  }
+
+  if(row->d->nextLabelRow)
+  {
+    row->d->nextLabelRow->maxHeightLabelInRow = 0;
+  }
+
+  // Check for all of the uiComponents in the current row, the first
+  // uiComponent has no gap to its left.
+  for(std::size_t componentIndex = 1; componentIndex < row->getUiComponentCount(); ++componentIndex)
+  {
+    UiComponentWrapper * uiComponentWrapper = row->d->getUiComponentWrapperAt(componentIndex);
+
+    // Set the gap if a gap has not already been specified. Note since
+    // a gap by definition is the space between two uiComponents, you will
+    // need to get the gap between the previous uiComponent and the
+    // current uiComponent, setting only the right gap of the previous
+    // uiComponent and the left gap of the current uiComponent.
+    UiComponentWrapper * previousUiComponent = row->d->getUiComponentWrapperAt(componentIndex - 1);
+    UiComponentWrapper * currentUiComponent = uiComponentWrapper;
+
+    if(previousUiComponent->uiComponentConstraints->horizontalGapRight < 0)
+    {
+      // the client did not specify the gap, so we will need to specify
+      // a gap
+
+      // Leave the user constraint unspecified, only change the internal
+      // constraint because the user left the constraint unspecified.
+      uiComponentInternals.horizontalGapRight[previousUiComponent->id] = layoutMetrics->horizontalGap; // TODO: Factor in related/unrelated
+    }
+
+    if(currentUiComponent->uiComponentConstraints->horizontalGapLeft < 0)
+    {
+      // the client did not specify the gap, so we will need to specify
+      // a gap
+
+      // Leave the user constraint unspecified, only change the internal
+      // constraint because the user left the constraint unspecified.
+      uiComponentInternals.horizontalGapLeft[currentUiComponent->id] = layoutMetrics->horizontalGap; // TODO: Factor in related/unrelated
+    }
+  }// end current row loop
+} // end RowLayoutPrivate::resetUiComponentsInRow
+
+// This stage is only concerned with grabbing the preferred sizes and
+// setting those sizes to the actual size.
+//
+// We also specify any gaps if gaps have not been specified. However we do
+// not apply gaps, that is done in the post layout stage.
+//
+// Only rows that need to be laid out again are visited and only the
+// uiComponents within those rows that were invalidated are measured again.
+//
+// We make no adjustments to the location of any uiComponent.
+//
+// We make no adjustments to the container during this stage.
+void RowLayoutPrivate::preLayout(RowLayout * thisRowLayout)
+{
+  LayoutPhaseScope layoutPhaseScope(this, LayoutPhase::PreLayoutPhase);
+
+  measureUiComponents(0, rows.size());
+
+  for(std::size_t rowIndex = 0; rowIndex < thisRowLayout->getRowCount(); ++rowIndex)
+  {
+    RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+
+    if(!rowLayoutRow->d->needsLayout)
+    {
+      // This row keeps the sizes and locations from the last layout pass.
+      continue;
+    }
+
+    resetUiComponentsInRow(rowLayoutRow);
+  }// end all rows loop
+} // end RowLayoutPrivate::preLayout
+
+int RowLayoutPrivate::getUiComponentGap(std::size_t rowIndex,
+                                        std::size_t previousUiComponentIndex,
+                                        std::size_t currentUiComponentIndex)
+{
+  RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+  UiComponentWrapper * previousUiComponent = rowLayoutRow->d->getUiComponentWrapperAt(previousUiComponentIndex);
+  UiComponentWrapper * currentUiComponent = rowLayoutRow->d->getUiComponentWrapperAt(currentUiComponentIndex);
+
+  if(previousUiComponent->uiComponentConstraints->horizontalGapRight > 0)
+  {
+    // the client specified a gap for the previous uiComponent
+
+    if(currentUiComponent->uiComponentConstraints->horizontalGapLeft > 0)
+    {
+      // the client specified a gap for the current uiComponent
+
+      // the gap
+      return std::max(previousUiComponent->uiComponentConstraints->horizontalGapRight,
+                      currentUiComponent->uiComponentConstraints->horizontalGapLeft);
+    }
+    else
+    {
+      // the client did not specify a gap for the current uiComponent
+
+      // the gap
+      return std::max(previousUiComponent->uiComponentConstraints->horizontalGapRight,
+                      uiComponentInternals.horizontalGapLeft[currentUiComponent->id]);
+    }
+  }
+  else
+  {
+    // the client did not specify a gap for the previous uiComponent
+
+    if(currentUiComponent->uiComponentConstraints->horizontalGapLeft > 0)
+    {
+      // the client specified a gap for the current uiComponent
+
+      // the gap
+      return std::max(uiComponentInternals.horizontalGapRight[previousUiComponent->id],
+                      currentUiComponent->uiComponentConstraints->horizontalGapLeft);
+    }
+    else
+    {
+      // the client did not specify a gap for the current uiComponent
+
+      // the gap
+      return std::max(uiComponentInternals.horizontalGapRight[previousUiComponent->id],
+                      uiComponentInternals.horizontalGapLeft[currentUiComponent->id]);
+    }
+  }
+} // end RowLayoutPrivate::getUiComponentGap
+
+void RowLayoutPrivate::applyCenterRowAlignment(RowLayout * thisRowLayout,
+                                               std::size_t rowIndex,
+                                               int containerWidth,
+                                               int containerLeftPadding,
+                                               int containerRightPadding)
+{
+  int remainingFreeSpace = containerWidth - rows.at(rowIndex)->d->rowWidth - containerLeftPadding - containerRightPadding;
+
+  remainingFreeSpace  = remainingFreeSpace / 2;
+
+  if(remainingFreeSpace > 0)
+  {
+    const std::size_t firstId = rows.at(rowIndex)->d->firstUiComponentId;
+    const std::size_t endId = firstId + thisRowLayout->getUiComponentCountAtRow(rowIndex);
+
+    const LayoutKernels& layoutKernels = ::getLayoutKernels();
+
+    // Note: The label x-offset of a uiComponent without a label is never
+    //       applied, so it is moved along with the rest to keep the row a
+    //       single packed range.
+    layoutKernels.addToValues(uiComponentInternals.labelX.data() + firstId, endId - firstId, remainingFreeSpace);
+    layoutKernels.addToValues(uiComponentInternals.uiComponentX.data() + firstId, endId - firstId, remainingFreeSpace);
+  }
+} // end RowLayoutPrivate::applyCenterRowAlignment
+
+void RowLayoutPrivate::applyRightRowAlignment(RowLayout * thisRowLayout,
+                                              std::size_t rowIndex,
+                                              int containerWidth,
+                                              int containerLeftPadding,
+                                              int containerRightPadding)
+{
+  int remainingFreeSpace = containerWidth - rows.at(rowIndex)->d->rowWidth - containerLeftPadding - containerRightPadding;
+
+  if(remainingFreeSpace > 0)
+  {
+    const std::size_t firstId = rows.at(rowIndex)->d->firstUiComponentId;
+    const std::size_t endId = firstId + thisRowLayout->getUiComponentCountAtRow(rowIndex);
+
+    const LayoutKernels& layoutKernels = ::getLayoutKernels();
+
+    // Note: The label x-offset of a uiComponent without a label is never
+    //       applied, so it is moved along with the rest to keep the row a
+    //       single packed range.
+    layoutKernels.addToValues(uiComponentInternals.labelX.data() + firstId, endId - firstId, remainingFreeSpace);
+    layoutKernels.addToValues(uiComponentInternals.uiComponentX.data() + firstId, endId - firstId, remainingFreeSpace);
+  }
+} // end RowLayoutPrivate::applyRightRowAlignment
+
+// Computes how far a label and its uiComponent are moved down to align the
+// label vertically with its uiComponent. Only the shorter of the two moves.
+static void getVerticalAlignmentOffsets(LabelVerticalAlignment::Value labelVerticalAlignment,
+                                        int labelHeight,
+                                        int uiComponentHeight,
+                                        int * yLabelVAlignmentOffset,
+                                        int * yUiComponentPeerVAlignmentOffset)
+{
+  if(labelVerticalAlignment == LabelVerticalAlignment::MiddleAlignment)
+  {
+    if(labelHeight < uiComponentHeight)
+    {
+      *yLabelVAlignmentOffset = (uiComponentHeight - labelHeight) / 2;
+    }
+    else if(labelHeight > uiComponentHeight)
+    {
+      *yUiComponentPeerVAlignmentOffset = (labelHeight - uiComponentHeight) / 2;
+    }
+  }
+  else if(labelVerticalAlignment == LabelVerticalAlignment::BottomAlignment)
+  {
+    if(labelHeight < uiComponentHeight)
+    {
+      *yLabelVAlignmentOffset = (uiComponentHeight - labelHeight);
+    }
+    else if(labelHeight > uiComponentHeight)
+    {
+      *yUiComponentPeerVAlignmentOffset = (labelHeight - uiComponentHeight);
+    }
+  }
+}
+
+void RowLayoutPrivate::handleVerticalAlignment(UiComponentWrapper * uiComponentWrapper,
+                                               int * yLabelVAlignmentOffset,
+                                               int * yUiComponentPeerVAlignmentOffset)
+{
+  const std::size_t id = uiComponentWrapper->id;
+
+  ::getVerticalAlignmentOffsets(uiComponentWrapper->uiComponentConstraints->labelVerticalAlignment,
+                                uiComponentInternals.labelPreferredHeight[id],
+                                uiComponentInternals.uiComponentPreferredHeight[id],
+                                yLabelVAlignmentOffset,
+                                yUiComponentPeerVAlignmentOffset);
+} // end RowLayoutPrivate::handleVerticalAlignment
+
+void RowLayoutPrivate::layoutUiComponentInRow(RowLayout * thisRowLayout,
+                                              std::size_t rowIndex,
+                                              std::size_t uiComponentIndex,
+                                              int * xOffset,
+                                              int * yOffset,
+                                              int * heightOfTallestUiComponentInRow,
+                                              bool insertGaps)
+{
+  if(insertGaps)
+  {
+    int temp = thisRowLayout->getHorizontalSpaceBetweenUiComponents(rowIndex);
+
+    *xOffset += temp;
+
+    // Now we must insert the gap from the previous uiComponent if any and
+    // the current uiComponent gap if any before we set the location of
+    // the current uiComponent.
+    temp = getUiComponentGap(rowIndex,
+                             uiComponentIndex - 1, // previous uiComponent
+                             uiComponentIndex);    // current uiComponent
+    *xOffset += temp;
+  }
+
+  UiComponentWrapper * uiComponentWrapper = rows.at(rowIndex)->d->getUiComponentWrapperAt(uiComponentIndex);
+
+  const std::size_t id = uiComponentWrapper->id;
+
+  std::size_t finalUiComponentYOffset = 0;
+
+  if(rows.at(rowIndex)->d->previousLabelRow)
+  {
+    finalUiComponentYOffset = rows.at(rowIndex)->d->previousLabelRow->maxHeightLabelInRow;
+  }
+
+  std::size_t uiComponentRowXOffset = 0;
+
+  // 1) Handle labels on the top.
+  if(uiComponentWrapper->labelPeer &&
+      uiComponentWrapper->uiComponentConstraints->labelOrientation == LabelOrientation::TopOrientation)
+  {
+    // this is a label from the uiComponent/label pair above its uiComponent
+    uiComponentInternals.labelX[id] = *xOffset;
+    uiComponentInternals.labelY[id] = *yOffset;
+
+    // Do not adjust the xOffset since the label is directly above its
+    // uiComponent pair.
+  }
+
+  // 2) Handle uiComponents and in-line labels(labels to the left or right)
+  //    Left label, uiComponent then right label in that order
+
+  int yLabelVAlignmentOffset = 0;
+  int yUiComponentPeerVAlignmentOffset = 0;
+
+  if(uiComponentWrapper->labelPeer &&
+      uiComponentWrapper->uiComponentConstraints->labelOrientation == LabelOrientation::LeftOrientation)
+  {
+    // this is a label from the uiComponent/label pair
+    uiComponentInternals.labelX[id] = *xOffset + uiComponentRowXOffset;
+
+    // handle vertical alignment if any
+    handleVerticalAlignment(uiComponentWrapper, &yLabelVAlignmentOffset, &yUiComponentPeerVAlignmentOffset);
+
+    uiComponentInternals.labelY[id] = *yOffset + yLabelVAlignmentOffset + finalUiComponentYOffset;
+
+    uiComponentRowXOffset += uiComponentInternals.labelPreferredWidth[id];
+
+    *heightOfTallestUiComponentInRow = std::max(*heightOfTallestUiComponentInRow, uiComponentInternals.labelPreferredHeight[id]);
+  }
+
+  // Now configure the uiComponent
+  uiComponentInternals.uiComponentX[id] = *xOffset + uiComponentRowXOffset;
+  uiComponentInternals.uiComponentY[id] = *yOffset + yUiComponentPeerVAlignmentOffset + finalUiComponentYOffset;
+
+  uiComponentRowXOffset += uiComponentInternals.uiComponentPreferredWidth[id];
+
+  // Note: The height of the uiComponent is accounted for by
+  //       layoutAllUiComponentsInRow, all at once for the whole row.
+
+  if(uiComponentWrapper->labelPeer &&
+      uiComponentWrapper->uiComponentConstraints->labelOrientation == LabelOrientation::RightOrientation)
+  {
+    // this is a label from the uiComponent/label pair
+    uiComponentInternals.labelX[id] = *xOffset + uiComponentRowXOffset;
+
+    // handle vertical alignment if any
+    handleVerticalAlignment(uiComponentWrapper, &yLabelVAlignmentOffset, &yUiComponentPeerVAlignmentOffset);
+
+    uiComponentInternals.labelY[id] = *yOffset + finalUiComponentYOffset;
+
+    uiComponentRowXOffset += uiComponentInternals.labelPreferredWidth[id];
+
+    *heightOfTallestUiComponentInRow = std::max(*heightOfTallestUiComponentInRow, uiComponentInternals.labelPreferredHeight[id]);
+  }
+
+  finalUiComponentYOffset += uiComponentInternals.uiComponentPreferredHeight[id];
+
+  // 3) Handle labels on the bottom.
+
+  if(uiComponentWrapper->labelPeer &&
+      uiComponentWrapper->uiComponentConstraints->labelOrientation == LabelOrientation::BottomOrientation)
+  {
+    // this is a label from the uiComponent/label pair
+    uiComponentInternals.labelX[id] = *xOffset;
+    uiComponentInternals.labelY[id] = *yOffset + finalUiComponentYOffset;
+
+    *heightOfTallestUiComponentInRow = std::max(*heightOfTallestUiComponentInRow, uiComponentInternals.labelPreferredHeight[id]);
+  }
+
+  // Adjust the xOffset
+  *xOffset += uiComponentRowXOffset;
+} // end RowLayoutPrivate::layoutUiComponentInRow
+
+// Returns the share of the specified space that belongs to the grower whose
+// weight ends at the specified running total of weights. Summing the shares of
+// every grower in order hands out exactly the specified space.
+static int getGrowShare(int space,
+                        int weightsBefore,
+                        int weight,
+                        int totalWeight)
+{
+  const long long end = static_cast<long long>(space) * (weightsBefore + weight) / totalWeight;
+  const long long begin = static_cast<long long>(space) * weightsBefore / totalWeight;
+
+  return static_cast<int>(end - begin);
+}
+
+bool RowLayoutPrivate::growUiComponentsInRow(std::size_t rowIndex,
+                                             int remainingWidth)
+{
+  LayoutStatsTimer layoutStatsTimer(this, &LayoutStats::growDuration);
+
+  RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+
+  const std::size_t firstId = rowLayoutRow->d->firstUiComponentId;
+  const std::size_t endId = firstId + rowLayoutRow->getUiComponentCount();
+
+  int totalWeight = 0;
+
+  for(std::size_t uiComponentIndex = 0; uiComponentIndex < rowLayoutRow->getUiComponentCount(); ++uiComponentIndex)
+  {
+    totalWeight += std::max(rowLayoutRow->d->getUiComponentWrapperAt(uiComponentIndex)->uiComponentConstraints->growX, 0);
+  }
+
+  if(totalWeight == 0)
+  {
+    return false;
+  }
+
+  if(remainingWidth <= 0)
+  {
+    // There is no space to give away, but the row is still considered full.
+    return true;
+  }
+
+  // Every grower gets its share of the remaining width and every uiComponent
+  // and label moves right by the shares of the growers before it.
+  int weightsBefore = 0;
+  int distance = 0;
+
+  for(std::size_t id = firstId; id < endId; ++id)
+  {
+    // Note: The label x-offset of a uiComponent without a label is never
+    //       applied, so it is moved along with the rest.
+    uiComponentInternals.labelX[id] += distance;
+    uiComponentInternals.uiComponentX[id] += distance;
+
+    const UiComponentConstraints * constraints = rowLayoutRow->d->getUiComponentWrapperAt(id - firstId)->uiComponentConstraints;
+
+    if(constraints->growX > 0)
+    {
+      const int share = getGrowShare(remainingWidth, weightsBefore, constraints->growX, totalWeight);
+
+      weightsBefore += constraints->growX;
+
+      uiComponentInternals.uiComponentPreferredWidth[id] += share;
+
+      // A label to the right of its uiComponent moves with the right edge of
+      // the uiComponent.
+      if(constraints->labelOrientation == LabelOrientation::RightOrientation)
+      {
+        uiComponentInternals.labelX[id] += share;
+      }
+
+      distance += share;
+    }
+  }
+
+  return true;
+} // end RowLayoutPrivate::growUiComponentsInRow
+
+void RowLayoutPrivate::growRowsVertically(int remainingHeight)
+{
+  LayoutStatsTimer layoutStatsTimer(this, &LayoutStats::growDuration);
+
+  // The weight of a row is the largest growY of its uiComponents.
+  int totalWeight = 0;
+
+  for(std::size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
+  {
+    RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+
+    rowLayoutRow->d->growYWeight = 0;
+    rowLayoutRow->d->rowGrowth = 0;
+
+    for(std::size_t uiComponentIndex = 0; uiComponentIndex < rowLayoutRow->getUiComponentCount(); ++uiComponentIndex)
+    {
+      rowLayoutRow->d->growYWeight = std::max(rowLayoutRow->d->growYWeight,
+                                              rowLayoutRow->d->getUiComponentWrapperAt(uiComponentIndex)->uiComponentConstraints->growY);
+    }
+
+    totalWeight += rowLayoutRow->d->growYWeight;
+  }
+
+  // Every growing row gets its share of the remaining height and every row
+  // moves down by the shares of the rows above it.
+  int weightsBefore = 0;
+  int distance = 0;
+
+  for(std::size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
+  {
+    RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+
+    if(distance > 0)
+    {
+      moveRowDown(rowIndex, distance);
+
+      rowLayoutRow->d->needsApply = true;
+    }
+
+    if(rowLayoutRow->d->growYWeight <= 0)
+    {
+      continue;
+    }
+
+    int share = 0;
+
+    if(remainingHeight > 0)
+    {
+      share = getGrowShare(remainingHeight, weightsBefore, rowLayoutRow->d->growYWeight, totalWeight);
+    }
+
+    weightsBefore += rowLayoutRow->d->growYWeight;
+
+    rowLayoutRow->d->rowGrowth = share;
+
+    // The uiComponents of a row end above its next label row.
+    // Note: The height of every row but the first includes the vertical
+    //       space above it, which is not part of the row.
+    int uiComponentsBottom = rowLayoutRow->d->rowTop + rowLayoutRow->d->rowHeight + share;
+
+    if(rowIndex > 0)
+    {
+      uiComponentsBottom -= ::getVerticalSpaceBetweenRowsToPlatformIfNeeded(verticalSpaceBetweenRows, layoutMetrics);
+    }
+
+    if(rowLayoutRow->d->nextLabelRow)
+    {
+      uiComponentsBottom -= rowLayoutRow->d->nextLabelRow->maxHeightLabelInRow;
+    }
+
+    const std::size_t firstId = rowLayoutRow->d->firstUiComponentId;
+    const std::size_t endId = firstId + rowLayoutRow->getUiComponentCount();
+
+    for(std::size_t id = firstId; id < endId; ++id)
+    {
+      const UiComponentConstraints * constraints = rowLayoutRow->d->getUiComponentWrapperAt(id - firstId)->uiComponentConstraints;
+
+      if(constraints->growY <= 0)
+      {
+        continue;
+      }
+
+      // Grow Y implies Grow Row Y too, so grow the uiComponent to the bottom
+      // of the uiComponents of its grown row.
+      const int growth = uiComponentsBottom - uiComponentInternals.uiComponentY[id] - uiComponentInternals.uiComponentPreferredHeight[id];
+
+      if(growth > 0)
+      {
+        uiComponentInternals.uiComponentPreferredHeight[id] += growth;
+
+        // A label below its uiComponent moves with the bottom edge of the
+        // uiComponent.
+        if(constraints->labelOrientation == LabelOrientation::BottomOrientation)
+        {
+          uiComponentInternals.labelY[id] += growth;
+        }
+      }
+    }
+
+    distance += share;
+  }
+} // end RowLayoutPrivate::growRowsVertically
+
+void RowLayoutPrivate::moveRowDown(std::size_t rowIndex,
+                                   int distance)
+{
+  RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+
+  const std::size_t firstId = rowLayoutRow->d->firstUiComponentId;
+  const std::size_t endId = firstId + rowLayoutRow->getUiComponentCount();
+
+  const LayoutKernels& layoutKernels = ::getLayoutKernels();
+
+  // Note: The label y-offset of a uiComponent without a label is never
+  //       applied, so it is moved along with the rest to keep the row a
+  //       single packed range.
+  layoutKernels.addToValues(uiComponentInternals.labelY.data() + firstId, endId - firstId, distance);
+  layoutKernels.addToValues(uiComponentInternals.uiComponentY.data() + firstId, endId - firstId, distance);
+
+  rowLayoutRow->d->rowTop += distance;
+} // end RowLayoutPrivate::moveRowDown
+
+void RowLayoutPrivate::addChangedBounds(UiComponent * uiComponent,
+                                        int x,
+                                        int y,
+                                        int width,
+                                        int height,
+                                        int& appliedX,
+                                        int& appliedY,
+                                        int& appliedWidth,
+                                        int& appliedHeight)
+{
+  unsigned char changed = 0;
+
+  if(appliedWidth != width || appliedHeight != height)
+  {
+    changed |= UiComponentBounds::SizeChanged;
+
+    appliedWidth = width;
+    appliedHeight = height;
+  }
+  else
+  {
+    ++skippedBoundsCallCount;
+  }
+
+  if(appliedX != x || appliedY != y)
+  {
+    changed |= UiComponentBounds::LocationChanged;
+
+    appliedX = x;
+    appliedY = y;
+  }
+  else
+  {
+    ++skippedBoundsCallCount;
+  }
+
+  if(changed)
+  {
+    UiComponentBounds uiComponentBounds;
+    uiComponentBounds.uiComponent = uiComponent;
+    uiComponentBounds.x = x;
+    uiComponentBounds.y = y;
+    uiComponentBounds.width = width;
+    uiComponentBounds.height = height;
+    uiComponentBounds.changed = changed;
+
+    countBufferGrowth(changedBounds.size() + 1, changedBounds.capacity());
+
+    changedBounds.push_back(uiComponentBounds);
+  }
+} // end RowLayoutPrivate::addChangedBounds
+
+void RowLayoutPrivate::collectChangedBoundsInRow(RowLayout::Row * row)
+{
+  const std::size_t firstId = row->d->firstUiComponentId;
+  const std::size_t endId = firstId + row->getUiComponentCount();
+
+  for(std::size_t id = firstId; id < endId; ++id)
+  {
+    if(uiComponentInternals.labelPeer[id])
+    {
+      addChangedBounds(uiComponentInternals.labelPeer[id],
+                       uiComponentInternals.labelX[id],
+                       uiComponentInternals.labelY[id],
+                       uiComponentInternals.labelPreferredWidth[id],
+                       uiComponentInternals.labelPreferredHeight[id],
+                       uiComponentInternals.labelAppliedX[id],
+                       uiComponentInternals.labelAppliedY[id],
+                       uiComponentInternals.labelAppliedWidth[id],
+                       uiComponentInternals.labelAppliedHeight[id]);
+    }
+
+    addChangedBounds(uiComponentInternals.uiComponent[id],
+                     uiComponentInternals.uiComponentX[id],
+                     uiComponentInternals.uiComponentY[id],
+                     uiComponentInternals.uiComponentPreferredWidth[id],
+                     uiComponentInternals.uiComponentPreferredHeight[id],
+                     uiComponentInternals.uiComponentAppliedX[id],
+                     uiComponentInternals.uiComponentAppliedY[id],
+                     uiComponentInternals.uiComponentAppliedWidth[id],
+                     uiComponentInternals.uiComponentAppliedHeight[id]);
+  }
+} // end RowLayoutPrivate::collectChangedBoundsInRow
+
+void RowLayoutPrivate::collectChangedBounds()
+{
+  changedBounds.clear();
+
+  for(std::size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
+  {
+    RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+
+    if(!rowLayoutRow->d->needsApply)
+    {
+      // Nothing in this row moved or changed size.
+      continue;
+    }
+
+    collectChangedBoundsInRow(rowLayoutRow);
+  }
+} // end RowLayoutPrivate::collectChangedBounds
+
+void RowLayoutPrivate::commitChangedBounds(UiComponent * container)
+{
+  LayoutPhaseScope layoutPhaseScope(this, LayoutPhase::ApplyBoundsPhase);
+  LayoutStatsTimer layoutStatsTimer(this, &LayoutStats::applyBoundsDuration);
+
+  if(changedBounds.empty())
+  {
+    return;
+  }
+
+  ILayoutContainer * layoutContainer = dynamic_cast<ILayoutContainer *>(container);
+
+  if(layoutContainer)
+  {
+    // The container moves every child in one step, so nothing flickers.
+    layoutContainer->setBounds(&changedBounds.at(0), changedBounds.size());
+
+    if(recordingLayoutStats)
+    {
+      ++layoutStats.nativeCallCount;
+    }
+
+    return;
+  }
+
+  for(std::size_t i = 0; i < changedBounds.size(); ++i)
+  {
+    const UiComponentBounds& uiComponentBounds = changedBounds.at(i);
+
+    // To prevent flickering while applying the new bounds.
+    uiComponentBounds.uiComponent->disableDrawing();
+
+    if(uiComponentBounds.changed & UiComponentBounds::SizeChanged)
+    {
+      uiComponentBounds.uiComponent->setSize(uiComponentBounds.width,
+                                             uiComponentBounds.height);
+    }
+
+    if(uiComponentBounds.changed & UiComponentBounds::LocationChanged)
+    {
+      uiComponentBounds.uiComponent->setLocation(uiComponentBounds.x,
+                                                 uiComponentBounds.y);
+    }
+
+    uiComponentBounds.uiComponent->enableDrawing();
+
+    if(recordingLayoutStats)
+    {
+      layoutStats.nativeCallCount += ((uiComponentBounds.changed & UiComponentBounds::SizeChanged) ? 1 : 0) +
+                                     ((uiComponentBounds.changed & UiComponentBounds::LocationChanged) ? 1 : 0);
+      layoutStats.drawingToggleCount += 2;
+    }
+  }
+} // end RowLayoutPrivate::commitChangedBounds
+
+void RowLayoutPrivate::growAndAlignRow(RowLayout * thisRowLayout,
+                                       std::size_t rowIndex,
+                                       UiComponent * container)
+{
+  // Every row that is laid out again is grown and aligned once.
+  if(recordingLayoutStats)
+  {
+    ++layoutStats.rowsLaidOut;
+  }
+
+  // Note: Row width does not include the padding so take it out
+  const int remainingWidth = container->getClientWidth() - rows.at(rowIndex)->d->rowWidth -
+                             container->getLeftPadding() - container->getRightPadding();
+
+  if(growUiComponentsInRow(rowIndex, remainingWidth))
+  {
+    // The growers fill the row, so there is nothing left to align.
+    return;
+  }
+
+  if(rows.at(rowIndex)->d->rowOrientation == RowOrientation::RightRowOrientation)
+  {
+    applyRightRowAlignment(thisRowLayout,
+                           rowIndex,
+                           container->getClientWidth(),
+                           container->getLeftPadding(),
+                           container->getRightPadding());
+  }
+  else if(rows.at(rowIndex)->d->rowOrientation == RowOrientation::CenterRowOrientation)
+  {
+    applyCenterRowAlignment(thisRowLayout,
+                            rowIndex,
+                            container->getClientWidth(),
+                            container->getLeftPadding(),
+                            container->getRightPadding());
+  }
+} // end RowLayoutPrivate::growAndAlignRow
+
+void RowLayoutPrivate::postLayout(RowLayout * thisRowLayout, UiComponent * container)
+{
+  LayoutPhaseScope layoutPhaseScope(this, LayoutPhase::PostLayoutPhase);
+
+  // Apply the constant left padding if any.
+  const int initialXOffset = container->getLeftPadding();
+  int xOffset = initialXOffset;
+
+  // Apply the constant top padding if any.
+  int yOffset = container->getTopPadding();
+
+  // The height of the tallest uiComponent in the current row.
+  int heightOfTallestUiComponentInRow = 0;
+
+  int initialYOffset = container->getTopPadding();
+
+  // Take the container dimensions into account, by keeping a running
+  // tally of the size of its uiComponents and padding.
+  int containerWidth = container->getLeftPadding() + container->getRightPadding();
+
+  int containerHeight = container->getTopPadding() + container->getBottomPadding();
+
+  // Width of the largest row in the specified container.
+  // Note: the width of any given row is the following.
+  //
+  // xOffset - initialXOffset
+  int maxRowWidth = 0;
+
+  const int verticalSpaceBetweenRows = ::getVerticalSpaceBetweenRowsToPlatformIfNeeded(thisRowLayout->getVerticalSpaceBetweenRows(), layoutMetrics);
+
+  if(layoutThreadPool.getThreadCount() > 1 && rows.size() >= 2 * RowsPerLayoutTask)
+  {
+    layoutRowsInParallel(thisRowLayout,
+                         initialXOffset,
+                         initialYOffset,
+                         &containerHeight,
+                         &maxRowWidth);
+  }
+  else
+  {
+    for(std::size_t rowIndex = 0; rowIndex < thisRowLayout->getRowCount(); ++rowIndex)
+    {
+      RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+
+      if(rowLayoutRow->d->needsLayout)
+      {
+        layoutAllUiComponentsInRow(thisRowLayout,
+                                   rowIndex,
+                                   &xOffset,
+                                   &yOffset,
+                                   &heightOfTallestUiComponentInRow,
+                                   initialXOffset,
+                                   &initialYOffset,
+                                   &containerHeight,
+                                   &maxRowWidth,
+                                   rowIndex == 0);
+
+        rowLayoutRow->d->needsApply = true;
+      }
+      else
+      {
+        // This row keeps the geometry from the last layout pass. It only
+        // moves if the height of a row above it changed.
+        int rowTop = initialYOffset;
+
+        if(rowIndex > 0)
+        {
+          rowTop += verticalSpaceBetweenRows;
+        }
+
+        if(rowTop != rowLayoutRow->d->rowTop)
+        {
+          moveRowDown(rowIndex, rowTop - rowLayoutRow->d->rowTop);
+
+          rowLayoutRow->d->needsApply = true;
+        }
+
+        initialYOffset += rowLayoutRow->d->rowHeight;
+
+        maxRowWidth = std::max(maxRowWidth, rowLayoutRow->d->rowWidth);
+
+        containerHeight += rowLayoutRow->d->rowHeight;
+      }
+    }// end all rows loop
+  }
+
+  containerWidth += maxRowWidth;
+
+  // Now set the preferred size of the container
+  container->setPreferredSize(containerWidth, containerHeight);
+
+  // Now that the uiComponents are in place, grow the uiComponents that want
+  // the remaining space and apply orientation rules if any have been
+  // specified.
+  // Note: In a row layout, the uiComponents can grow wider independent of
+  //       other rows. However, height is constrained by the amount of rows
+  //       in the layout.
+  for(std::size_t rowIndex = 0; rowIndex < thisRowLayout->getRowCount(); ++rowIndex)
+  {
+    if(!rows.at(rowIndex)->d->needsLayout)
+    {
+      // Already grown and aligned during an earlier layout pass. Note that
+      // every row is laid out again when any uiComponent grows vertically.
+      continue;
+    }
+
+    growAndAlignRow(thisRowLayout, rowIndex, container);
+  }
+
+  if(growYCount > 0)
+  {
+    // Note: Nothing needs to be taken out of the height because the
+    //       container height already includes the padding.
+    growRowsVertically(container->getClientHeight() - containerHeight);
+  }
+
+  // Only the labels and uiComponents whose bounds differ from the bounds
+  // that were last applied to them are touched. Only rows that were laid out
+  // again or moved are looked at.
+  collectChangedBounds();
+
+  // Apply all the cached bounds in one step
+  commitChangedBounds(container);
+
+  for(std::size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
+  {
+    if(rows.at(rowIndex)->d->needsLayout)
+    {
+      updateRowOffsetIndex(rowIndex);
+    }
+
+    rows.at(rowIndex)->d->needsLayout = false;
+    rows.at(rowIndex)->d->needsApply = false;
+  }
+
+  rowOffsetOrigin = container->getTopPadding();
+  indexedEstimatedRowHeight = 0;
+} // end RowLayoutPrivate::postLayout
+
+static bool isLeftOf(const UiComponentBounds& left,
+                     const UiComponentBounds& right)
+{
+  return left.x < right.x;
+}
+
+// A label above or below its uiComponent may start left of the label or
+// uiComponent before it. The bounds are nearly sorted, so an insertion sort
+// keeps them stable without the buffer that std::stable_sort allocates.
+static void sortHitBounds(std::vector<UiComponentBounds> * hitBounds)
+{
+  for(std::size_t i = 1; i < hitBounds->size(); ++i)
+  {
+    const UiComponentBounds uiComponentBounds = (*hitBounds)[i];
+
+    std::size_t j = i;
+
+    for(; j > 0 && uiComponentBounds.x < (*hitBounds)[j - 1].x; --j)
+    {
+      (*hitBounds)[j] = (*hitBounds)[j - 1];
+    }
+
+    (*hitBounds)[j] = uiComponentBounds;
+  }
+}
+
+std::size_t RowLayoutPrivate::getUiComponentCount() const
+{
+  // The state of removed uiComponents is only dropped when the ids are
+  // compacted.
+  if(uiComponentIdsInRowOrder)
+  {
+    return uiComponentInternals.size();
+  }
+
+  std::size_t uiComponentCount = 0;
+
+  for(std::size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
+  {
+    uiComponentCount += rows.at(rowIndex)->getUiComponentCount();
+  }
+
+  return uiComponentCount;
+}
+
+void RowLayoutPrivate::countBufferGrowth(std::size_t requiredSize,
+                                         std::size_t capacity)
+{
+  // A buffer that is too small for requiredSize elements allocates a larger
+  // one.
+  if(recordingLayoutStats && requiredSize > capacity)
+  {
+    ++layoutStats.bufferGrowthCount;
+  }
+}
+
+void RowLayoutPrivate::addIndexedRowWidth(int width)
+{
+  const std::pair<std::map<int, std::size_t>::iterator, bool> inserted = indexedRowWidthCounts.insert(std::make_pair(width, static_cast<std::size_t>(0)));
+
+  // A width no other row has adds an entry to the map.
+  if(recordingLayoutStats && inserted.second)
+  {
+    ++layoutStats.bufferGrowthCount;
+  }
+
+  ++inserted.first->second;
+}
+
+void RowLayoutPrivate::addHitBounds(RowLayout::Row * row,
+                                    UiComponent * uiComponent,
+                                    int x,
+                                    int y,
+                                    int width,
+                                    int height)
+{
+  UiComponentBounds uiComponentBounds;
+  uiComponentBounds.uiComponent = uiComponent;
+  uiComponentBounds.x = x;
+  uiComponentBounds.y = y - row->d->rowTop;
+  uiComponentBounds.width = width;
+  uiComponentBounds.height = height;
+  uiComponentBounds.changed = 0;
+
+  countBufferGrowth(row->d->hitBounds.size() + 1, row->d->hitBounds.capacity());
+
+  row->d->hitBounds.push_back(uiComponentBounds);
+
+  row->d->widestHitBounds = std::max(row->d->widestHitBounds, width);
+}
+
+void RowLayoutPrivate::setIndexedRowExtent(std::size_t rowIndex,
+                                           int height,
+                                           int width)
+{
+  RowLayout::Row::RowPrivate * rowPrivate = rows.at(rowIndex)->d;
+
+  rowOffsetIndex.setHeight(rowIndex, height);
+
+  // Rows without uiComponents have next to no height, so they are left out
+  // of the estimated row height.
+  const bool inEstimate = rows.at(rowIndex)->getUiComponentCount() > 0;
+
+  if(rowPrivate->indexed)
+  {
+    if(rowPrivate->indexedInEstimate)
+    {
+      indexedRowHeightSum -= rowPrivate->indexedHeight;
+      --indexedRowHeightCount;
+    }
+
+    // Most rows keep their width, which keeps the map as it is.
+    if(rowPrivate->indexedWidth != width)
+    {
+      std::map<int, std::size_t>::iterator it = indexedRowWidthCounts.find(rowPrivate->indexedWidth);
+
+      if(--it->second == 0)
+      {
+        indexedRowWidthCounts.erase(it);
+      }
+
+      addIndexedRowWidth(width);
+    }
+  }
+  else
+  {
+    addIndexedRowWidth(width);
+  }
+
+  if(inEstimate)
+  {
+    indexedRowHeightSum += height;
+    ++indexedRowHeightCount;
+  }
+
+  rowPrivate->indexed = true;
+  rowPrivate->indexedInEstimate = inEstimate;
+  rowPrivate->indexedHeight = height;
+  rowPrivate->indexedWidth = width;
+} // end RowLayoutPrivate::setIndexedRowExtent
+
+void RowLayoutPrivate::forgetIndexedRowExtent(std::size_t rowIndex)
+{
+  RowLayout::Row::RowPrivate * rowPrivate = rows.at(rowIndex)->d;
+
+  rowOffsetIndex.setUnknown(rowIndex);
+
+  if(!rowPrivate->indexed)
+  {
+    return;
+  }
+
+  if(rowPrivate->indexedInEstimate)
+  {
+    indexedRowHeightSum -= rowPrivate->indexedHeight;
+    --indexedRowHeightCount;
+  }
+
+  std::map<int, std::size_t>::iterator it = indexedRowWidthCounts.find(rowPrivate->indexedWidth);
+
+  if(--it->second == 0)
+  {
+    indexedRowWidthCounts.erase(it);
+  }
+
+  rowPrivate->indexed = false;
+  rowPrivate->indexedInEstimate = false;
+} // end RowLayoutPrivate::forgetIndexedRowExtent
+
+// Record the height and the bounds of the uiComponents of a row that was just
+// laid out.
+void RowLayoutPrivate::updateRowOffsetIndex(std::size_t rowIndex)
+{
+  RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+
+  setIndexedRowExtent(rowIndex,
+                      rowLayoutRow->d->rowHeight + rowLayoutRow->d->rowGrowth,
+                      rowLayoutRow->d->rowWidth);
+
+  rowLayoutRow->d->hitBounds.clear();
+  rowLayoutRow->d->widestHitBounds = 0;
+
+  const std::size_t firstId = rowLayoutRow->d->firstUiComponentId;
+  const std::size_t endId = firstId + rowLayoutRow->getUiComponentCount();
+
+  for(std::size_t id = firstId; id < endId; ++id)
+  {
+    if(uiComponentInternals.labelPeer[id])
+    {
+      addHitBounds(rowLayoutRow,
+                   uiComponentInternals.labelPeer[id],
+                   uiComponentInternals.labelX[id],
+                   uiComponentInternals.labelY[id],
+                   uiComponentInternals.labelPreferredWidth[id],
+                   uiComponentInternals.labelPreferredHeight[id]);
+    }
+
+    addHitBounds(rowLayoutRow,
+                 uiComponentInternals.uiComponent[id],
+                 uiComponentInternals.uiComponentX[id],
+                 uiComponentInternals.uiComponentY[id],
+                 uiComponentInternals.uiComponentPreferredWidth[id],
+                 uiComponentInternals.uiComponentPreferredHeight[id]);
+  }
+
+  ::sortHitBounds(&rowLayoutRow->d->hitBounds);
+} // end RowLayoutPrivate::updateRowOffsetIndex
+
+int RowLayoutPrivate::getRowTop(std::size_t rowIndex) const
+{
+  int rowTop = rowOffsetOrigin + rowOffsetIndex.getOffset(rowIndex, indexedEstimatedRowHeight);
+
+  if(rowIndex > 0)
+  {
+    rowTop += ::getVerticalSpaceBetweenRowsToPlatformIfNeeded(verticalSpaceBetweenRows, layoutMetrics);
+  }
+
+  return rowTop;
+}
+
+// The state shared by the tasks of RowLayoutPrivate::layoutRowsInParallel.
+// Each task owns the rows [taskIndex * RowsPerLayoutTask,
+// (taskIndex + 1) * RowsPerLayoutTask).
+struct ParallelRowLayout
+{
+    RowLayoutPrivate * rowLayoutPrivate;
+    RowLayout * thisRowLayout;
+    int initialXOffset;
+    int verticalSpaceBetweenRows;
+
+    // The total height and the widest row of the rows of each task.
+    std::vector<int> taskHeight;
+    std::vector<int> taskMaxRowWidth;
+
+    // The y-offset at which the rows of each task start.
+    std::vector<int> taskYOffset;
+};
+
+// Lay out the rows of a task that need it as if each started at y-offset 0
+// and add up the heights of all rows of the task.
+void RowLayoutPrivate::layoutRowsOfTask(std::size_t taskIndex,
+                                        ParallelRowLayout * parallelRowLayout)
+{
+  int taskHeight = 0;
+  int taskMaxRowWidth = 0;
+
+  const std::size_t endRowIndex = std::min(rows.size(), (taskIndex + 1) * RowsPerLayoutTask);
+
+  for(std::size_t rowIndex = taskIndex * RowsPerLayoutTask; rowIndex < endRowIndex; ++rowIndex)
+  {
+    RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+
+    if(rowLayoutRow->d->needsLayout)
+    {
+      int xOffset = 0;
+      int yOffset = 0;
+      int heightOfTallestUiComponentInRow = 0;
+      int initialYOffset = 0;
+      int containerHeight = 0;
+      int maxRowWidth = 0;
+
+      layoutAllUiComponentsInRow(parallelRowLayout->thisRowLayout,
+                                 rowIndex,
+                                 &xOffset,
+                                 &yOffset,
+                                 &heightOfTallestUiComponentInRow,
+                                 parallelRowLayout->initialXOffset,
+                                 &initialYOffset,
+                                 &containerHeight,
+                                 &maxRowWidth,
+                                 rowIndex == 0);
+    }
+
+    taskHeight += rowLayoutRow->d->rowHeight;
+    taskMaxRowWidth = std::max(taskMaxRowWidth, rowLayoutRow->d->rowWidth);
+  }
+
+  parallelRowLayout->taskHeight.at(taskIndex) = taskHeight;
+  parallelRowLayout->taskMaxRowWidth.at(taskIndex) = taskMaxRowWidth;
+} // end RowLayoutPrivate::layoutRowsOfTask
+
+// Move the rows of a task to their final y-offsets.
+void RowLayoutPrivate::placeRowsOfTask(std::size_t taskIndex,
+                                       ParallelRowLayout * parallelRowLayout)
+{
+  int yOffset = parallelRowLayout->taskYOffset.at(taskIndex);
+
+  const std::size_t endRowIndex = std::min(rows.size(), (taskIndex + 1) * RowsPerLayoutTask);
+
+  for(std::size_t rowIndex = taskIndex * RowsPerLayoutTask; rowIndex < endRowIndex; ++rowIndex)
+  {
+    RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+
+    if(rowLayoutRow->d->needsLayout)
+    {
+      // Laid out at y-offset 0 by layoutRowsOfTask.
+      moveRowDown(rowIndex, yOffset);
+
+      rowLayoutRow->d->needsApply = true;
+    }
+    else
+    {
+      // This row keeps the geometry from the last layout pass. It only
+      // moves if the height of a row above it changed.
+      int rowTop = yOffset;
+
+      if(rowIndex > 0)
+      {
+        rowTop += parallelRowLayout->verticalSpaceBetweenRows;
+      }
+
+      if(rowTop != rowLayoutRow->d->rowTop)
+      {
+        moveRowDown(rowIndex, rowTop - rowLayoutRow->d->rowTop);
+
+        rowLayoutRow->d->needsApply = true;
+      }
+    }
+
+    yOffset += rowLayoutRow->d->rowHeight;
+  }
+} // end RowLayoutPrivate::placeRowsOfTask
+
+static void layoutRowsTask(std::size_t taskIndex, void * userData)
+{
+  ParallelRowLayout * parallelRowLayout = static_cast<ParallelRowLayout *>(userData);
+
+  parallelRowLayout->rowLayoutPrivate->layoutRowsOfTask(taskIndex, parallelRowLayout);
+}
+
+static void placeRowsTask(std::size_t taskIndex, void * userData)
+{
+  ParallelRowLayout * parallelRowLayout = static_cast<ParallelRowLayout *>(userData);
+
+  parallelRowLayout->rowLayoutPrivate->placeRowsOfTask(taskIndex, parallelRowLayout);
+}
+
+// The same as the all rows loop of postLayout, but the rows are split into
+// tasks that run on the threads of layoutThreadPool.
+//
+// The x-offsets of a row only depend on the row, only the y-offsets depend
+// on the rows above it. So the rows are first laid out as if each started at
+// y-offset 0, then the heights of the rows are summed up to find where each
+// row starts and finally every row is moved down to where it starts. Adding
+// the start of a row afterwards gives the same offsets as starting from it.
+void RowLayoutPrivate::layoutRowsInParallel(RowLayout * thisRowLayout,
+                                            int initialXOffset,
+                                            int initialYOffset,
+                                            int * containerHeight,
+                                            int * maxRowWidth)
+{
+  // Accessing a row by index closes the holes left by removed uiComponents,
+  // so close them before the rows are shared between threads.
+  for(std::size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
+  {
+    rows.at(rowIndex)->d->compactUiComponents();
+  }
+
+  const std::size_t taskCount = (rows.size() + RowsPerLayoutTask - 1) / RowsPerLayoutTask;
+
+  ParallelRowLayout parallelRowLayout;
+  parallelRowLayout.rowLayoutPrivate = this;
+  parallelRowLayout.thisRowLayout = thisRowLayout;
+  parallelRowLayout.initialXOffset = initialXOffset;
+  parallelRowLayout.verticalSpaceBetweenRows = ::getVerticalSpaceBetweenRowsToPlatformIfNeeded(verticalSpaceBetweenRows, layoutMetrics);
+
+  // The per task results are allocated for every parallel layout pass.
+  countBufferGrowth(taskCount, parallelRowLayout.taskHeight.capacity());
+  countBufferGrowth(taskCount, parallelRowLayout.taskMaxRowWidth.capacity());
+  countBufferGrowth(taskCount, parallelRowLayout.taskYOffset.capacity());
+
+  parallelRowLayout.taskHeight.resize(taskCount, 0);
+  parallelRowLayout.taskMaxRowWidth.resize(taskCount, 0);
+  parallelRowLayout.taskYOffset.resize(taskCount, 0);
+
+  layoutThreadPool.run(taskCount, &::layoutRowsTask, &parallelRowLayout);
+
+  // Each task starts where the rows of the tasks before it end. There is
+  // only one sum per task, so this is cheap compared to the tasks.
+  int yOffset = initialYOffset;
+
+  for(std::size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+  {
+    parallelRowLayout.taskYOffset.at(taskIndex) = yOffset;
+
+    yOffset += parallelRowLayout.taskHeight.at(taskIndex);
+
+    *maxRowWidth = std::max(*maxRowWidth, parallelRowLayout.taskMaxRowWidth.at(taskIndex));
+  }
+
+  *containerHeight += yOffset - initialYOffset;
+
+  layoutThreadPool.run(taskCount, &::placeRowsTask, &parallelRowLayout);
+} // end RowLayoutPrivate::layoutRowsInParallel
+
+void RowLayoutPrivate::layoutAllUiComponentsInRow(RowLayout * thisRowLayout,
+                                                  std::size_t rowIndex,
+                                                  int * xOffset,
+                                                  int * yOffset,
+                                                  int * heightOfTallestUiComponentInRow,
+                                                  int initialXOffset,
+                                                  int * initialYOffset,
+                                                  int * containerHeight,
+                                                  int * maxRowWidth,
+                                                  bool isFirstRow)
+{
+  // Reset the x-offset for the new row.
+  *xOffset = initialXOffset;
+
+  if(!isFirstRow)
+  {
+    // Adjust the y-offset for the new row.
+    *yOffset = *initialYOffset;
+  }
+
+  // We've added the last row's tallest uiComponent's height so reset the
+  // offset so we can calculate the height of the tallest uiComponent in
+  // the next row.
+  *heightOfTallestUiComponentInRow = 0;
+
+  std::size_t uiComponentIndex = 0;
+
+  if(!isFirstRow)
+  {
+    // Also add in the vertical gap between rows.
+    *yOffset += ::getVerticalSpaceBetweenRowsToPlatformIfNeeded(thisRowLayout->getVerticalSpaceBetweenRows(), layoutMetrics);
+  }
+
+  rows.at(rowIndex)->d->rowTop = *yOffset;
+
+  // Start Fencepost block. We need the fencepost here in order to handle
+  // gaps between uiComponents in a row.
+
+  // there is at least one uiComponent in this row
+  if(thisRowLayout->getUiComponentCountAtRow(rowIndex) > 0)
+  {
+    layoutUiComponentInRow(thisRowLayout,
+                           rowIndex,
+                           uiComponentIndex,
+                           xOffset,
+                           yOffset,
+                           heightOfTallestUiComponentInRow,
+                           false);
+  }
+  // End Fencepost block
+
+  ++uiComponentIndex;
+
+  // Check for all of the uiComponents in the current row.
+  for(; uiComponentIndex < thisRowLayout->getUiComponentCountAtRow(rowIndex); ++uiComponentIndex)
+  {
+    layoutUiComponentInRow(thisRowLayout,
+                           rowIndex,
+                           uiComponentIndex,
+                           xOffset,
+                           yOffset,
+                           heightOfTallestUiComponentInRow,
+                           true);
+  }// end current row loop
+
+  // The labels beside and below the uiComponents were accounted for while
+  // placing them, the uiComponents are one packed range.
+  const std::size_t firstId = rows.at(rowIndex)->d->firstUiComponentId;
+
+  *heightOfTallestUiComponentInRow = ::getLayoutKernels().getMaxValue(uiComponentInternals.uiComponentPreferredHeight.data() + firstId,
+                                                                      thisRowLayout->getUiComponentCountAtRow(rowIndex),
+                                                                      *heightOfTallestUiComponentInRow);
+
+  // For each row, we need to check its previous and next label row
+  // pointer, if they are valid, offset the yOffset by the height of the
+  // tallest label in each valid label row. The check is here instead of
+  // earlier so that we ensure at least one uiComponent is in the current
+  // row.
+  if(rows.at(rowIndex)->d->previousLabelRow)
+  {
+    *yOffset += rows.at(rowIndex)->d->previousLabelRow->maxHeightLabelInRow;
+  }
+
+  if(rows.at(rowIndex)->d->nextLabelRow)
+  {
+    *yOffset += rows.at(rowIndex)->d->nextLabelRow->maxHeightLabelInRow;
+  }
+
+  rows.at(rowIndex)->d->rowWidth = *xOffset - initialXOffset;
+  rows.at(rowIndex)->d->rowHeight = (*yOffset + *heightOfTallestUiComponentInRow) - *initialYOffset;
+  rows.at(rowIndex)->d->rowGrowth = 0;
+  rows.at(rowIndex)->d->laidOut = true;
+
+  *initialYOffset += rows.at(rowIndex)->d->rowHeight;
+
+  *maxRowWidth = std::max(*maxRowWidth, rows.at(rowIndex)->d->rowWidth);
+
+  *containerHeight += rows.at(rowIndex)->d->rowHeight;
+}
+
+// Returns the height that is assumed for the rows that were never laid out,
+// the space above each row included, or -1 if nothing is known yet.
+int RowLayoutPrivate::getEstimatedRowHeight()
+{
+  if(estimatedRowHeight > 0)
+  {
+    return estimatedRowHeight;
+  }
+
+  // Otherwise assume the average height of the rows that were laid out.
+  if(indexedRowHeightCount == 0)
+  {
+    return -1;
+  }
+
+  return std::max(static_cast<int>(indexedRowHeightSum / static_cast<long long>(indexedRowHeightCount)), 1);
+} // end RowLayoutPrivate::getEstimatedRowHeight
+
+// Find the rows [firstRowIndex, endRowIndex) that intersect the viewport,
+// using the real height of the rows that were laid out and the estimated
+// height of the others.
+void RowLayoutPrivate::findRowsInViewport(int initialYOffset,
+                                          std::size_t * firstRowIndex,
+                                          std::size_t * endRowIndex)
+{
+  *firstRowIndex = rows.size();
+  *endRowIndex = rows.size();
+
+  const int estimatedHeight = getEstimatedRowHeight();
+
+  if(estimatedHeight < 0)
+  {
+    // Lay out the first row that was never laid out to learn the height of
+    // a row.
+    for(std::size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
+    {
+      if(!rows.at(rowIndex)->d->laidOut)
+      {
+        *firstRowIndex = rowIndex;
+        *endRowIndex = rowIndex + 1;
+
+        return;
+      }
+    }
+  }
+
+  const int viewportBottom = viewportY + viewportHeight;
+
+  // The first row that ends below the top of the viewport.
+  const std::size_t rowIndex = viewportY < initialYOffset ? 0 : rowOffsetIndex.find(viewportY - initialYOffset, estimatedHeight);
+
+  if(rowIndex == rows.size())
+  {
+    // The viewport is below the last row.
+    return;
+  }
+
+  int yOffset = initialYOffset + rowOffsetIndex.getOffset(rowIndex, estimatedHeight);
+
+  if(yOffset >= viewportBottom)
+  {
+    return;
+  }
+
+  *firstRowIndex = rowIndex;
+  *endRowIndex = rowIndex;
+
+  for(; *endRowIndex < rows.size() && yOffset < viewportBottom; ++*endRowIndex)
+  {
+    const RowLayout::Row * rowLayoutRow = rows.at(*endRowIndex);
+
+    yOffset += rowLayoutRow->d->indexed ? rowLayoutRow->d->indexedHeight : estimatedHeight;
+  }
+} // end RowLayoutPrivate::findRowsInViewport
+
+// The layout pass used while a viewport is set. Only the rows that intersect
+// the viewport are measured, laid out and applied. Every other row keeps the
+// bounds it was last given and takes up its last height, or the estimated
+// height if it was never laid out, until it scrolls into view.
+//
+// The real height of a row is only known once it is laid out, which may
+// bring other rows into view. So the rows in view are laid out until every
+// row in view is up to date.
+void RowLayoutPrivate::layoutViewport(RowLayout * thisRowLayout, UiComponent * container)
+{
+  const int initialXOffset = container->getLeftPadding();
+  const int initialYOffset = container->getTopPadding();
+
+  std::size_t firstRowIndex = 0;
+  std::size_t endRowIndex = 0;
+
+  viewportRowIndices.clear();
+
+  for(;;)
+  {
+    findRowsInViewport(initialYOffset, &firstRowIndex, &endRowIndex);
+
+    bool rowsNeedLayout = false;
+
+    for(std::size_t rowIndex = firstRowIndex; rowIndex < endRowIndex; ++rowIndex)
+    {
+      if(!rows.at(rowIndex)->d->laidOut)
+      {
+        rows.at(rowIndex)->d->needsLayout = true;
+      }
+
+      rowsNeedLayout = rowsNeedLayout || rows.at(rowIndex)->d->needsLayout;
+    }
+
+    if(!rowsNeedLayout)
+    {
+      break;
+    }
+
+    // The same stages as a full layout pass, restricted to the rows in view.
+    measureUiComponents(firstRowIndex, endRowIndex);
+
+    for(std::size_t rowIndex = firstRowIndex; rowIndex < endRowIndex; ++rowIndex)
+    {
+      if(rows.at(rowIndex)->d->needsLayout)
+      {
+        resetUiComponentsInRow(rows.at(rowIndex));
+      }
+    }
+
+    // Note: The size groups only know the sizes of the members that were
+    //       measured so far.
+    markRowsOfChangedSizeGroups();
+
+    for(std::size_t rowIndex = firstRowIndex; rowIndex < endRowIndex; ++rowIndex)
+    {
+      if(rows.at(rowIndex)->d->needsLayout)
+      {
+        resizeUiComponentsInRowToSizeGroups(rows.at(rowIndex));
+      }
+    }
+
+    resizeLabelRows(firstRowIndex, endRowIndex);
+
+    for(std::size_t rowIndex = firstRowIndex; rowIndex < endRowIndex; ++rowIndex)
+    {
+      RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+
+      if(!rowLayoutRow->d->needsLayout)
+      {
+        continue;
+      }
+
+      // Lay out the row as if it started at y-offset 0, it is moved to where
+      // it starts below.
+      int xOffset = 0;
+      int yOffset = 0;
+      int heightOfTallestUiComponentInRow = 0;
+      int rowYOffset = 0;
+      int rowContainerHeight = 0;
+      int rowMaxRowWidth = 0;
+
+      layoutAllUiComponentsInRow(thisRowLayout,
+                                 rowIndex,
+                                 &xOffset,
+                                 &yOffset,
+                                 &heightOfTallestUiComponentInRow,
+                                 initialXOffset,
+                                 &rowYOffset,
+                                 &rowContainerHeight,
+                                 &rowMaxRowWidth,
+                                 rowIndex == 0);
+
+      growAndAlignRow(thisRowLayout, rowIndex, container);
+
+      updateRowOffsetIndex(rowIndex);
+
+      rowLayoutRow->d->needsLayout = false;
+      rowLayoutRow->d->needsApply = true;
+
+      countBufferGrowth(viewportRowIndices.size() + 1, viewportRowIndices.capacity());
+
+      viewportRowIndices.push_back(rowIndex);
+    }
+  }
+
+  rowOffsetOrigin = initialYOffset;
+  indexedEstimatedRowHeight = std::max(getEstimatedRowHeight(), 0);
+
+  // Only the rows in view and the rows laid out during this layout pass are
+  // moved to where they start, every other row keeps its bounds.
+  for(std::size_t rowIndex = firstRowIndex; rowIndex < endRowIndex; ++rowIndex)
+  {
+    countBufferGrowth(viewportRowIndices.size() + 1, viewportRowIndices.capacity());
+
+    viewportRowIndices.push_back(rowIndex);
+  }
+
+  std::sort(viewportRowIndices.begin(), viewportRowIndices.end());
+  viewportRowIndices.erase(std::unique(viewportRowIndices.begin(), viewportRowIndices.end()), viewportRowIndices.end());
+
+  changedBounds.clear();
+
+  for(std::size_t i = 0; i < viewportRowIndices.size(); ++i)
+  {
+    const std::size_t rowIndex = viewportRowIndices.at(i);
+
+    RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+
+    if(rowLayoutRow->d->needsLayout)
+    {
+      // A size group changed after this row was laid out and it is out of
+      // view now, so it keeps its old bounds until it is in view again.
+      rowLayoutRow->d->needsApply = false;
+
+      continue;
+    }
+
+    const int rowTop = getRowTop(rowIndex);
+
+    if(rowTop != rowLayoutRow->d->rowTop)
+    {
+      moveRowDown(rowIndex, rowTop - rowLayoutRow->d->rowTop);
+
+      rowLayoutRow->d->needsApply = true;
+    }
+
+    if(rowLayoutRow->d->needsApply)
+    {
+      collectChangedBoundsInRow(rowLayoutRow);
+
+      rowLayoutRow->d->needsApply = false;
+    }
+  }
+
+  // The rows out of view take up their last height or the estimated height.
+  const int maxRowWidth = indexedRowWidthCounts.empty() ? 0 : std::max(indexedRowWidthCounts.rbegin()->first, 0);
+
+  container->setPreferredSize(container->getLeftPadding() + container->getRightPadding() + maxRowWidth,
+                              container->getBottomPadding() + initialYOffset + rowOffsetIndex.getOffset(rows.size(), indexedEstimatedRowHeight));
+
+  commitChangedBounds(container);
+} // end RowLayoutPrivate::layoutViewport
+
+// Returns the gap on one side of a uiComponent as getUiComponentGap sees it
+// once resetUiComponentsInRow has filled in the unspecified gaps. Used when
+// measuring, which must not rely on the gaps cached in uiComponentInternals.
+static int getMeasuredGap(int horizontalGap,
+                          const LayoutMetrics * layoutMetrics)
+{
+  if(horizontalGap < 0)
+  {
+    return layoutMetrics->horizontalGap; // TODO: Factor in related/unrelated
+  }
+
+  if(horizontalGap == 0)
+  {
+    // A gap of 0 is left unspecified in uiComponentInternals.
+    return -1;
+  }
+
+  return horizontalGap;
+}
+
+// Returns the gap between the specified uiComponents the way
+// getUiComponentGap would, not counting the horizontal space of the row.
+static int getMeasuredGap(const UiComponentConstraints * previousConstraints,
+                          const UiComponentConstraints * currentConstraints,
+                          const LayoutMetrics * layoutMetrics)
+{
+  return std::max(::getMeasuredGap(previousConstraints->horizontalGapRight, layoutMetrics),
+                  ::getMeasuredGap(currentConstraints->horizontalGapLeft, layoutMetrics));
+}
+
+void RowLayoutPrivate::getMeasuredSizes(UiComponentWrapper * uiComponentWrapper,
+                                        int * uiComponentWidth,
+                                        int * uiComponentHeight,
+                                        int * labelWidth,
+                                        int * labelHeight)
+{
+  const UiComponentConstraints * constraints = uiComponentWrapper->uiComponentConstraints;
+  const std::size_t id = uiComponentWrapper->id;
+
+  *uiComponentWidth = uiComponentInternals.uiComponentMeasuredWidth[id];
+  *uiComponentHeight = uiComponentInternals.uiComponentMeasuredHeight[id];
+
+  if(constraints->sizeGroupId >= 0)
+  {
+    const SizeGroup& sizeGroup = sizeGroups.at(uiComponentWrapper->sizeGroupIndex);
+
+    *uiComponentWidth = sizeGroup.getMaxWidth();
+    *uiComponentHeight = sizeGroup.getMaxHeight();
+  }
+
+  *labelWidth = 0;
+  *labelHeight = 0;
+
+  if(!uiComponentWrapper->labelPeer)
+  {
+    return;
+  }
+
+  *labelWidth = uiComponentInternals.labelMeasuredWidth[id];
+  *labelHeight = uiComponentInternals.labelMeasuredHeight[id];
+
+  if(constraints->labelSizeGroupId >= 0)
+  {
+    const SizeGroup& sizeGroup = sizeGroups.at(uiComponentWrapper->labelSizeGroupIndex);
+
+    *labelWidth = sizeGroup.getMaxWidth();
+    *labelHeight = sizeGroup.getMaxHeight();
+  }
+} // end RowLayoutPrivate::getMeasuredSizes
+
+// Computes the width and the height of the specified row the way
+// layoutAllUiComponentsInRow would, from the measured sizes and the max sizes
+// of the size groups. Nothing in this layout is changed.
+void RowLayoutPrivate::measureRow(std::size_t rowIndex,
+                                  int * rowWidth,
+                                  int * rowHeight)
+{
+  RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+
+  int xOffset = 0;
+  int heightOfTallestUiComponentInRow = 0;
+  int previousLabelRowHeight = 0;
+  int nextLabelRowHeight = 0;
+
+  for(std::size_t uiComponentIndex = 0; uiComponentIndex < rowLayoutRow->getUiComponentCount(); ++uiComponentIndex)
+  {
+    UiComponentWrapper * uiComponentWrapper = rowLayoutRow->d->getUiComponentWrapperAt(uiComponentIndex);
+    const UiComponentConstraints * constraints = uiComponentWrapper->uiComponentConstraints;
+
+    if(uiComponentIndex > 0)
+    {
+      xOffset += static_cast<int>(rowLayoutRow->d->horizontalSpaceBetweenUiComponents);
+      xOffset += ::getMeasuredGap(rowLayoutRow->d->getUiComponentConstraintsAt(uiComponentIndex - 1),
+                                  constraints,
+                                  layoutMetrics);
+    }
+
+    int uiComponentWidth = 0;
+    int uiComponentHeight = 0;
+    int labelWidth = 0;
+    int labelHeight = 0;
+
+    getMeasuredSizes(uiComponentWrapper, &uiComponentWidth, &uiComponentHeight, &labelWidth, &labelHeight);
+
+    xOffset += uiComponentWidth;
+    heightOfTallestUiComponentInRow = std::max(heightOfTallestUiComponentInRow, uiComponentHeight);
+
+    if(!uiComponentWrapper->labelPeer)
+    {
+      continue;
+    }
+
+    switch(constraints->labelOrientation)
+    {
+      case LabelOrientation::TopOrientation:
+      {
+        previousLabelRowHeight = std::max(previousLabelRowHeight, labelHeight);
+        break;
+      }
+      case LabelOrientation::BottomOrientation:
+      {
+        nextLabelRowHeight = std::max(nextLabelRowHeight, labelHeight);
+        heightOfTallestUiComponentInRow = std::max(heightOfTallestUiComponentInRow, labelHeight);
+        break;
+      }
+      default:
+      {
+        // Labels to the left or right sit within the row.
+        xOffset += labelWidth;
+        heightOfTallestUiComponentInRow = std::max(heightOfTallestUiComponentInRow, labelHeight);
+        break;
+      }
+    }
+  }
+
+  *rowWidth = xOffset;
+  *rowHeight = previousLabelRowHeight + nextLabelRowHeight + heightOfTallestUiComponentInRow;
+
+  if(rowIndex > 0)
+  {
+    *rowHeight += ::getVerticalSpaceBetweenRowsToPlatformIfNeeded(verticalSpaceBetweenRows, layoutMetrics);
+  }
+} // end RowLayoutPrivate::measureRow
+
+void RowLayoutPrivate::measure(int availableWidth,
+                               LayoutMeasurement * layoutMeasurement)
+{
+  // measureRow walks the ids of each row as a contiguous range.
+  if(!uiComponentIdsInRowOrder)
+  {
+    compactUiComponentIds();
+  }
+
+  // Only the uiComponents that were invalidated are asked for their
+  // preferred size, the rest use the sizes cached by earlier layout passes.
+  // The results are cached for the next layout pass.
+  measureUiComponents(0, rows.size());
+
+  // A row whose geometry is still valid keeps the width and the height from
+  // the last layout pass, unless a size group it is part of changed.
+  const bool reuseRowSizes = !verticalSpaceBetweenRowsChanged && growYCount == 0 && !grewVertically;
+
+  std::vector<unsigned char> rowChanged(rows.size(), 0);
+
+  for(std::size_t i = 0; i < changedSizeGroups.size(); ++i)
+  {
+    const SizeGroup& sizeGroup = sizeGroups.at(changedSizeGroups.at(i));
+
+    if(sizeGroup.lastMaxWidth != sizeGroup.getMaxWidth() ||
+       sizeGroup.lastMaxHeight != sizeGroup.getMaxHeight())
+    {
+      for(std::size_t slot = 0; slot < sizeGroup.getMemberCount(); ++slot)
+      {
+        rowChanged.at(sizeGroup.getUiComponentWrapperAt(slot)->row->d->rowIndex) = 1;
+      }
+    }
+  }
+
+  const int leftPadding = rowLayoutContainer->getLeftPadding();
+  const int rightPadding = rowLayoutContainer->getRightPadding();
+  const int verticalSpace = ::getVerticalSpaceBetweenRowsToPlatformIfNeeded(verticalSpaceBetweenRows, layoutMetrics);
+
+  int yOffset = rowLayoutContainer->getTopPadding();
+  int maxRowWidth = 0;
+
+  layoutMeasurement->rowExtents.resize(rows.size());
+
+  for(std::size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
+  {
+    RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+
+    int rowWidth = rowLayoutRow->d->rowWidth;
+    int rowHeight = rowLayoutRow->d->rowHeight;
+
+    if(!reuseRowSizes || rowLayoutRow->d->needsLayout || rowChanged.at(rowIndex))
+    {
+      measureRow(rowIndex, &rowWidth, &rowHeight);
+    }
 
-    // handle vertical alignment if any
-    handleVerticalAlignment(uiComponentWrapper, &yLabelVAlignmentOffset, &yUiComponentPeerVAlignmentOffset);
+    RowExtent& rowExtent = layoutMeasurement->rowExtents.at(rowIndex);
 
-    uiComponentWrapper->uiComponentInternals->labelY = *yOffset + finalUiComponentYOffset;
+    rowExtent.x = leftPadding;
+    rowExtent.y = yOffset;
+    rowExtent.width = rowWidth;
+    rowExtent.height = rowHeight;
 
-    uiComponentRowXOffset += uiComponentWrapper->uiComponentInternals->labelPreferredWidth;
+    if(rowIndex > 0)
+    {
+      rowExtent.y += verticalSpace;
+      rowExtent.height -= verticalSpace;
+    }
 
-    *heightOfTallestUiComponentInRow = std::max(*heightOfTallestUiComponentInRow, uiComponentWrapper->uiComponentInternals->labelPreferredHeight);
+    yOffset += rowHeight;
+    maxRowWidth = std::max(maxRowWidth, rowWidth);
   }
 
-  finalUiComponentYOffset += uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight;
-
-  // 3) Handle labels on the bottom.
+  layoutMeasurement->preferredWidth = leftPadding + rightPadding + maxRowWidth;
+  layoutMeasurement->preferredHeight = yOffset + rowLayoutContainer->getBottomPadding();
 
-  if(uiComponentWrapper->labelPeer &&
-      uiComponentWrapper->uiComponentConstraints->labelOrientation == LabelOrientation::BottomOrientation)
+  if(availableWidth < 0)
   {
-    // this is a label from the uiComponent/label pair
-    uiComponentWrapper->uiComponentInternals->labelX = *xOffset;
-    uiComponentWrapper->uiComponentInternals->labelY = *yOffset + finalUiComponentYOffset;
-
-    *heightOfTallestUiComponentInRow = std::max(*heightOfTallestUiComponentInRow, uiComponentWrapper->uiComponentInternals->labelPreferredHeight);
+    return;
   }
 
-  // Adjust the xOffset
-  *xOffset += uiComponentRowXOffset;
-} // end RowLayoutPrivate::layoutUiComponentInRow
+  // Fit the rows into the available width the way postLayout would, growing
+  // or aligning the rows that are narrower than the available width.
+  const int clientWidth = availableWidth - leftPadding - rightPadding;
 
-void RowLayoutPrivate::moveUiComponentsInRowRight(std::size_t rowIndex,
-                                                  std::size_t uiComponentIndex,
-                                                  int remainingWidth)
-{
-  for(; uiComponentIndex < rows.at(rowIndex)->getUiComponentCount(); ++uiComponentIndex)
+  for(std::size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
   {
-    UiComponentWrapper * uiComponentWrapper = rows.at(rowIndex)->d->getUiComponentWrapperAt(uiComponentIndex);
+    RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+    RowExtent& rowExtent = layoutMeasurement->rowExtents.at(rowIndex);
 
-    uiComponentWrapper->uiComponentInternals->uiComponentX = uiComponentWrapper->uiComponentInternals->uiComponentX + remainingWidth;
-  }
-} // end RowLayoutPrivate::moveUiComponentsInRowRight
+    const int remainingWidth = clientWidth - rowExtent.width;
 
-void RowLayoutPrivate::moveUiComponentsBelowDown(std::size_t rowIndex,
-                                                 int remainingHeight)
-{
-  for(; rowIndex < rows.size(); ++rowIndex)
-  {
-    for(std::size_t uiComponentIndex = 0; uiComponentIndex < rows.at(rowIndex)->getUiComponentCount(); ++uiComponentIndex)
+    if(remainingWidth <= 0)
+    {
+      continue;
+    }
+
+    bool growsHorizontally = false;
+
+    for(std::size_t uiComponentIndex = 0; uiComponentIndex < rowLayoutRow->getUiComponentCount(); ++uiComponentIndex)
     {
-      UiComponentWrapper * uiComponentWrapper = rows.at(rowIndex)->d->getUiComponentWrapperAt(uiComponentIndex);
+      if(rowLayoutRow->d->getUiComponentConstraintsAt(uiComponentIndex)->growX > 0)
+      {
+        growsHorizontally = true;
+        break;
+      }
+    }
 
-      uiComponentWrapper->uiComponentInternals->uiComponentY = uiComponentWrapper->uiComponentInternals->uiComponentY + remainingHeight;
+    if(growsHorizontally)
+    {
+      rowExtent.width = clientWidth;
+    }
+    else if(rowLayoutRow->d->rowOrientation == RowOrientation::RightRowOrientation)
+    {
+      rowExtent.x += remainingWidth;
+    }
+    else if(rowLayoutRow->d->rowOrientation == RowOrientation::CenterRowOrientation)
+    {
+      rowExtent.x += remainingWidth / 2;
     }
   }
-} // end RowLayoutPrivate::moveUiComponentsBelowDown
+} // end RowLayoutPrivate::measure
 
-void RowLayoutPrivate::applyAllSizes()
+void RowLayoutPrivate::takeSnapshot(UiComponent * container,
+                                    LayoutSnapshotPrivate * layoutSnapshot)
 {
+  if(!uiComponentIdsInRowOrder)
+  {
+    compactUiComponentIds();
+  }
+
+  // Only the uiComponents that were invalidated are asked for their
+  // preferred size, the rest use the sizes cached by earlier layout passes.
+  measureUiComponents(0, rows.size());
+
+  layoutSnapshot->rowLayoutPrivate = this;
+  layoutSnapshot->container = container;
+  layoutSnapshot->containerClientWidth = container->getClientWidth();
+  layoutSnapshot->containerClientHeight = container->getClientHeight();
+  layoutSnapshot->containerPadding.leftPadding = container->getLeftPadding();
+  layoutSnapshot->containerPadding.rightPadding = container->getRightPadding();
+  layoutSnapshot->containerPadding.topPadding = container->getTopPadding();
+  layoutSnapshot->containerPadding.bottomPadding = container->getBottomPadding();
+  layoutSnapshot->verticalSpaceBetweenRows = ::getVerticalSpaceBetweenRowsToPlatformIfNeeded(verticalSpaceBetweenRows, layoutMetrics);
+  layoutSnapshot->layoutRevision = layoutRevision;
+
+  layoutSnapshot->rowFirstItem.clear();
+  layoutSnapshot->rowItemCount.clear();
+  layoutSnapshot->rowHorizontalSpace.clear();
+  layoutSnapshot->rowOrientation.clear();
+  layoutSnapshot->id.clear();
+  layoutSnapshot->uiComponent.clear();
+  layoutSnapshot->labelPeer.clear();
+  layoutSnapshot->uiComponentWidth.clear();
+  layoutSnapshot->uiComponentHeight.clear();
+  layoutSnapshot->labelWidth.clear();
+  layoutSnapshot->labelHeight.clear();
+  layoutSnapshot->gapBefore.clear();
+  layoutSnapshot->labelOrientation.clear();
+  layoutSnapshot->labelVerticalAlignment.clear();
+  layoutSnapshot->growX.clear();
+  layoutSnapshot->growY.clear();
+
   for(std::size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
   {
     RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
 
+    layoutSnapshot->rowFirstItem.push_back(layoutSnapshot->id.size());
+    layoutSnapshot->rowItemCount.push_back(rowLayoutRow->getUiComponentCount());
+    layoutSnapshot->rowHorizontalSpace.push_back(static_cast<int>(rowLayoutRow->d->horizontalSpaceBetweenUiComponents));
+    layoutSnapshot->rowOrientation.push_back(rowLayoutRow->d->rowOrientation);
+
     for(std::size_t uiComponentIndex = 0; uiComponentIndex < rowLayoutRow->getUiComponentCount(); ++uiComponentIndex)
     {
       UiComponentWrapper * uiComponentWrapper = rowLayoutRow->d->getUiComponentWrapperAt(uiComponentIndex);
+      const UiComponentConstraints * constraints = uiComponentWrapper->uiComponentConstraints;
 
-      if(uiComponentWrapper->labelPeer)
+      int uiComponentWidth = 0;
+      int uiComponentHeight = 0;
+      int labelWidth = 0;
+      int labelHeight = 0;
+
+      getMeasuredSizes(uiComponentWrapper, &uiComponentWidth, &uiComponentHeight, &labelWidth, &labelHeight);
+
+      int gapBefore = 0;
+
+      if(uiComponentIndex > 0)
       {
-        uiComponentWrapper->labelPeer->setSize(uiComponentWrapper->uiComponentInternals->labelPreferredWidth,
-                                               uiComponentWrapper->uiComponentInternals->labelPreferredHeight);
+        gapBefore = ::getMeasuredGap(rowLayoutRow->d->getUiComponentConstraintsAt(uiComponentIndex - 1),
+                                     constraints,
+                                     layoutMetrics);
       }
 
-      uiComponentWrapper->uiComponent->setSize(uiComponentWrapper->uiComponentInternals->uiComponentPreferredWidth,
-                                               uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight);
+      layoutSnapshot->id.push_back(uiComponentWrapper->id);
+      layoutSnapshot->uiComponent.push_back(uiComponentWrapper->uiComponent);
+      layoutSnapshot->labelPeer.push_back(uiComponentWrapper->labelPeer);
+      layoutSnapshot->uiComponentWidth.push_back(uiComponentWidth);
+      layoutSnapshot->uiComponentHeight.push_back(uiComponentHeight);
+      layoutSnapshot->labelWidth.push_back(labelWidth);
+      layoutSnapshot->labelHeight.push_back(labelHeight);
+      layoutSnapshot->gapBefore.push_back(gapBefore);
+      layoutSnapshot->labelOrientation.push_back(constraints->labelOrientation);
+      layoutSnapshot->labelVerticalAlignment.push_back(constraints->labelVerticalAlignment);
+      layoutSnapshot->growX.push_back(constraints->growX);
+      layoutSnapshot->growY.push_back(constraints->growY);
     }
   }
-} // end RowLayoutPrivate::applyAllSizes
-
-void RowLayoutPrivate::applyAllLocations()
+} // end RowLayoutPrivate::takeSnapshot
+
+// Computes a whole layout pass from the specified snapshot. This is the
+// non-incremental form of preLayout, resizeUiComponentsInSizeGroups and
+// postLayout and must give the same bounds. It only reads the snapshot and
+// only writes the result, so it may run on any thread.
+static void computeLayoutResult(const LayoutSnapshotPrivate& snapshot,
+                                LayoutResultPrivate * layoutResult)
 {
-  for(std::size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
+  const std::size_t rowCount = snapshot.rowFirstItem.size();
+  const std::size_t itemCount = snapshot.id.size();
+
+  const int leftPadding = snapshot.containerPadding.leftPadding;
+  const int rightPadding = snapshot.containerPadding.rightPadding;
+
+  const LayoutKernels& layoutKernels = ::getLayoutKernels();
+
+  std::vector<int> labelX(itemCount, 0);
+  std::vector<int> labelY(itemCount, 0);
+  std::vector<int> uiComponentX(itemCount, 0);
+  std::vector<int> uiComponentY(itemCount, 0);
+  std::vector<int> uiComponentWidth(snapshot.uiComponentWidth);
+  std::vector<int> uiComponentHeight(snapshot.uiComponentHeight);
+
+  std::vector<int> rowTop(rowCount, 0);
+  std::vector<int> rowWidth(rowCount, 0);
+  std::vector<int> rowHeight(rowCount, 0);
+  std::vector<int> nextLabelRowHeight(rowCount, 0);
+
+  layoutResult->rowLayoutPrivate = snapshot.rowLayoutPrivate;
+  layoutResult->container = snapshot.container;
+  layoutResult->layoutRevision = snapshot.layoutRevision;
+  layoutResult->rowExtents.resize(rowCount);
+
+  // 1) Place every row below the one before it, as layoutAllUiComponentsInRow
+  //    does.
+  int initialYOffset = snapshot.containerPadding.topPadding;
+  int containerHeight = snapshot.containerPadding.topPadding + snapshot.containerPadding.bottomPadding;
+  int maxRowWidth = 0;
+  bool growsVertically = false;
+
+  for(std::size_t rowIndex = 0; rowIndex < rowCount; ++rowIndex)
   {
-    RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+    const std::size_t firstItem = snapshot.rowFirstItem.at(rowIndex);
+    const std::size_t endItem = firstItem + snapshot.rowItemCount.at(rowIndex);
 
-    for(std::size_t uiComponentIndex = 0; uiComponentIndex < rowLayoutRow->getUiComponentCount(); ++uiComponentIndex)
+    int yOffset = initialYOffset;
+
+    if(rowIndex > 0)
     {
-      UiComponentWrapper * uiComponentWrapper = rowLayoutRow->d->getUiComponentWrapperAt(uiComponentIndex);
+      yOffset += snapshot.verticalSpaceBetweenRows;
+    }
 
-      if(uiComponentWrapper->labelPeer)
+    rowTop.at(rowIndex) = yOffset;
+
+    // The labels above and below the uiComponents of this row.
+    int previousLabelRowHeight = 0;
+
+    for(std::size_t item = firstItem; item < endItem; ++item)
+    {
+      if(!snapshot.labelPeer.at(item))
       {
-        uiComponentWrapper->labelPeer->setLocation(uiComponentWrapper->uiComponentInternals->labelX,
-                                                   uiComponentWrapper->uiComponentInternals->labelY);
+        continue;
       }
 
-      uiComponentWrapper->uiComponent->setLocation(uiComponentWrapper->uiComponentInternals->uiComponentX,
-                                                   uiComponentWrapper->uiComponentInternals->uiComponentY);
+      if(snapshot.labelOrientation.at(item) == LabelOrientation::TopOrientation)
+      {
+        previousLabelRowHeight = std::max(previousLabelRowHeight, snapshot.labelHeight.at(item));
+      }
+      else if(snapshot.labelOrientation.at(item) == LabelOrientation::BottomOrientation)
+      {
+        nextLabelRowHeight.at(rowIndex) = std::max(nextLabelRowHeight.at(rowIndex), snapshot.labelHeight.at(item));
+      }
     }
-  }
-} // end RowLayoutPrivate::applyAllLocations
 
-void RowLayoutPrivate::setDrawingEnabled(bool flag)
-{
-  for(std::size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
-  {
-    RowLayout::Row * rowLayoutRow = rows.at(rowIndex);
+    int xOffset = leftPadding;
+    int heightOfTallestUiComponentInRow = 0;
 
-    for(std::size_t uiComponentIndex = 0; uiComponentIndex < rowLayoutRow->getUiComponentCount(); ++uiComponentIndex)
+    for(std::size_t item = firstItem; item < endItem; ++item)
     {
-      UiComponentWrapper * uiComponentWrapper = rowLayoutRow->d->getUiComponentWrapperAt(uiComponentIndex);
+      if(item > firstItem)
+      {
+        xOffset += snapshot.rowHorizontalSpace.at(rowIndex) + snapshot.gapBefore.at(item);
+      }
 
-      if(uiComponentWrapper->labelPeer)
+      const bool hasLabel = snapshot.labelPeer.at(item) != nullptr;
+      const LabelOrientation::Value labelOrientation = snapshot.labelOrientation.at(item);
+      const int labelWidth = snapshot.labelWidth.at(item);
+      const int labelHeight = snapshot.labelHeight.at(item);
+
+      int uiComponentRowXOffset = 0;
+
+      if(hasLabel && labelOrientation == LabelOrientation::TopOrientation)
       {
-        if(flag)
-        {
-          uiComponentWrapper->labelPeer->enableDrawing();
-        }
-        else
-        {
-          uiComponentWrapper->labelPeer->disableDrawing();
-        }
+        labelX.at(item) = xOffset;
+        labelY.at(item) = yOffset;
+      }
+
+      int yLabelVAlignmentOffset = 0;
+      int yUiComponentPeerVAlignmentOffset = 0;
+
+      if(hasLabel && labelOrientation == LabelOrientation::LeftOrientation)
+      {
+        ::getVerticalAlignmentOffsets(snapshot.labelVerticalAlignment.at(item),
+                                      labelHeight,
+                                      uiComponentHeight.at(item),
+                                      &yLabelVAlignmentOffset,
+                                      &yUiComponentPeerVAlignmentOffset);
+
+        labelX.at(item) = xOffset;
+        labelY.at(item) = yOffset + yLabelVAlignmentOffset + previousLabelRowHeight;
+
+        uiComponentRowXOffset += labelWidth;
+
+        heightOfTallestUiComponentInRow = std::max(heightOfTallestUiComponentInRow, labelHeight);
       }
 
-      if(flag)
+      uiComponentX.at(item) = xOffset + uiComponentRowXOffset;
+      uiComponentY.at(item) = yOffset + yUiComponentPeerVAlignmentOffset + previousLabelRowHeight;
+
+      uiComponentRowXOffset += uiComponentWidth.at(item);
+
+      if(hasLabel && labelOrientation == LabelOrientation::RightOrientation)
       {
-        uiComponentWrapper->uiComponent->enableDrawing();;
+        // Note: layoutUiComponentInRow places the uiComponent before it
+        //       aligns a label to its right, so neither is aligned.
+        labelX.at(item) = xOffset + uiComponentRowXOffset;
+        labelY.at(item) = yOffset + previousLabelRowHeight;
+
+        uiComponentRowXOffset += labelWidth;
+
+        heightOfTallestUiComponentInRow = std::max(heightOfTallestUiComponentInRow, labelHeight);
       }
-      else
+
+      if(hasLabel && labelOrientation == LabelOrientation::BottomOrientation)
       {
-        uiComponentWrapper->uiComponent->disableDrawing();
+        labelX.at(item) = xOffset;
+        labelY.at(item) = yOffset + previousLabelRowHeight + uiComponentHeight.at(item);
+
+        heightOfTallestUiComponentInRow = std::max(heightOfTallestUiComponentInRow, labelHeight);
       }
+
+      xOffset += uiComponentRowXOffset;
     }
+
+    heightOfTallestUiComponentInRow = layoutKernels.getMaxValue(uiComponentHeight.data() + firstItem,
+                                                                endItem - firstItem,
+                                                                heightOfTallestUiComponentInRow);
+
+    rowWidth.at(rowIndex) = xOffset - leftPadding;
+    rowHeight.at(rowIndex) = yOffset + previousLabelRowHeight + nextLabelRowHeight.at(rowIndex) +
+                             heightOfTallestUiComponentInRow - initialYOffset;
+
+    // The extent of a row leaves out the vertical space above it.
+    RowExtent& rowExtent = layoutResult->rowExtents.at(rowIndex);
+
+    rowExtent.x = leftPadding;
+    rowExtent.y = yOffset;
+    rowExtent.width = rowWidth.at(rowIndex);
+    rowExtent.height = rowHeight.at(rowIndex) - (yOffset - initialYOffset);
+
+    initialYOffset += rowHeight.at(rowIndex);
+    containerHeight += rowHeight.at(rowIndex);
+    maxRowWidth = std::max(maxRowWidth, rowWidth.at(rowIndex));
   }
-} // end RowLayoutPrivate::setDrawingEnabled
 
-void RowLayoutPrivate::enableAllDrawing()
-{
-  setDrawingEnabled(true);
-}
+  layoutResult->preferredWidth = leftPadding + rightPadding + maxRowWidth;
+  layoutResult->preferredHeight = containerHeight;
 
-void RowLayoutPrivate::disableAllDrawing()
-{
-  setDrawingEnabled(false);
-}
+  // 2) Grow or align every row within the width of the container.
+  for(std::size_t rowIndex = 0; rowIndex < rowCount; ++rowIndex)
+  {
+    const std::size_t firstItem = snapshot.rowFirstItem.at(rowIndex);
+    const std::size_t endItem = firstItem + snapshot.rowItemCount.at(rowIndex);
 
-void RowLayoutPrivate::postLayout(RowLayout * thisRowLayout, UiComponent * container)
-{
-  // To prevent flickering while laying out
-  disableAllDrawing();
+    RowExtent& rowExtent = layoutResult->rowExtents.at(rowIndex);
 
-  // Apply the constant left padding if any.
-  const int initialXOffset = container->getLeftPadding();
-  int xOffset = initialXOffset;
+    const int remainingWidth = snapshot.containerClientWidth - rowWidth.at(rowIndex) - leftPadding - rightPadding;
 
-  // Apply the constant top padding if any.
-  int yOffset = container->getTopPadding();
+    const int totalWeight = layoutKernels.getSumOfPositiveValues(snapshot.growX.data() + firstItem,
+                                                                 endItem - firstItem);
 
-  // The height of the tallest uiComponent in the current row.
-  int heightOfTallestUiComponentInRow = 0;
+    if(layoutKernels.getMaxValue(snapshot.growY.data() + firstItem, endItem - firstItem, 0) > 0)
+    {
+      growsVertically = true;
+    }
 
-  int initialYOffset = container->getTopPadding();
+    int distance = 0;
 
-  // Take the container dimensions into account, by keeping a running
-  // tally of the size of its uiComponents and padding.
-  int containerWidth = container->getLeftPadding() + container->getRightPadding();
+    if(totalWeight > 0)
+    {
+      if(remainingWidth <= 0)
+      {
+        continue;
+      }
 
-  int containerHeight = container->getTopPadding() + container->getBottomPadding();
+      int weightsBefore = 0;
 
-  // Width of the largest row in the specified container.
-  // Note: the width of any given row is the following.
-  //
-  // xOffset - initialXOffset
-  int maxRowWidth = 0;
+      for(std::size_t item = firstItem; item < endItem; ++item)
+      {
+        labelX.at(item) += distance;
+        uiComponentX.at(item) += distance;
 
-  std::size_t rowIndex = 0;
-
-  // Start fencepost block. We need the fencepost here in order to handle
-  // gaps between rows.
-  if(thisRowLayout->getRowCount() > 0)
-  {
-    layoutAllUiComponentsInRow(thisRowLayout,
-                               rowIndex,
-                               &xOffset,
-                               &yOffset,
-                               &heightOfTallestUiComponentInRow,
-                               initialXOffset,
-                               &initialYOffset,
-                               &containerHeight,
-                               &maxRowWidth,
-                               true);
-  }
-  // End fencepost block.
-
-  ++rowIndex;
-
-  // Handle the remaining rows
-  for(; rowIndex < thisRowLayout->getRowCount(); ++rowIndex)
-  {
-    layoutAllUiComponentsInRow(thisRowLayout,
-                               rowIndex,
-                               &xOffset,
-                               &yOffset,
-                               &heightOfTallestUiComponentInRow,
-                               initialXOffset,
-                               &initialYOffset,
-                               &containerHeight,
-                               &maxRowWidth,
-                               false);
-  }// end all rows loop
+        if(snapshot.growX.at(item) > 0)
+        {
+          const int share = ::getGrowShare(remainingWidth, weightsBefore, snapshot.growX.at(item), totalWeight);
 
-  containerWidth += maxRowWidth;
+          weightsBefore += snapshot.growX.at(item);
 
-  // Now set the preferred size of the container
-  container->setPreferredSize(containerWidth, containerHeight);
+          uiComponentWidth.at(item) += share;
 
-  // Now that the uiComponents are in place, we need to apply orientation
-  // rules if any have been specified.
+          if(snapshot.labelOrientation.at(item) == LabelOrientation::RightOrientation)
+          {
+            labelX.at(item) += share;
+          }
 
-  for(std::size_t i = 0; i < thisRowLayout->getRowCount(); ++i)
-  {
-    if(rows.at(i)->d->rowOrientation == RowOrientation::RightRowOrientation)
+          distance += share;
+        }
+      }
+
+      rowExtent.width += distance;
+
+      continue;
+    }
+
+    if(snapshot.rowOrientation.at(rowIndex) == RowOrientation::RightRowOrientation)
+    {
+      distance = remainingWidth;
+    }
+    else if(snapshot.rowOrientation.at(rowIndex) == RowOrientation::CenterRowOrientation)
     {
-      applyRightRowAlignment(thisRowLayout,
-                             i,
-                             container->getClientWidth(),
-                             container->getLeftPadding(),
-                             container->getRightPadding());
+      distance = remainingWidth / 2;
     }
-    else if(rows.at(i)->d->rowOrientation == RowOrientation::CenterRowOrientation)
+
+    if(distance > 0)
     {
-      applyCenterRowAlignment(thisRowLayout,
-                              i,
-                              container->getClientWidth(),
-                              container->getLeftPadding(),
-                              container->getRightPadding());
+      layoutKernels.addToValues(labelX.data() + firstItem, endItem - firstItem, distance);
+      layoutKernels.addToValues(uiComponentX.data() + firstItem, endItem - firstItem, distance);
+
+      rowExtent.x += distance;
     }
   }
 
-  // Grow uiComponents if you have the space
-  // Note: In a row layout, the uiComponents can grow wider independent of
-  //       other rows. However, height is constrained by the amount of rows
-  //       in the layout.
-  for(std::size_t rowIndex = 0; rowIndex < thisRowLayout->getRowCount(); ++rowIndex)
+  // 3) Grow the rows into the height of the container, as
+  //    growRowsVertically does.
+  if(growsVertically)
   {
-    int remainingWidth = container->getClientWidth() - rows.at(rowIndex)->d->rowWidth;
-    int remainingHeight = container->getClientHeight() - containerHeight;
+    const int remainingHeight = snapshot.containerClientHeight - containerHeight;
+
+    std::vector<int> growYWeight(rowCount, 0);
+
+    int totalWeight = 0;
+
+    for(std::size_t rowIndex = 0; rowIndex < rowCount; ++rowIndex)
+    {
+      const std::size_t firstItem = snapshot.rowFirstItem.at(rowIndex);
+      const std::size_t endItem = firstItem + snapshot.rowItemCount.at(rowIndex);
+
+      growYWeight.at(rowIndex) = layoutKernels.getMaxValue(snapshot.growY.data() + firstItem, endItem - firstItem, 0);
+
+      totalWeight += growYWeight.at(rowIndex);
+    }
 
-    // strip the padding if any
-    remainingWidth = remainingWidth - (container->getLeftPadding() + container->getRightPadding()); // Note: Row width does not include the padding so take it out
-    // Note: Nothing needs to be taken out of the height because the container height already includes the padding.
+    int weightsBefore = 0;
+    int distance = 0;
 
-    // give the rest to children that want the space
-    for(std::size_t uiComponentIndex = 0; uiComponentIndex < thisRowLayout->getUiComponentCountAtRow(rowIndex); ++uiComponentIndex)
+    for(std::size_t rowIndex = 0; rowIndex < rowCount; ++rowIndex)
     {
-      UiComponentWrapper * uiComponentWrapper = rows.at(rowIndex)->d->getUiComponentWrapperAt(uiComponentIndex);
+      const std::size_t firstItem = snapshot.rowFirstItem.at(rowIndex);
+      const std::size_t endItem = firstItem + snapshot.rowItemCount.at(rowIndex);
+
+      RowExtent& rowExtent = layoutResult->rowExtents.at(rowIndex);
 
-      if(uiComponentWrapper->uiComponentConstraints->growX > 0) // TODO: In the future allow more than one uiComponent to grow.
+      if(distance > 0)
       {
-        if(remainingWidth > 0)
-        {
-          uiComponentWrapper->uiComponentInternals->uiComponentPreferredWidth = uiComponentWrapper->uiComponentInternals->uiComponentPreferredWidth + remainingWidth;
+        layoutKernels.addToValues(labelY.data() + firstItem, endItem - firstItem, distance);
+        layoutKernels.addToValues(uiComponentY.data() + firstItem, endItem - firstItem, distance);
 
-          // Move the rest of the uiComponents in this row to the right by
-          // remaining width
-          // TODO: Don't forget about uiComponent/label pairs above or below
-          moveUiComponentsInRowRight(rowIndex, uiComponentIndex + 1, remainingWidth);
-        }
+        rowTop.at(rowIndex) += distance;
+        rowExtent.y += distance;
       }
 
-      // Grow Y implies Grow Row Y too.
-      // Grow the uiComponent in row first, make sure not greater than its
-      // row.
-      // Then grow it by the remaining height of the container
-      if(uiComponentWrapper->uiComponentConstraints->growY > 0)
+      if(growYWeight.at(rowIndex) <= 0)
+      {
+        continue;
+      }
+
+      int share = 0;
+
+      if(remainingHeight > 0)
+      {
+        share = ::getGrowShare(remainingHeight, weightsBefore, growYWeight.at(rowIndex), totalWeight);
+      }
+
+      weightsBefore += growYWeight.at(rowIndex);
+
+      int uiComponentsBottom = rowTop.at(rowIndex) + rowHeight.at(rowIndex) + share - nextLabelRowHeight.at(rowIndex);
+
+      if(rowIndex > 0)
       {
-        int remainingHeightInRow = rows.at(rowIndex)->d->rowHeight - uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight;
+        uiComponentsBottom -= snapshot.verticalSpaceBetweenRows;
+      }
 
-        if(remainingHeightInRow > 0)
+      for(std::size_t item = firstItem; item < endItem; ++item)
+      {
+        if(snapshot.growY.at(item) <= 0)
         {
-          uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight = uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight + remainingHeightInRow;
+          continue;
         }
 
-        if(remainingHeight > 0)
-        {
-          uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight = uiComponentWrapper->uiComponentInternals->uiComponentPreferredHeight + remainingHeight;
+        const int growth = uiComponentsBottom - uiComponentY.at(item) - uiComponentHeight.at(item);
 
-          // Move the rest of the uiComponents in rows below this
-          // uiComponent by the remaining height
-          // TODO: Don't forget about uiComponent/label pairs below
-          // rowIndex + 1 --> One row below
-          moveUiComponentsBelowDown(rowIndex + 1, remainingHeight);
+        if(growth > 0)
+        {
+          uiComponentHeight.at(item) += growth;
 
-          // There is no more height left
-          remainingHeight = 0;
+          if(snapshot.labelOrientation.at(item) == LabelOrientation::BottomOrientation)
+          {
+            labelY.at(item) += growth;
+          }
         }
       }
+
+      rowExtent.height += share;
+
+      distance += share;
     }
-  } // end grow loop
+  }
 
-  // Apply all the cached sizes in one step
-  applyAllSizes();
+  // 4) Flatten the bounds, each label before its uiComponent.
+  layoutResult->bounds.clear();
+  layoutResult->boundsId.clear();
 
-  // Apply all the cached locations in one step
-  applyAllLocations();
+  UiComponentBounds uiComponentBounds;
+  uiComponentBounds.changed = UiComponentBounds::SizeChanged | UiComponentBounds::LocationChanged;
 
-  enableAllDrawing();
-} // end RowLayoutPrivate::postLayout
+  for(std::size_t item = 0; item < itemCount; ++item)
+  {
+    if(snapshot.labelPeer.at(item))
+    {
+      uiComponentBounds.uiComponent = snapshot.labelPeer.at(item);
+      uiComponentBounds.x = labelX.at(item);
+      uiComponentBounds.y = labelY.at(item);
+      uiComponentBounds.width = snapshot.labelWidth.at(item);
+      uiComponentBounds.height = snapshot.labelHeight.at(item);
+
+      layoutResult->bounds.push_back(uiComponentBounds);
+      layoutResult->boundsId.push_back(snapshot.id.at(item));
+    }
 
-void RowLayoutPrivate::layoutAllUiComponentsInRow(RowLayout * thisRowLayout,
-                                                  std::size_t rowIndex,
-                                                  int * xOffset,
-                                                  int * yOffset,
-                                                  int * heightOfTallestUiComponentInRow,
-                                                  int initialXOffset,
-                                                  int * initialYOffset,
-                                                  int * containerHeight,
-                                                  int * maxRowWidth,
-                                                  bool isFirstRow)
+    uiComponentBounds.uiComponent = snapshot.uiComponent.at(item);
+    uiComponentBounds.x = uiComponentX.at(item);
+    uiComponentBounds.y = uiComponentY.at(item);
+    uiComponentBounds.width = uiComponentWidth.at(item);
+    uiComponentBounds.height = uiComponentHeight.at(item);
+
+    layoutResult->bounds.push_back(uiComponentBounds);
+    layoutResult->boundsId.push_back(snapshot.id.at(item));
+  }
+} // end computeLayoutResult
+
+bool RowLayoutPrivate::commit(const LayoutResultPrivate& layoutResult)
 {
-  // Reset the x-offset for the new row.
-  *xOffset = initialXOffset;
+  // The ids of a result only index the uiComponentInternals of the layout it
+  // was computed for. A result that was never computed has no container.
+  if(layoutResult.rowLayoutPrivate != this || !layoutResult.container)
+  {
+    return false;
+  }
 
-  if(!isFirstRow)
+  if(layoutResult.layoutRevision != layoutRevision)
   {
-    // Adjust the y-offset for the new row.
-    *yOffset = *initialYOffset;
+    // The layout changed after the snapshot was taken, the result may refer
+    // to uiComponents that are gone.
+    return false;
   }
 
-  // We've added the last row's tallest uiComponent's height so reset the
-  // offset so we can calculate the height of the tallest uiComponent in
-  // the next row.
-  *heightOfTallestUiComponentInRow = 0;
+  layoutResult.container->setPreferredSize(layoutResult.preferredWidth,
+                                           layoutResult.preferredHeight);
 
-  std::size_t uiComponentIndex = 0;
+  changedBounds.clear();
 
-  if(!isFirstRow)
+  for(std::size_t i = 0; i < layoutResult.bounds.size(); ++i)
   {
-    // Also add in the vertical gap between rows.
-    *yOffset += ::getVerticalSpaceBetweenRowsToPlatformIfNeeded(thisRowLayout->getVerticalSpaceBetweenRows());
+    const UiComponentBounds& uiComponentBounds = layoutResult.bounds.at(i);
+    const std::size_t id = layoutResult.boundsId.at(i);
+
+    if(uiComponentBounds.uiComponent == uiComponentInternals.labelPeer[id])
+    {
+      addChangedBounds(uiComponentBounds.uiComponent,
+                       uiComponentBounds.x,
+                       uiComponentBounds.y,
+                       uiComponentBounds.width,
+                       uiComponentBounds.height,
+                       uiComponentInternals.labelAppliedX[id],
+                       uiComponentInternals.labelAppliedY[id],
+                       uiComponentInternals.labelAppliedWidth[id],
+                       uiComponentInternals.labelAppliedHeight[id]);
+    }
+    else
+    {
+      addChangedBounds(uiComponentBounds.uiComponent,
+                       uiComponentBounds.x,
+                       uiComponentBounds.y,
+                       uiComponentBounds.width,
+                       uiComponentBounds.height,
+                       uiComponentInternals.uiComponentAppliedX[id],
+                       uiComponentInternals.uiComponentAppliedY[id],
+                       uiComponentInternals.uiComponentAppliedWidth[id],
+                       uiComponentInternals.uiComponentAppliedHeight[id]);
+    }
   }
 
-  // Start Fencepost block. We need the fencepost here in order to handle
-  // gaps between uiComponents in a row.
+  commitChangedBounds(layoutResult.container);
 
-  // there is at least one uiComponent in this row
-  if(thisRowLayout->getUiComponentCountAtRow(rowIndex) > 0)
+  // The rows are where the result put them until the next layout pass.
+  const int verticalSpace = ::getVerticalSpaceBetweenRowsToPlatformIfNeeded(verticalSpaceBetweenRows, layoutMetrics);
+
+  for(std::size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
   {
-    layoutUiComponentInRow(thisRowLayout,
-                           rowIndex,
-                           uiComponentIndex,
-                           xOffset,
-                           yOffset,
-                           heightOfTallestUiComponentInRow,
-                           false);
-  }
-  // End Fencepost block
+    const RowExtent& rowExtent = layoutResult.rowExtents.at(rowIndex);
 
-  ++uiComponentIndex;
+    setIndexedRowExtent(rowIndex,
+                        rowIndex > 0 ? rowExtent.height + verticalSpace : rowExtent.height,
+                        rowExtent.width);
 
-  // Check for all of the uiComponents in the current row.
-  for(; uiComponentIndex < thisRowLayout->getUiComponentCountAtRow(rowIndex); ++uiComponentIndex)
-  {
-    layoutUiComponentInRow(thisRowLayout,
-                           rowIndex,
-                           uiComponentIndex,
-                           xOffset,
-                           yOffset,
-                           heightOfTallestUiComponentInRow,
-                           true);
-  }// end current row loop
+    rows.at(rowIndex)->d->rowTop = rowExtent.y;
+    rows.at(rowIndex)->d->hitBounds.clear();
+    rows.at(rowIndex)->d->widestHitBounds = 0;
+  }
 
-  // For each row, we need to check its previous and next label row
-  // pointer, if they are valid, offset the yOffset by the height of the
-  // tallest label in each valid label row. The check is here instead of
-  // earlier so that we ensure at least one uiComponent is in the current
-  // row.
-  if(rows.at(rowIndex)->d->previousLabelRow)
+  for(std::size_t i = 0; i < layoutResult.bounds.size(); ++i)
   {
-    *yOffset += rows.at(rowIndex)->d->previousLabelRow->maxHeightLabelInRow;
+    const UiComponentBounds& uiComponentBounds = layoutResult.bounds.at(i);
+
+    addHitBounds(findUiComponentWrapper(uiComponentBounds.uiComponent)->row,
+                 uiComponentBounds.uiComponent,
+                 uiComponentBounds.x,
+                 uiComponentBounds.y,
+                 uiComponentBounds.width,
+                 uiComponentBounds.height);
   }
 
-  if(rows.at(rowIndex)->d->nextLabelRow)
+  for(std::size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
   {
-    *yOffset += rows.at(rowIndex)->d->nextLabelRow->maxHeightLabelInRow;
+    ::sortHitBounds(&rows.at(rowIndex)->d->hitBounds);
   }
 
-  rows.at(rowIndex)->d->rowWidth = *xOffset - initialXOffset;
-  rows.at(rowIndex)->d->rowHeight = (*yOffset + *heightOfTallestUiComponentInRow) - *initialYOffset;
+  rowOffsetOrigin = layoutResult.container->getTopPadding();
+  indexedEstimatedRowHeight = 0;
 
-  *initialYOffset += rows.at(rowIndex)->d->rowHeight;
+  // The geometry cached by the incremental layout passes does not know about
+  // the bounds applied here, so the next layout pass lays out every row
+  // again. Only the bounds that differ from the ones applied here are
+  // applied then.
+  lastContainer = nullptr;
 
-  *maxRowWidth = std::max(*maxRowWidth, rows.at(rowIndex)->d->rowWidth);
+  // Every change up to the snapshot is applied.
+  layoutPending = false;
 
-  *containerHeight += rows.at(rowIndex)->d->rowHeight;
+  return true;
+} // end RowLayoutPrivate::commit
+
+RowLayout::RowLayout(UiComponent * rowLayoutContainer)
+:ILayout(),
+ d(new RowLayoutPrivate(rowLayoutContainer, nullptr))
+{
+  rowLayoutContainer->setLayout(this);
 }
 
-RowLayout::RowLayout(UiComponent * rowLayoutContainer)
+RowLayout::RowLayout(UiComponent * rowLayoutContainer,
+                     const LayoutAllocator * layoutAllocator)
 :ILayout(),
- d(new RowLayoutPrivate(rowLayoutContainer))
+ d(new RowLayoutPrivate(rowLayoutContainer, layoutAllocator))
 {
   rowLayoutContainer->setLayout(this);
 }
@@ -1287,15 +4133,105 @@ int RowLayout::getVerticalSpaceBetweenRows() const
   return d->verticalSpaceBetweenRows;
 }
 
+std::size_t RowLayout::getSkippedBoundsCallCount() const
+{
+  return d->skippedBoundsCallCount;
+}
+
+int RowLayout::getDpi() const
+{
+  return d->layoutMetrics->dpi;
+}
+
+const LayoutMetrics& RowLayout::getLayoutMetrics() const
+{
+  return *d->layoutMetrics;
+}
+
+std::size_t RowLayout::getLabelMeasurementCacheHitCount() const
+{
+  std::size_t hitCount = 0;
+
+  for(std::map<int, LabelMeasurementCache>::const_iterator it = d->labelMeasurementCaches.begin(); it != d->labelMeasurementCaches.end(); ++it)
+  {
+    hitCount += it->second.getHitCount();
+  }
+
+  return hitCount;
+}
+
+std::size_t RowLayout::getLabelMeasurementCacheMissCount() const
+{
+  std::size_t missCount = 0;
+
+  for(std::map<int, LabelMeasurementCache>::const_iterator it = d->labelMeasurementCaches.begin(); it != d->labelMeasurementCaches.end(); ++it)
+  {
+    missCount += it->second.getMissCount();
+  }
+
+  return missCount;
+}
+
+void RowLayout::setLabelMeasurementCacheCapacity(std::size_t capacity)
+{
+  d->labelMeasurementCacheCapacity = capacity;
+
+  for(std::map<int, LabelMeasurementCache>::iterator it = d->labelMeasurementCaches.begin(); it != d->labelMeasurementCaches.end(); ++it)
+  {
+    it->second.setCapacity(capacity);
+  }
+}
+
 RowLayout::Row * RowLayout::addRow()
 {
-  d->currentRow = new Row(this);
+  d->currentRow = d->createRow(this);
   d->rows.push_back(d->currentRow);
+  d->rowOffsetIndex.append();
+
+  // Even an empty row takes up the vertical space above it.
+  d->requestLayout(this);
+
+  return d->currentRow;
+}
+
+void RowLayout::reserve(std::size_t rowCount,
+                        std::size_t uiComponentCount)
+{
+  d->rows.reserve(rowCount);
+  d->uiComponentInternals.reserve(uiComponentCount);
+}
+
+RowLayout::Row * RowLayout::addRows(const UiComponentEntry * uiComponentEntries,
+                                    const std::size_t * uiComponentCounts,
+                                    std::size_t rowCount)
+{
+  std::size_t totalUiComponentCount = 0;
+
+  for(std::size_t i = 0; i < rowCount; ++i)
+  {
+    totalUiComponentCount += uiComponentCounts[i];
+  }
+
+  reserve(d->rows.size() + rowCount,
+          d->uiComponentInternals.size() + totalUiComponentCount);
+
+  // Each entry adds a uiComponent and possibly a label to the container.
+  std::vector<UiComponent *> children;
+  children.reserve(totalUiComponentCount * 2);
+
+  for(std::size_t i = 0; i < rowCount; ++i)
+  {
+    d->addUiComponentsToRow(addRow(), uiComponentEntries, uiComponentCounts[i], &children);
+
+    uiComponentEntries += uiComponentCounts[i];
+  }
+
+  // Add every child of every new row to the container in one step.
+  d->attachUiComponents(children);
 
   return d->currentRow;
 }
 
-// TODO: Adding a UiComponent should force a layout
 RowLayout::Row * RowLayout::addUiComponent(UiComponent * uiComponent,
                                            UiComponentConstraints * uiComponentConstraints)
 {
@@ -1310,8 +4246,9 @@ RowLayout::Row * RowLayout::addUiComponent(UiComponent * uiComponent,
   //    and use it.
   if(!d->currentRow)
   {
-    d->currentRow = new Row(this);
+    d->currentRow = d->createRow(this);
     d->rows.push_back(d->currentRow);
+    d->rowOffsetIndex.append();
   }
 
   // Now that the row exists, add the UiComponent to the row
@@ -1319,7 +4256,6 @@ RowLayout::Row * RowLayout::addUiComponent(UiComponent * uiComponent,
                                        uiComponentConstraints);
 }
 
-// TODO: Adding a UiComponent should force a layout
 RowLayout::Row * RowLayout::addUiComponent(Label * label,
                                            UiComponent * uiComponent,
                                            UiComponentConstraints * uiComponentConstraints)
@@ -1335,8 +4271,9 @@ RowLayout::Row * RowLayout::addUiComponent(Label * label,
   //    and use it.
   if(!d->currentRow)
   {
-    d->currentRow = new Row(this);
+    d->currentRow = d->createRow(this);
     d->rows.push_back(d->currentRow);
+    d->rowOffsetIndex.append();
   }
 
   // Now that the row exists, add the uiComponent to the row
@@ -1345,59 +4282,63 @@ RowLayout::Row * RowLayout::addUiComponent(Label * label,
                                        uiComponentConstraints);
 }
 
-// TODO: Perform a layout if this changes.
 void RowLayout::setVerticalSpaceBetweenRows(int verticalSpace)
 {
-  d->verticalSpaceBetweenRows = verticalSpace;
+  if(d->verticalSpaceBetweenRows != verticalSpace)
+  {
+    d->verticalSpaceBetweenRows = verticalSpace;
+
+    // Every row below the first row moves.
+    d->verticalSpaceBetweenRowsChanged = true;
+
+    d->requestLayout(this);
+  }
 }
 
-// TODO: Removing a UiComponent should force a layout
-// TODO: Implement remove on the underlying container too
-void RowLayout::removeUiComponent(UiComponent * uiComponent)
+void RowLayout::setDpi(int dpi)
 {
-  bool removedUiComponent = false;
+  const LayoutMetrics& layoutMetrics = LayoutMetrics::getLayoutMetrics(dpi);
 
-  for(std::size_t i = 0; i < d->rows.size(); ++i)
+  if(&layoutMetrics == d->layoutMetrics)
   {
-    Row * row = d->rows.at(i);
+    return;
+  }
 
-    for(std::size_t j = 0; j < row->getUiComponentCount(); ++j)
-    {
-      UiComponent * rowUiComponent = row->getUiComponentAt(j);
+  const int previousDpi = d->layoutMetrics->dpi;
 
-      if(rowUiComponent == uiComponent)
-      {
-        // Do not forget to remove the UiComponent from the size group if it is
-        // specified
-        UiComponentConstraints * constraints = row->d->getUiComponentConstraintsAt(j);
-        UiComponentWrapper * uiComponentWrapper = row->d->getUiComponentWrapperAt(j);
+  d->saveMeasuredSizes();
 
-        if(constraints->sizeGroupId >= 0)
-        {
-          std::vector<std::pair<SizeGroupIdentifier, UiComponentWrapper *> >& tempUiComponents = d->sizeGroups[constraints->sizeGroupId];
+  d->layoutMetrics = &layoutMetrics;
 
-          tempUiComponents.erase(std::remove(tempUiComponents.begin(), tempUiComponents.end(), std::pair<SizeGroupIdentifier, UiComponentWrapper *>(UiComponentGroup, uiComponentWrapper)), tempUiComponents.end());
-        }
+  const bool hasLabelMeasurementCache = d->labelMeasurementCaches.count(layoutMetrics.dpi) > 0;
 
-        if(constraints->labelSizeGroupId >= 0)
-        {
-          std::vector<std::pair<SizeGroupIdentifier, UiComponentWrapper *> >& tempUiComponents = d->sizeGroups[constraints->labelSizeGroupId];
+  d->labelMeasurementCache = &d->labelMeasurementCaches[layoutMetrics.dpi];
 
-          tempUiComponents.erase(std::remove(tempUiComponents.begin(), tempUiComponents.end(), std::pair<SizeGroupIdentifier, UiComponentWrapper *>(LabelGroup, uiComponentWrapper)), tempUiComponents.end());
-        }
+  if(!hasLabelMeasurementCache)
+  {
+    d->labelMeasurementCache->setCapacity(d->labelMeasurementCacheCapacity);
+  }
 
-        // Now remove the UiComponent
+  d->restoreMeasuredSizes(previousDpi);
 
-        row->removeUiComponentAt(j);
-        removedUiComponent = true;
-        break;
-      }
-    }
+  // The gaps and the space between the rows may change, so every row is laid
+  // out again.
+  d->invalidateAllRows();
 
-    if(removedUiComponent)
-    {
-      break;
-    }
+  d->verticalSpaceBetweenRowsChanged = true;
+
+  d->requestLayout(this);
+}
+
+// TODO: Implement remove on the underlying container too
+void RowLayout::removeUiComponent(UiComponent * uiComponent)
+{
+  UiComponentWrapper * uiComponentWrapper = d->findUiComponentWrapper(uiComponent);
+
+  // Only a uiComponent removes its wrapper, not its label.
+  if(uiComponentWrapper && uiComponentWrapper->uiComponent == uiComponent)
+  {
+    d->removeUiComponentWrapper(uiComponentWrapper);
   }
 }
 
@@ -1408,15 +4349,344 @@ void RowLayout::removeAllUiComponents()
   for(std::size_t i = d->rows.size(); i-- > 0;)
   {
     Row * row = d->rows.at(i);
-    row->removeAllUiComponents();
+
+    // The wrappers and constraints are released in bulk below.
+    row->d->uiComponents.clear();
+    row->d->removedUiComponentCount = 0;
+
+    if(row->d->previousLabelRow)
+    {
+      row->d->previousLabelRow->removeAllLabels();
+    }
+
+    if(row->d->nextLabelRow)
+    {
+      row->d->nextLabelRow->removeAllLabels();
+    }
+
+    row->d->firstUiComponentId = 0;
+    row->d->needsLayout = true;
+    row->d->laidOut = false;
+    row->d->hitBounds.clear();
+    row->d->widestHitBounds = 0;
+
+    d->forgetIndexedRowExtent(i);
   }
 
+  d->uiComponentWrapperPool.releaseAll();
+  d->uiComponentConstraintsPool.releaseAll();
+
+  d->growYCount = 0;
+
   // Remove all size groups
+  d->sizeGroupIndices.clear();
   d->sizeGroups.clear();
+  d->changedSizeGroups.clear();
+
+  d->uiComponentIndex.clear();
+
+  // Every row is empty, so start over with the ids.
+  d->uiComponentInternals.clear();
+  d->uiComponentIdsInRowOrder = true;
+
+  d->requestLayout(this);
+}
+
+bool RowLayout::findUiComponent(UiComponent * uiComponent,
+                                std::size_t * row,
+                                std::size_t * index)
+{
+  UiComponentWrapper * uiComponentWrapper = d->findUiComponentWrapper(uiComponent);
+
+  if(!uiComponentWrapper)
+  {
+    return false;
+  }
+
+  // The slot is only the index once the holes in the row are closed.
+  uiComponentWrapper->row->d->compactUiComponents();
+
+  *row = uiComponentWrapper->row->d->rowIndex;
+  *index = uiComponentWrapper->slot;
+
+  return true;
+}
+
+void RowLayout::invalidateUiComponent(UiComponent * uiComponent)
+{
+  UiComponentWrapper * uiComponentWrapper = d->findUiComponentWrapper(uiComponent);
+
+  if(uiComponentWrapper)
+  {
+    d->uiComponentInternals.needsMeasure[uiComponentWrapper->id] = true;
+
+    uiComponentWrapper->row->d->needsLayout = true;
+
+    d->requestLayout(this);
+  }
+}
+
+void RowLayout::invalidateFont(const void * fontIdentity)
+{
+  for(std::map<int, LabelMeasurementCache>::iterator it = d->labelMeasurementCaches.begin(); it != d->labelMeasurementCaches.end(); ++it)
+  {
+    it->second.removeFont(fontIdentity);
+  }
+
+  bool changed = false;
+
+  for(std::size_t rowIndex = 0; rowIndex < d->rows.size(); ++rowIndex)
+  {
+    RowLayout::Row * rowLayoutRow = d->rows.at(rowIndex);
+
+    for(std::size_t uiComponentIndex = 0; uiComponentIndex < rowLayoutRow->getUiComponentCount(); ++uiComponentIndex)
+    {
+      const std::size_t id = rowLayoutRow->d->getUiComponentWrapperAt(uiComponentIndex)->id;
+      const IMeasurableText * labelText = d->uiComponentInternals.labelText[id];
+
+      if(labelText && labelText->getFontIdentity() == fontIdentity)
+      {
+        d->uiComponentInternals.needsMeasure[id] = true;
+
+        rowLayoutRow->d->needsLayout = true;
+
+        changed = true;
+      }
+    }
+  }
+
+  if(changed)
+  {
+    d->requestLayout(this);
+  }
+}
+
+void RowLayout::invalidateRow(std::size_t row)
+{
+  // Verify that the row is valid
+  if(d->rows.size() >= row + 1)
+  {
+    d->rows.at(row)->invalidate();
+  }
+}
+
+void RowLayout::invalidateLayout()
+{
+  // The bounds of the uiComponents may have been changed behind the back of
+  // this layout, so apply all of them again.
+  d->uiComponentInternals.forgetAppliedBounds();
+
+  for(std::size_t i = 0; i < d->rows.size(); ++i)
+  {
+    d->rows.at(i)->invalidate();
+  }
+}
+
+void RowLayout::setLayoutScheduler(const LayoutScheduler * layoutScheduler)
+{
+  d->hasLayoutScheduler = layoutScheduler != nullptr;
+
+  if(d->hasLayoutScheduler)
+  {
+    d->layoutScheduler = *layoutScheduler;
+  }
+}
+
+void RowLayout::setLayoutPhaseObserver(const LayoutPhaseObserver * layoutPhaseObserver)
+{
+  d->hasLayoutPhaseObserver = layoutPhaseObserver != nullptr;
+
+  if(d->hasLayoutPhaseObserver)
+  {
+    d->layoutPhaseObserver = *layoutPhaseObserver;
+  }
+}
+
+void RowLayout::setLayoutTracer(LayoutTracer * layoutTracer)
+{
+  d->layoutTracer = layoutTracer;
+}
+
+void RowLayout::setLayoutStatsEnabled(bool layoutStatsEnabled)
+{
+  d->layoutStatsEnabled = layoutStatsEnabled;
+}
+
+bool RowLayout::isLayoutStatsEnabled() const
+{
+  return d->layoutStatsEnabled;
+}
+
+const LayoutStats& RowLayout::getLayoutStats() const
+{
+  return d->layoutStats;
+}
+
+bool RowLayout::isLayoutPending() const
+{
+  return d->layoutPending;
+}
+
+void RowLayout::flushLayout()
+{
+  if(d->layoutPending)
+  {
+    executeLayout(d->rowLayoutContainer);
+  }
+}
+
+LayoutSnapshot RowLayout::takeSnapshot(UiComponent * container)
+{
+  LayoutSnapshot layoutSnapshot;
+
+  d->takeSnapshot(container, layoutSnapshot.d);
+
+  return layoutSnapshot;
+}
+
+LayoutResult RowLayout::computeLayout(const LayoutSnapshot& layoutSnapshot)
+{
+  LayoutResult layoutResult;
+
+  ::computeLayoutResult(*layoutSnapshot.d, layoutResult.d);
+
+  return layoutResult;
+}
+
+bool RowLayout::commit(const LayoutResult& layoutResult)
+{
+  return d->commit(*layoutResult.d);
+}
+
+LayoutMeasurement RowLayout::measure(int availableWidth)
+{
+  LayoutMeasurement layoutMeasurement;
+
+  d->measure(availableWidth, &layoutMeasurement);
+
+  return layoutMeasurement;
+}
+
+void RowLayout::setLayoutThreadCount(std::size_t threadCount)
+{
+  d->layoutThreadPool.setThreadCount(threadCount);
+}
+
+void RowLayout::setViewport(int y, int height)
+{
+  if(d->hasViewport && d->viewportY == y && d->viewportHeight == height)
+  {
+    return;
+  }
+
+  d->hasViewport = true;
+  d->viewportY = y;
+  d->viewportHeight = height;
+
+  d->requestLayout(this);
+}
+
+void RowLayout::clearViewport()
+{
+  if(!d->hasViewport)
+  {
+    return;
+  }
+
+  d->hasViewport = false;
+
+  // The rows out of view are laid out during the next layout pass.
+  d->requestLayout(this);
+}
+
+std::size_t RowLayout::getRowAtY(int y) const
+{
+  return d->rowOffsetIndex.find(y - d->rowOffsetOrigin, d->indexedEstimatedRowHeight);
+}
+
+int RowLayout::getRowTop(std::size_t row) const
+{
+  return d->getRowTop(row);
+}
+
+UiComponent * RowLayout::getUiComponentAtPoint(int x, int y) const
+{
+  const std::size_t rowIndex = getRowAtY(y);
+
+  if(rowIndex >= d->rows.size())
+  {
+    return nullptr;
+  }
+
+  const RowLayout::Row::RowPrivate * rowPrivate = d->rows.at(rowIndex)->d;
+
+  const int rowY = y - d->getRowTop(rowIndex);
+
+  // Only the entries that start at most the width of the widest entry left
+  // of the point can contain it.
+  UiComponentBounds leftmost;
+  leftmost.x = x - rowPrivate->widestHitBounds;
+
+  UiComponentBounds rightmost;
+  rightmost.x = x;
+
+  std::vector<UiComponentBounds>::const_iterator it = std::upper_bound(rowPrivate->hitBounds.begin(),
+                                                                       rowPrivate->hitBounds.end(),
+                                                                       leftmost,
+                                                                       &::isLeftOf);
+
+  std::vector<UiComponentBounds>::const_iterator end = std::upper_bound(it,
+                                                                        rowPrivate->hitBounds.end(),
+                                                                        rightmost,
+                                                                        &::isLeftOf);
+
+  for(; it != end; ++it)
+  {
+    if(x < it->x + it->width && rowY >= it->y && rowY < it->y + it->height)
+    {
+      return it->uiComponent;
+    }
+  }
+
+  return nullptr;
+}
+
+void RowLayout::setEstimatedRowHeight(int estimatedRowHeight)
+{
+  d->estimatedRowHeight = estimatedRowHeight;
+
+  if(d->hasViewport)
+  {
+    d->requestLayout(this);
+  }
 }
 
 void RowLayout::executeLayout(UiComponent * container)
 {
+  LayoutPhaseScope layoutPhaseScope(d, LayoutPhase::LayoutPassPhase);
+  LayoutStatsScope layoutStatsScope(d);
+
+  // This layout pass handles every change made so far. Changes made while
+  // laying out request another layout pass.
+  d->layoutPending = false;
+
+  // The layout passes below walk the ids of each row as a contiguous range.
+  if(!d->uiComponentIdsInRowOrder)
+  {
+    d->compactUiComponentIds();
+  }
+
+  // Lay out every row again if the container changed since the last layout
+  // pass.
+  d->invalidateIfContainerChanged(container);
+
+  if(d->hasViewport)
+  {
+    d->layoutViewport(this, container);
+
+    return;
+  }
+
   d->preLayout(this);
 
   // Now that you have the actual sizes of the UiComponents, calculate the
@@ -1427,9 +4697,8 @@ void RowLayout::executeLayout(UiComponent * container)
 
   d->resizeUiComponentsInSizeGroups();
 
-  // You need to resize the previous and next label rows to account for
-  // potential size group adjustments
-  d->resizePreviousAndNextLabelRows(this);
+  // Size the label rows once the labels have their final size.
+  d->resizeLabelRows(0, d->rows.size());
 
   d->postLayout(this, container);
 }
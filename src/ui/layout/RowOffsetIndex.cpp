@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: RowOffsetIndex.cpp
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ui/layout/private/RowOffsetIndex.h"
+
+RowOffsetIndex::RowOffsetIndex()
+{
+
+}
+
+RowOffsetIndex::~RowOffsetIndex()
+{
+
+}
+
+std::size_t RowOffsetIndex::size() const
+{
+  return heights.size();
+}
+
+void RowOffsetIndex::append()
+{
+  heights.push_back(0);
+  known.push_back(0);
+
+  // The new element sums the rows [i - (i & -i), i), which are the new row
+  // and the elements of the rows before it that end where that range starts.
+  const std::size_t i = heights.size();
+  const std::size_t first = i - (i & (~i + 1));
+
+  int unknownCount = 1;
+  int height = 0;
+
+  for(std::size_t j = i - 1; j > first; j -= j & (~j + 1))
+  {
+    height += heightTree.at(j - 1);
+    unknownCount += unknownCountTree.at(j - 1);
+  }
+
+  heightTree.push_back(height);
+  unknownCountTree.push_back(unknownCount);
+}
+
+void RowOffsetIndex::setHeight(std::size_t index,
+                               int height)
+{
+  if(known.at(index))
+  {
+    add(index, height - heights.at(index), 0);
+  }
+  else
+  {
+    add(index, height, -1);
+  }
+
+  heights.at(index) = height;
+  known.at(index) = 1;
+}
+
+void RowOffsetIndex::setUnknown(std::size_t index)
+{
+  if(known.at(index))
+  {
+    add(index, -heights.at(index), 1);
+  }
+
+  heights.at(index) = 0;
+  known.at(index) = 0;
+}
+
+int RowOffsetIndex::getOffset(std::size_t index,
+                              int estimatedHeight) const
+{
+  int height = 0;
+  int unknownCount = 0;
+
+  for(std::size_t i = index; i > 0; i -= i & (~i + 1))
+  {
+    height += heightTree.at(i - 1);
+    unknownCount += unknownCountTree.at(i - 1);
+  }
+
+  return height + unknownCount * estimatedHeight;
+}
+
+std::size_t RowOffsetIndex::find(int offset,
+                                 int estimatedHeight) const
+{
+  if(offset < 0)
+  {
+    return heights.size();
+  }
+
+  std::size_t step = 1;
+
+  while(step * 2 <= heights.size())
+  {
+    step *= 2;
+  }
+
+  // Skip every row that ends at or before the offset, from the largest
+  // ranges of rows down to single rows.
+  std::size_t index = 0;
+  int rowsEnd = 0;
+
+  for(; step > 0; step /= 2)
+  {
+    if(index + step <= heights.size())
+    {
+      const int end = rowsEnd + heightTree.at(index + step - 1) +
+                      unknownCountTree.at(index + step - 1) * estimatedHeight;
+
+      if(end <= offset)
+      {
+        index += step;
+        rowsEnd = end;
+      }
+    }
+  }
+
+  return index;
+}
+
+void RowOffsetIndex::add(std::size_t index,
+                         int height,
+                         int unknownCount)
+{
+  for(std::size_t i = index + 1; i <= heights.size(); i += i & (~i + 1))
+  {
+    heightTree.at(i - 1) += height;
+    unknownCountTree.at(i - 1) += unknownCount;
+  }
+}
@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: SizeGroup.cpp
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "ui/layout/private/UiComponentWrapper.h"
+
+#include "ui/layout/private/SizeGroup.h"
+
+SizeGroup::SizeGroup()
+:lastMaxWidth(0),
+ lastMaxHeight(0),
+ changed(false),
+ capacity(0)
+{
+
+}
+
+std::size_t SizeGroup::add(SizeGroupIdentifier sizeGroupIdentifier,
+                           UiComponentWrapper * uiComponentWrapper)
+{
+  if(members.size() == capacity)
+  {
+    grow();
+  }
+
+  members.push_back(std::pair<SizeGroupIdentifier, UiComponentWrapper *>(sizeGroupIdentifier,
+                                                                          uiComponentWrapper));
+
+  // The leaf of the new member is still zero, so the maximum is unchanged.
+  return members.size() - 1;
+}
+
+void SizeGroup::remove(std::size_t slot)
+{
+  const std::size_t lastSlot = members.size() - 1;
+
+  // The order of the members does not matter, so fill the hole with the last
+  // member instead of shifting every member after it.
+  if(slot != lastSlot)
+  {
+    members.at(slot) = members.at(lastSlot);
+
+    update(slot, maxWidths.at(capacity + lastSlot), maxHeights.at(capacity + lastSlot));
+
+    if(members.at(slot).first == LabelGroup)
+    {
+      members.at(slot).second->labelSizeGroupSlot = slot;
+    }
+    else
+    {
+      members.at(slot).second->sizeGroupSlot = slot;
+    }
+  }
+
+  update(lastSlot, 0, 0);
+
+  members.pop_back();
+}
+
+bool SizeGroup::update(std::size_t slot, int width, int height)
+{
+  std::size_t node = capacity + slot;
+
+  if(maxWidths.at(node) == width && maxHeights.at(node) == height)
+  {
+    return false;
+  }
+
+  maxWidths.at(node) = width;
+  maxHeights.at(node) = height;
+
+  // Walk up to the root, the maximum of every ancestor may have changed.
+  for(node /= 2; node > 0; node /= 2)
+  {
+    maxWidths.at(node) = std::max(maxWidths.at(2 * node), maxWidths.at(2 * node + 1));
+    maxHeights.at(node) = std::max(maxHeights.at(2 * node), maxHeights.at(2 * node + 1));
+  }
+
+  return true;
+}
+
+int SizeGroup::getMaxWidth() const
+{
+  return capacity == 0 ? 0 : maxWidths.at(1);
+}
+
+int SizeGroup::getMaxHeight() const
+{
+  return capacity == 0 ? 0 : maxHeights.at(1);
+}
+
+std::size_t SizeGroup::getMemberCount() const
+{
+  return members.size();
+}
+
+SizeGroupIdentifier SizeGroup::getSizeGroupIdentifierAt(std::size_t slot) const
+{
+  return members.at(slot).first;
+}
+
+UiComponentWrapper * SizeGroup::getUiComponentWrapperAt(std::size_t slot) const
+{
+  return members.at(slot).second;
+}
+
+void SizeGroup::grow()
+{
+  const std::size_t newCapacity = capacity == 0 ? 4 : capacity * 2;
+
+  std::vector<int> newMaxWidths(2 * newCapacity, 0);
+  std::vector<int> newMaxHeights(2 * newCapacity, 0);
+
+  std::copy(maxWidths.begin() + capacity,
+            maxWidths.begin() + capacity + members.size(),
+            newMaxWidths.begin() + newCapacity);
+  std::copy(maxHeights.begin() + capacity,
+            maxHeights.begin() + capacity + members.size(),
+            newMaxHeights.begin() + newCapacity);
+
+  // Rebuild the inner nodes from the leaves.
+  for(std::size_t node = newCapacity - 1; node > 0; --node)
+  {
+    newMaxWidths.at(node) = std::max(newMaxWidths.at(2 * node), newMaxWidths.at(2 * node + 1));
+    newMaxHeights.at(node) = std::max(newMaxHeights.at(2 * node), newMaxHeights.at(2 * node + 1));
+  }
+
+  maxWidths.swap(newMaxWidths);
+  maxHeights.swap(newMaxHeights);
+
+  capacity = newCapacity;
+}
@@ -0,0 +1,270 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: UiComponentInternals.cpp
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "ui/layout/private/UiComponentInternals.h"
+
+std::size_t UiComponentInternals::add(UiComponent * uiComponent, Label * labelPeer)
+{
+  const std::size_t id = size();
+
+  this->uiComponent.push_back(uiComponent);
+  this->labelPeer.push_back(labelPeer);
+
+  // Set by the owner, which knows the complete types.
+  uiComponentMeasurable.push_back(nullptr);
+  labelMeasurable.push_back(nullptr);
+  labelText.push_back(nullptr);
+
+  labelMeasuredWidth.push_back(0);
+  labelMeasuredHeight.push_back(0);
+
+  uiComponentMeasuredWidth.push_back(0);
+  uiComponentMeasuredHeight.push_back(0);
+
+  // A new uiComponent has never been measured.
+  needsMeasure.push_back(1);
+
+  labelPreferredHeight.push_back(0);
+  labelPreferredWidth.push_back(0);
+
+  uiComponentPreferredWidth.push_back(0);
+  uiComponentPreferredHeight.push_back(0);
+
+  labelX.push_back(0);
+  labelY.push_back(0);
+
+  uiComponentX.push_back(0);
+  uiComponentY.push_back(0);
+
+  horizontalGapLeft.push_back(-1);
+  horizontalGapRight.push_back(-1);
+
+  // Nothing was applied to a new uiComponent yet.
+  labelAppliedX.push_back(NotApplied);
+  labelAppliedY.push_back(NotApplied);
+  labelAppliedWidth.push_back(NotApplied);
+  labelAppliedHeight.push_back(NotApplied);
+
+  uiComponentAppliedX.push_back(NotApplied);
+  uiComponentAppliedY.push_back(NotApplied);
+  uiComponentAppliedWidth.push_back(NotApplied);
+  uiComponentAppliedHeight.push_back(NotApplied);
+
+  return id;
+}
+
+std::size_t UiComponentInternals::addCopy(const UiComponentInternals& source, std::size_t id)
+{
+  const std::size_t copyId = size();
+
+  uiComponent.push_back(source.uiComponent[id]);
+  labelPeer.push_back(source.labelPeer[id]);
+
+  uiComponentMeasurable.push_back(source.uiComponentMeasurable[id]);
+  labelMeasurable.push_back(source.labelMeasurable[id]);
+  labelText.push_back(source.labelText[id]);
+
+  labelMeasuredWidth.push_back(source.labelMeasuredWidth[id]);
+  labelMeasuredHeight.push_back(source.labelMeasuredHeight[id]);
+
+  uiComponentMeasuredWidth.push_back(source.uiComponentMeasuredWidth[id]);
+  uiComponentMeasuredHeight.push_back(source.uiComponentMeasuredHeight[id]);
+
+  needsMeasure.push_back(source.needsMeasure[id]);
+
+  labelPreferredHeight.push_back(source.labelPreferredHeight[id]);
+  labelPreferredWidth.push_back(source.labelPreferredWidth[id]);
+
+  uiComponentPreferredWidth.push_back(source.uiComponentPreferredWidth[id]);
+  uiComponentPreferredHeight.push_back(source.uiComponentPreferredHeight[id]);
+
+  labelX.push_back(source.labelX[id]);
+  labelY.push_back(source.labelY[id]);
+
+  uiComponentX.push_back(source.uiComponentX[id]);
+  uiComponentY.push_back(source.uiComponentY[id]);
+
+  horizontalGapLeft.push_back(source.horizontalGapLeft[id]);
+  horizontalGapRight.push_back(source.horizontalGapRight[id]);
+
+  labelAppliedX.push_back(source.labelAppliedX[id]);
+  labelAppliedY.push_back(source.labelAppliedY[id]);
+  labelAppliedWidth.push_back(source.labelAppliedWidth[id]);
+  labelAppliedHeight.push_back(source.labelAppliedHeight[id]);
+
+  uiComponentAppliedX.push_back(source.uiComponentAppliedX[id]);
+  uiComponentAppliedY.push_back(source.uiComponentAppliedY[id]);
+  uiComponentAppliedWidth.push_back(source.uiComponentAppliedWidth[id]);
+  uiComponentAppliedHeight.push_back(source.uiComponentAppliedHeight[id]);
+
+  return copyId;
+}
+
+void UiComponentInternals::remove(std::size_t id)
+{
+  // Leave a hole so that the ids of the other uiComponents stay valid.
+  uiComponent[id] = nullptr;
+  labelPeer[id] = nullptr;
+  uiComponentMeasurable[id] = nullptr;
+  labelMeasurable[id] = nullptr;
+  labelText[id] = nullptr;
+  needsMeasure[id] = 0;
+}
+
+void UiComponentInternals::forgetAppliedBounds()
+{
+  std::fill(labelAppliedX.begin(), labelAppliedX.end(), static_cast<int>(NotApplied));
+  std::fill(labelAppliedY.begin(), labelAppliedY.end(), static_cast<int>(NotApplied));
+  std::fill(labelAppliedWidth.begin(), labelAppliedWidth.end(), static_cast<int>(NotApplied));
+  std::fill(labelAppliedHeight.begin(), labelAppliedHeight.end(), static_cast<int>(NotApplied));
+
+  std::fill(uiComponentAppliedX.begin(), uiComponentAppliedX.end(), static_cast<int>(NotApplied));
+  std::fill(uiComponentAppliedY.begin(), uiComponentAppliedY.end(), static_cast<int>(NotApplied));
+  std::fill(uiComponentAppliedWidth.begin(), uiComponentAppliedWidth.end(), static_cast<int>(NotApplied));
+  std::fill(uiComponentAppliedHeight.begin(), uiComponentAppliedHeight.end(), static_cast<int>(NotApplied));
+}
+
+std::size_t UiComponentInternals::size() const
+{
+  return uiComponent.size();
+}
+
+void UiComponentInternals::reserve(std::size_t capacity)
+{
+  uiComponent.reserve(capacity);
+  labelPeer.reserve(capacity);
+
+  uiComponentMeasurable.reserve(capacity);
+  labelMeasurable.reserve(capacity);
+  labelText.reserve(capacity);
+
+  labelMeasuredWidth.reserve(capacity);
+  labelMeasuredHeight.reserve(capacity);
+
+  uiComponentMeasuredWidth.reserve(capacity);
+  uiComponentMeasuredHeight.reserve(capacity);
+
+  needsMeasure.reserve(capacity);
+
+  labelPreferredHeight.reserve(capacity);
+  labelPreferredWidth.reserve(capacity);
+
+  uiComponentPreferredWidth.reserve(capacity);
+  uiComponentPreferredHeight.reserve(capacity);
+
+  labelX.reserve(capacity);
+  labelY.reserve(capacity);
+
+  uiComponentX.reserve(capacity);
+  uiComponentY.reserve(capacity);
+
+  horizontalGapLeft.reserve(capacity);
+  horizontalGapRight.reserve(capacity);
+
+  labelAppliedX.reserve(capacity);
+  labelAppliedY.reserve(capacity);
+  labelAppliedWidth.reserve(capacity);
+  labelAppliedHeight.reserve(capacity);
+
+  uiComponentAppliedX.reserve(capacity);
+  uiComponentAppliedY.reserve(capacity);
+  uiComponentAppliedWidth.reserve(capacity);
+  uiComponentAppliedHeight.reserve(capacity);
+}
+
+void UiComponentInternals::clear()
+{
+  uiComponent.clear();
+  labelPeer.clear();
+
+  uiComponentMeasurable.clear();
+  labelMeasurable.clear();
+  labelText.clear();
+
+  labelMeasuredWidth.clear();
+  labelMeasuredHeight.clear();
+
+  uiComponentMeasuredWidth.clear();
+  uiComponentMeasuredHeight.clear();
+
+  needsMeasure.clear();
+
+  labelPreferredHeight.clear();
+  labelPreferredWidth.clear();
+
+  uiComponentPreferredWidth.clear();
+  uiComponentPreferredHeight.clear();
+
+  labelX.clear();
+  labelY.clear();
+
+  uiComponentX.clear();
+  uiComponentY.clear();
+
+  horizontalGapLeft.clear();
+  horizontalGapRight.clear();
+
+  labelAppliedX.clear();
+  labelAppliedY.clear();
+  labelAppliedWidth.clear();
+  labelAppliedHeight.clear();
+
+  uiComponentAppliedX.clear();
+  uiComponentAppliedY.clear();
+  uiComponentAppliedWidth.clear();
+  uiComponentAppliedHeight.clear();
+}
+
+void UiComponentInternals::swap(UiComponentInternals& other)
+{
+  uiComponent.swap(other.uiComponent);
+  labelPeer.swap(other.labelPeer);
+
+  uiComponentMeasurable.swap(other.uiComponentMeasurable);
+  labelMeasurable.swap(other.labelMeasurable);
+  labelText.swap(other.labelText);
+
+  labelMeasuredWidth.swap(other.labelMeasuredWidth);
+  labelMeasuredHeight.swap(other.labelMeasuredHeight);
+
+  uiComponentMeasuredWidth.swap(other.uiComponentMeasuredWidth);
+  uiComponentMeasuredHeight.swap(other.uiComponentMeasuredHeight);
+
+  needsMeasure.swap(other.needsMeasure);
+
+  labelPreferredHeight.swap(other.labelPreferredHeight);
+  labelPreferredWidth.swap(other.labelPreferredWidth);
+
+  uiComponentPreferredWidth.swap(other.uiComponentPreferredWidth);
+  uiComponentPreferredHeight.swap(other.uiComponentPreferredHeight);
+
+  labelX.swap(other.labelX);
+  labelY.swap(other.labelY);
+
+  uiComponentX.swap(other.uiComponentX);
+  uiComponentY.swap(other.uiComponentY);
+
+  horizontalGapLeft.swap(other.horizontalGapLeft);
+  horizontalGapRight.swap(other.horizontalGapRight);
+
+  labelAppliedX.swap(other.labelAppliedX);
+  labelAppliedY.swap(other.labelAppliedY);
+  labelAppliedWidth.swap(other.labelAppliedWidth);
+  labelAppliedHeight.swap(other.labelAppliedHeight);
+
+  uiComponentAppliedX.swap(other.uiComponentAppliedX);
+  uiComponentAppliedY.swap(other.uiComponentAppliedY);
+  uiComponentAppliedWidth.swap(other.uiComponentAppliedWidth);
+  uiComponentAppliedHeight.swap(other.uiComponentAppliedHeight);
+}
@@ -0,0 +1,61 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: UiComponentSize.cpp
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ui/layout/UiComponentSize.h"
+
+UiComponentSize::UiComponentSize()
+{
+}
+
+UiComponentSize::~UiComponentSize()
+{
+}
+
+/*static*/ int UiComponentSize::getButtonWidth()
+{
+  /*
+   * The GNOME Human Interface Guidelines do not recommend a width for
+   * buttons, they are as wide as their text. Use the same width as on Windows
+   * so that forms of buttons with short text look the same on both.
+   */
+  return 75;
+}
+
+/*static*/ int UiComponentSize::getButtonHeight()
+{
+  /*
+   * A text button of the default GTK theme, Adwaita, has a minimum height of
+   * 24 pixels, 4 pixels of padding and a 1 pixel border above and below.
+   */
+  return 34;
+}
+
+/*static*/ int UiComponentSize::getLabelHeight()
+{
+  /*
+   * One line of the default Cantarell 11 pt font, whose em is about 15 pixels
+   * at 96 DPI.
+   */
+  return 18;
+}
+
+/*static*/ int UiComponentSize::getVerticalSpaceBetweenRows()
+{
+  // The GNOME Human Interface Guidelines spacing between unrelated groups.
+  return 12;
+}
+
+/*static*/ int UiComponentSize::getHorizontalGap()
+{
+  // The GNOME Human Interface Guidelines spacing between related controls.
+  return 6;
+}
@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LabelMeasurementCache.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_PRIVATE_LABELMEASUREMENTCACHE_H_
+#define UI_LAYOUT_PRIVATE_LABELMEASUREMENTCACHE_H_
+
+#include <climits>
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+/**
+ * The preferred sizes of label texts keyed by font and text. Holds at most
+ * the capacity number of sizes, the least recently used size is dropped to
+ * make room for a new one.
+ */
+class LabelMeasurementCache
+{
+  public:
+
+    enum
+    {
+      DefaultCapacity = 256,
+
+      // The size of a text that is still being measured.
+      NotMeasured = INT_MIN
+    };
+
+    LabelMeasurementCache();
+
+    ~LabelMeasurementCache();
+
+    /**
+     * Find the size of the specified text in the specified font and mark it
+     * as the most recently used size. Counts a hit or a miss, unless the size
+     * is NotMeasured.
+     *
+     * @param[in] fontIdentity the identity of the font.
+     *
+     * @param[in] text the text.
+     *
+     * @param[out] width the width of the text. Only set if the size is found.
+     *
+     * @param[out] height the height of the text. Only set if the size is
+     * found.
+     *
+     * @return true if the size is found, false otherwise.
+     */
+    bool find(const void * fontIdentity,
+              const std::string& text,
+              int * width,
+              int * height);
+
+    /**
+     * Remember the size of the specified text in the specified font.
+     *
+     * @param[in] fontIdentity the identity of the font.
+     *
+     * @param[in] text the text.
+     *
+     * @param[in] width the width of the text.
+     *
+     * @param[in] height the height of the text.
+     */
+    void insert(const void * fontIdentity,
+                const std::string& text,
+                int width,
+                int height);
+
+    /**
+     * Forget the sizes of every text in the specified font.
+     *
+     * @param[in] fontIdentity the identity of the font.
+     */
+    void removeFont(const void * fontIdentity);
+
+    void clear();
+
+    /**
+     * Set the largest number of sizes this cache holds, 0 disables the cache.
+     *
+     * @param[in] capacity the largest number of sizes.
+     */
+    void setCapacity(std::size_t capacity);
+
+    std::size_t getCapacity() const;
+
+    std::size_t size() const;
+
+    std::size_t getHitCount() const;
+
+    std::size_t getMissCount() const;
+
+    /**
+     * Returns the number of sizes added to this cache. Replacing the size of
+     * a text that is already in the cache is not counted.
+     */
+    std::size_t getInsertCount() const;
+
+  private:
+
+    struct Entry
+    {
+        const void * fontIdentity;
+        std::string text;
+        std::size_t hash;
+        int width;
+        int height;
+    };
+
+    static std::size_t getHash(const void * fontIdentity,
+                               const std::string& text);
+
+    void erase(std::list<Entry>::iterator entry);
+
+    // The entries from the most recently used to the least recently used.
+    std::list<Entry> entries;
+
+    // Maps the hash of the font and the text of every entry to the entry.
+    // Looking up by hash does not copy the text.
+    std::unordered_multimap<std::size_t, std::list<Entry>::iterator> entryIndex;
+
+    std::size_t capacity;
+
+    std::size_t hitCount;
+    std::size_t missCount;
+    std::size_t insertCount;
+};
+#endif /* UI_LAYOUT_PRIVATE_LABELMEASUREMENTCACHE_H_ */
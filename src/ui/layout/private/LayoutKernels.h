@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutKernels.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_PRIVATE_LAYOUTKERNELS_H_
+#define UI_LAYOUT_PRIVATE_LAYOUTKERNELS_H_
+
+#include <cstddef>
+
+/**
+ * The instruction sets the layout kernels are implemented with.
+ */
+enum LayoutKernelLevel
+{
+  ScalarLayoutKernels,
+  Sse2LayoutKernels,
+  Avx2LayoutKernels
+};
+
+/**
+ * The operations the layout passes apply to ranges of packed coordinates and
+ * sizes, such as the ranges of UiComponentInternals that belong to one row.
+ */
+struct LayoutKernels
+{
+    /**
+     * Add the specified distance to every value.
+     */
+    void (*addToValues)(int * values,
+                        std::size_t count,
+                        int distance);
+
+    /**
+     * Return the largest of the values and the specified initial value.
+     */
+    int (*getMaxValue)(const int * values,
+                       std::size_t count,
+                       int initialValue);
+
+    /**
+     * Return the sum of the values, each clamped to be at least 0.
+     */
+    int (*getSumOfPositiveValues)(const int * values,
+                                  std::size_t count);
+};
+
+/**
+ * Return the best level the processor supports. Determined once.
+ */
+LayoutKernelLevel getSupportedLayoutKernelLevel();
+
+/**
+ * Return the kernels of the specified level, or of the best supported level
+ * below it if the processor does not support the specified level.
+ *
+ * @param[in] layoutKernelLevel the level of the kernels.
+ */
+const LayoutKernels& getLayoutKernels(LayoutKernelLevel layoutKernelLevel);
+
+/**
+ * Return the kernels of the best level the processor supports.
+ */
+const LayoutKernels& getLayoutKernels();
+#endif /* UI_LAYOUT_PRIVATE_LAYOUTKERNELS_H_ */
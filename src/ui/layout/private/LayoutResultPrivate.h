@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutResultPrivate.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_PRIVATE_LAYOUTRESULTPRIVATE_H_
+#define UI_LAYOUT_PRIVATE_LAYOUTRESULTPRIVATE_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "ui/layout/LayoutMeasurement.h"
+#include "ui/layout/UiComponentBounds.h"
+
+class UiComponent;
+class RowLayoutPrivate;
+
+class LayoutResultPrivate
+{
+  public:
+
+    LayoutResultPrivate();
+
+    // The layout the snapshot of this result was taken from, only that
+    // layout may commit this result.
+    const RowLayoutPrivate * rowLayoutPrivate;
+
+    UiComponent * container;
+
+    // The revision of the layout the snapshot of this result was taken from.
+    std::size_t layoutRevision;
+
+    int preferredWidth;
+    int preferredHeight;
+
+    std::vector<UiComponentBounds> bounds;
+
+    // The id within RowLayoutPrivate::uiComponentInternals of the label or
+    // uiComponent of each entry in bounds.
+    std::vector<std::size_t> boundsId;
+
+    std::vector<RowExtent> rowExtents;
+};
+#endif /* UI_LAYOUT_PRIVATE_LAYOUTRESULTPRIVATE_H_ */
@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutSnapshotPrivate.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_PRIVATE_LAYOUTSNAPSHOTPRIVATE_H_
+#define UI_LAYOUT_PRIVATE_LAYOUTSNAPSHOTPRIVATE_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "ui/layout/LabelOrientation.h"
+#include "ui/layout/LabelVerticalAlignment.h"
+#include "ui/layout/Padding.h"
+#include "ui/layout/RowOrientation.h"
+
+class UiComponent;
+class Label;
+class RowLayoutPrivate;
+
+/**
+ * The inputs of a layout pass, stored as one contiguous array per field. The
+ * uiComponents of all rows are stored in row order, each row owns the range
+ * [rowFirstItem, rowFirstItem + rowItemCount) of the item arrays.
+ *
+ * The sizes already account for size groups and the gaps already account for
+ * the platform defaults, so computing a layout from a snapshot only needs
+ * the snapshot.
+ */
+class LayoutSnapshotPrivate
+{
+  public:
+
+    LayoutSnapshotPrivate();
+
+    // The layout this snapshot was taken from, nullptr until one is taken.
+    const RowLayoutPrivate * rowLayoutPrivate;
+
+    UiComponent * container;
+    int containerClientWidth;
+    int containerClientHeight;
+    Padding containerPadding;
+
+    int verticalSpaceBetweenRows;
+
+    // The revision of the layout when this snapshot was taken. See
+    // RowLayoutPrivate::layoutRevision.
+    std::size_t layoutRevision;
+
+    std::vector<std::size_t> rowFirstItem;
+    std::vector<std::size_t> rowItemCount;
+    std::vector<int> rowHorizontalSpace;
+    std::vector<RowOrientation::Value> rowOrientation;
+
+    // The id of each item within RowLayoutPrivate::uiComponentInternals.
+    std::vector<std::size_t> id;
+
+    std::vector<UiComponent *> uiComponent;
+    std::vector<Label *> labelPeer;
+
+    std::vector<int> uiComponentWidth;
+    std::vector<int> uiComponentHeight;
+    std::vector<int> labelWidth;
+    std::vector<int> labelHeight;
+
+    // The gap between an item and the item before it in its row, not counting
+    // the horizontal space of the row.
+    std::vector<int> gapBefore;
+
+    std::vector<LabelOrientation::Value> labelOrientation;
+    std::vector<LabelVerticalAlignment::Value> labelVerticalAlignment;
+
+    std::vector<int> growX;
+    std::vector<int> growY;
+};
+#endif /* UI_LAYOUT_PRIVATE_LAYOUTSNAPSHOTPRIVATE_H_ */
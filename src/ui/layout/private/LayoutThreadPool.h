@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutThreadPool.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_PRIVATE_LAYOUTTHREADPOOL_H_
+#define UI_LAYOUT_PRIVATE_LAYOUTTHREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A fixed set of worker threads that run the tasks of a layout pass together
+ * with the thread that started the layout pass. The workers sleep between
+ * layout passes.
+ */
+class LayoutThreadPool
+{
+  public:
+
+    LayoutThreadPool();
+
+    ~LayoutThreadPool();
+
+    /**
+     * Set the number of threads that run tasks, including the calling
+     * thread. A thread count of 0 or 1 runs every task on the calling thread.
+     *
+     * @param[in] threadCount the number of threads.
+     */
+    void setThreadCount(std::size_t threadCount);
+
+    /**
+     * Return the number of threads that run tasks, including the calling
+     * thread.
+     *
+     * @return the number of threads that run tasks.
+     */
+    std::size_t getThreadCount() const;
+
+    /**
+     * Call the specified task once for every task index in
+     * [0, taskCount), spread across the threads of this pool. Returns once
+     * every call returned.
+     *
+     * @param[in] taskCount the number of task indices.
+     *
+     * @param[in] task the function to call with each task index.
+     *
+     * @param[in] userData passed as is to the task.
+     */
+    void run(std::size_t taskCount,
+             void (*task)(std::size_t taskIndex, void * userData),
+             void * userData);
+
+  private:
+
+    LayoutThreadPool(const LayoutThreadPool&);
+    LayoutThreadPool& operator=(const LayoutThreadPool&);
+
+    void stopWorkers();
+
+    void workerLoop(std::size_t lastGeneration);
+
+    void runTasks();
+
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable workDone;
+
+    // Incremented every time run hands out new tasks.
+    std::size_t generation;
+
+    bool stopping;
+
+    // The workers that did not finish the tasks of the current generation.
+    std::size_t busyWorkerCount;
+
+    std::size_t taskCount;
+    void (*task)(std::size_t taskIndex, void * userData);
+    void * userData;
+
+    std::atomic<std::size_t> nextTaskIndex;
+};
+#endif /* UI_LAYOUT_PRIVATE_LAYOUTTHREADPOOL_H_ */
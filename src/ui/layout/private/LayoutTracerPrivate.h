@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: LayoutTracerPrivate.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_PRIVATE_LAYOUTTRACERPRIVATE_H_
+#define UI_LAYOUT_PRIVATE_LAYOUTTRACERPRIVATE_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ui/layout/LayoutPhase.h"
+
+// A begin or an end of a phase.
+struct LayoutTraceEvent
+{
+    LayoutPhase::Value layoutPhase;
+
+    // 'B' for a begin, 'E' for an end, as in the trace event format.
+    char eventType;
+
+    // Nanoseconds since the tracer was created.
+    long long timestamp;
+
+    // The index of the recording thread within LayoutTracerPrivate::threadIds
+    // plus 1.
+    std::size_t threadId;
+
+    std::size_t rowCount;
+
+    std::size_t uiComponentCount;
+};
+
+class LayoutTracerPrivate
+{
+  public:
+
+    explicit LayoutTracerPrivate(std::size_t eventCapacity);
+
+    void addEvent(LayoutPhase::Value layoutPhase,
+                  char eventType,
+                  std::size_t rowCount,
+                  std::size_t uiComponentCount);
+
+    std::size_t getThreadId(std::thread::id id);
+
+    static void appendEvent(const LayoutTraceEvent& layoutTraceEvent,
+                            std::string * json);
+
+    // Guards every member below, events are recorded on the threads that run
+    // the layout passes.
+    mutable std::mutex mutex;
+
+    std::chrono::steady_clock::time_point startTime;
+
+    // The ring buffer. Holds eventCount events, the oldest at firstEvent.
+    std::vector<LayoutTraceEvent> events;
+    std::size_t eventCapacity;
+    std::size_t firstEvent;
+    std::size_t eventCount;
+
+    // The threads that recorded events, in the order of their first event.
+    std::vector<std::thread::id> threadIds;
+
+    // The file the events are written to or nullptr.
+    std::FILE * file;
+
+    // True until the first event is written to file.
+    bool fileEmpty;
+};
+#endif /* UI_LAYOUT_PRIVATE_LAYOUTTRACERPRIVATE_H_ */
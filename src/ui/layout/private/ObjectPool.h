@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: ObjectPool.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_PRIVATE_OBJECTPOOL_H_
+#define UI_LAYOUT_PRIVATE_OBJECTPOOL_H_
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "ui/layout/LayoutAllocator.h"
+
+/**
+ * Hands out storage for objects of type T from large slabs. Storage that is
+ * given back is reused by later allocations. The slabs themselves are only
+ * returned when the pool is destroyed, so tearing down and rebuilding a layout
+ * does not touch the heap.
+ *
+ * The pool never constructs or destroys objects, that is up to the caller.
+ * Objects that are trivially destructible may simply be forgotten by calling
+ * releaseAll.
+ */
+template<typename T>
+class ObjectPool
+{
+  public:
+
+    ObjectPool()
+    :layoutAllocator(nullptr),
+     freeList(nullptr),
+     currentSlab(0),
+     slotsUsedInCurrentSlab(0)
+    {
+
+    }
+
+    ~ObjectPool()
+    {
+      for(std::size_t i = 0; i < slabs.size(); ++i)
+      {
+        if(layoutAllocator)
+        {
+          layoutAllocator->deallocate(slabs.at(i), slabSize(), layoutAllocator->userData);
+        }
+        else
+        {
+          ::operator delete(slabs.at(i));
+        }
+      }
+    }
+
+    /**
+     * Use the specified allocator for every slab allocated from now on. Must
+     * be called before the first allocation.
+     *
+     * @param[in] layoutAllocator the allocator or nullptr to use the global
+     * operator new.
+     */
+    void setLayoutAllocator(const LayoutAllocator * layoutAllocator)
+    {
+      this->layoutAllocator = layoutAllocator;
+    }
+
+    /**
+     * Return uninitialized storage for one object of type T.
+     */
+    void * allocate()
+    {
+      if(freeList)
+      {
+        FreeSlot * slot = freeList;
+        freeList = slot->next;
+
+        return slot;
+      }
+
+      if(currentSlab == slabs.size())
+      {
+        if(layoutAllocator)
+        {
+          slabs.push_back(static_cast<unsigned char *>(layoutAllocator->allocate(slabSize(), layoutAllocator->userData)));
+        }
+        else
+        {
+          slabs.push_back(static_cast<unsigned char *>(::operator new(slabSize())));
+        }
+      }
+
+      void * storage = slabs.at(currentSlab) + slotsUsedInCurrentSlab * slotSize();
+
+      if(++slotsUsedInCurrentSlab == SlotsPerSlab)
+      {
+        ++currentSlab;
+        slotsUsedInCurrentSlab = 0;
+      }
+
+      return storage;
+    }
+
+    /**
+     * Give back the storage of one object so that it can be reused. The object
+     * must already be destroyed.
+     */
+    void deallocate(void * storage)
+    {
+      FreeSlot * slot = static_cast<FreeSlot *>(storage);
+      slot->next = freeList;
+      freeList = slot;
+    }
+
+    /**
+     * Give back the storage of every object at once. The objects must already
+     * be destroyed or be trivially destructible. The slabs are kept for reuse.
+     */
+    void releaseAll()
+    {
+      freeList = nullptr;
+      currentSlab = 0;
+      slotsUsedInCurrentSlab = 0;
+    }
+
+  private:
+
+    ObjectPool(const ObjectPool&);
+    ObjectPool& operator=(const ObjectPool&);
+
+    struct FreeSlot
+    {
+        FreeSlot * next;
+    };
+
+    enum
+    {
+      SlotsPerSlab = 256
+    };
+
+    static std::size_t slotSize()
+    {
+      // Every slot must be able to hold either a T or a free list link and
+      // keep the next slot suitably aligned for both.
+      const std::size_t size = sizeof(T) > sizeof(FreeSlot) ? sizeof(T) : sizeof(FreeSlot);
+      const std::size_t alignment = alignof(T) > alignof(FreeSlot) ? alignof(T) : alignof(FreeSlot);
+
+      return (size + alignment - 1) / alignment * alignment;
+    }
+
+    static std::size_t slabSize()
+    {
+      return slotSize() * SlotsPerSlab;
+    }
+
+    const LayoutAllocator * layoutAllocator;
+
+    std::vector<unsigned char *> slabs;
+
+    FreeSlot * freeList;
+
+    // The slab that allocations are currently carved from and the number of
+    // slots already handed out from it.
+    std::size_t currentSlab;
+    std::size_t slotsUsedInCurrentSlab;
+};
+#endif /* UI_LAYOUT_PRIVATE_OBJECTPOOL_H_ */
@@ -14,39 +14,152 @@
 #define UI_LAYOUT_PRIVATE_ROWLAYOUTPRIVATE_H_
 
 #include <map>
-#include <memory>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
-class Size2D;
 class UiComponent;
+class LayoutResultPrivate;
+class LayoutTracer;
+class LayoutSnapshotPrivate;
+struct LabelRow;
+struct ParallelRowLayout;
+struct UiComponentConstraints;
+struct UiComponentEntry;
 struct UiComponentWrapper;
 
-// Which UiComponent in the UiComponent wrapper is part of the size group
-enum SizeGroupIdentifier
+#include "ui/layout/LayoutAllocator.h"
+#include "ui/layout/LayoutMeasurement.h"
+#include "ui/layout/LayoutMetrics.h"
+#include "ui/layout/LayoutPhaseObserver.h"
+#include "ui/layout/LayoutScheduler.h"
+#include "ui/layout/LayoutStats.h"
+#include "ui/layout/Padding.h"
+#include "ui/layout/RowLayout.h"
+#include "ui/layout/UiComponentBounds.h"
+
+#include "ui/layout/private/LabelMeasurementCache.h"
+#include "ui/layout/private/LayoutThreadPool.h"
+#include "ui/layout/private/ObjectPool.h"
+#include "ui/layout/private/RowOffsetIndex.h"
+#include "ui/layout/private/SizeGroup.h"
+#include "ui/layout/private/UiComponentInternals.h"
+
+// The measured sizes of the uiComponents of a layout at one DPI, indexed by
+// UiComponentWrapper::id. The sizes at an id are only valid while
+// uiComponent holds the uiComponent they were measured for.
+struct MeasuredSizes
 {
-  LabelGroup,
-  UiComponentGroup
-};
+  std::vector<UiComponent *> uiComponent;
 
-#include "ui/layout/RowLayout.h"
+  std::vector<int> labelWidth;
+  std::vector<int> labelHeight;
+
+  std::vector<int> uiComponentWidth;
+  std::vector<int> uiComponentHeight;
+};
 
 class RowLayoutPrivate
 {
   public:
 
-    RowLayoutPrivate(UiComponent * rowLayoutContainer);
+    enum
+    {
+      // The number of rows laid out by one task of a parallel layout pass.
+      // Layouts with fewer than two tasks worth of rows are laid out on the
+      // calling thread.
+      RowsPerLayoutTask = 512,
+
+      // The number of uiComponents measured by one task of a parallel
+      // measurement.
+      MeasurementsPerTask = 16
+    };
+
+    enum LabelMeasurement
+    {
+      // There is no label or its size was found in labelMeasurementCache.
+      LabelMeasured,
+
+      // The label is measured on the threads of layoutThreadPool.
+      LabelMeasuredByPool,
+
+      // A label with the same font and text is measured on the threads of
+      // layoutThreadPool, the size is taken from labelMeasurementCache
+      // afterwards.
+      LabelMeasuredByPeer
+    };
+
+    RowLayoutPrivate(UiComponent * rowLayoutContainer,
+                     const LayoutAllocator * layoutAllocator);
 
     ~RowLayoutPrivate();
 
-    std::auto_ptr<Size2D> getMaxUiComponentSize(const std::vector<std::pair<SizeGroupIdentifier, UiComponentWrapper *> >& uiComponentWrappers);
+    RowLayout::Row * createRow(RowLayout * thisRowLayout);
+
+    void destroyRow(RowLayout::Row * row);
+
+    LabelRow * createLabelRow();
+
+    void destroyLabelRow(LabelRow * labelRow);
+
+    void requestLayout(RowLayout * thisRowLayout);
+
+    void addToSizeGroups(UiComponentWrapper * uiComponentWrapper);
+
+    void addUiComponentsToRow(RowLayout::Row * row,
+                              const UiComponentEntry * uiComponentEntries,
+                              std::size_t count,
+                              std::vector<UiComponent *> * children);
+
+    void attachUiComponents(const std::vector<UiComponent *>& uiComponents);
+
+    std::size_t getSizeGroupIndex(int sizeGroupId);
+
+    void markSizeGroupChanged(std::size_t sizeGroupIndex);
+
+    void updateSizeGroups(UiComponentWrapper * uiComponentWrapper);
+
+    void removeUiComponentWrapper(UiComponentWrapper * uiComponentWrapper);
 
-    void resizeUiComponentsInSizeGroup(const std::vector<std::pair<SizeGroupIdentifier, UiComponentWrapper *> >& uiComponentWrappers,
-                                       std::auto_ptr<Size2D> maxSize);
+    UiComponentWrapper * findUiComponentWrapper(const UiComponent * uiComponent) const;
+
+    void markRowsOfChangedSizeGroups();
+
+    void resizeUiComponentsInRowToSizeGroups(RowLayout::Row * row);
 
     void resizeUiComponentsInSizeGroups();
 
-    void resizePreviousAndNextLabelRows(RowLayout * thisRowLayout);
+    void resizePreviousAndNextLabelRows(UiComponentWrapper * uiComponentWrapper);
+
+    void resizeLabelRows(std::size_t firstRowIndex, std::size_t endRowIndex);
+
+    void compactUiComponentIds();
+
+    void markRowForLayout(RowLayout::Row * row);
+
+    void invalidateAllRows();
+
+    void invalidateIfContainerChanged(UiComponent * container);
+
+    bool findLabelMeasurement(std::size_t id,
+                              bool * measuring);
+
+    void cacheLabelMeasurement(std::size_t id);
+
+    void measureUiComponent(std::size_t id);
+
+    void forgetMeasuredSizes(std::size_t id);
+
+    void saveMeasuredSizes();
+
+    void restoreMeasuredSizes(int previousDpi);
+
+    void measureUiComponentsInRow(RowLayout::Row * row);
+
+    void measureUiComponents(std::size_t firstRowIndex,
+                             std::size_t endRowIndex);
+
+    void resetUiComponentsInRow(RowLayout::Row * row);
 
     void preLayout(RowLayout * thisRowLayout);
 
@@ -89,40 +202,268 @@ class RowLayoutPrivate
                                 int * heightOfTallestUiComponentInRow,
                                 bool insertGaps);
 
-    void moveUiComponentsInRowRight(std::size_t rowIndex,
-                                    std::size_t uiComponentIndex,
-                                    int remainingWidth);
+    void layoutRowsOfTask(std::size_t taskIndex,
+                          ParallelRowLayout * parallelRowLayout);
+
+    void placeRowsOfTask(std::size_t taskIndex,
+                         ParallelRowLayout * parallelRowLayout);
+
+    void layoutRowsInParallel(RowLayout * thisRowLayout,
+                              int initialXOffset,
+                              int initialYOffset,
+                              int * containerHeight,
+                              int * maxRowWidth);
+
+    bool growUiComponentsInRow(std::size_t rowIndex,
+                               int remainingWidth);
+
+    void growRowsVertically(int remainingHeight);
 
-    void moveUiComponentsBelowDown(std::size_t rowIndex,
-                                   int remainingHeight);
+    void moveRowDown(std::size_t rowIndex,
+                     int distance);
 
-    void applyAllSizes();
+    std::size_t getUiComponentCount() const;
 
-    void applyAllLocations();
+    void countBufferGrowth(std::size_t requiredSize,
+                           std::size_t capacity);
 
-    void setDrawingEnabled(bool flag);
+    void addIndexedRowWidth(int width);
 
-    void enableAllDrawing();
+    void addChangedBounds(UiComponent * uiComponent,
+                          int x,
+                          int y,
+                          int width,
+                          int height,
+                          int& appliedX,
+                          int& appliedY,
+                          int& appliedWidth,
+                          int& appliedHeight);
 
-    void disableAllDrawing();
+    void collectChangedBoundsInRow(RowLayout::Row * row);
+
+    void collectChangedBounds();
+
+    void commitChangedBounds(UiComponent * container);
+
+    void growAndAlignRow(RowLayout * thisRowLayout,
+                         std::size_t rowIndex,
+                         UiComponent * container);
 
     void postLayout(RowLayout * thisRowLayout, UiComponent * container);
 
+    void addHitBounds(RowLayout::Row * row,
+                      UiComponent * uiComponent,
+                      int x,
+                      int y,
+                      int width,
+                      int height);
+
+    void setIndexedRowExtent(std::size_t rowIndex,
+                             int height,
+                             int width);
+
+    void forgetIndexedRowExtent(std::size_t rowIndex);
+
+    void updateRowOffsetIndex(std::size_t rowIndex);
+
+    int getRowTop(std::size_t rowIndex) const;
+
+    int getEstimatedRowHeight();
+
+    void findRowsInViewport(int initialYOffset,
+                            std::size_t * firstRowIndex,
+                            std::size_t * endRowIndex);
+
+    void layoutViewport(RowLayout * thisRowLayout, UiComponent * container);
+
+    void getMeasuredSizes(UiComponentWrapper * uiComponentWrapper,
+                          int * uiComponentWidth,
+                          int * uiComponentHeight,
+                          int * labelWidth,
+                          int * labelHeight);
+
+    void measureRow(std::size_t rowIndex,
+                    int * rowWidth,
+                    int * rowHeight);
+
+    void measure(int availableWidth,
+                 LayoutMeasurement * layoutMeasurement);
+
+    void takeSnapshot(UiComponent * container,
+                      LayoutSnapshotPrivate * layoutSnapshot);
+
+    bool commit(const LayoutResultPrivate& layoutResult);
+
+    // The allocator supplied by the client, only valid if
+    // hasLayoutAllocator is true. Declared before the pools so that it
+    // outlives them.
+    LayoutAllocator layoutAllocator;
+    bool hasLayoutAllocator;
+
+    // The memory for rows, label rows, wrappers and constraints is carved out
+    // of these pools. Wrappers and constraints are trivially destructible, so
+    // they are released in bulk when every uiComponent is removed.
+    ObjectPool<RowLayout::Row> rowPool;
+    ObjectPool<RowLayout::Row::RowPrivate> rowPrivatePool;
+    ObjectPool<LabelRow> labelRowPool;
+    ObjectPool<UiComponentWrapper> uiComponentWrapperPool;
+    ObjectPool<UiComponentConstraints> uiComponentConstraintsPool;
+
     UiComponent * rowLayoutContainer;
 
+    // The scheduler supplied by the client, only valid if hasLayoutScheduler
+    // is true.
+    LayoutScheduler layoutScheduler;
+    bool hasLayoutScheduler;
+
+    // The observer supplied by the client, only valid if
+    // hasLayoutPhaseObserver is true.
+    LayoutPhaseObserver layoutPhaseObserver;
+    bool hasLayoutPhaseObserver;
+
+    // The tracer supplied by the client or nullptr.
+    LayoutTracer * layoutTracer;
+
+    // True if RowLayout::executeLayout records layoutStats.
+    bool layoutStatsEnabled;
+
+    // True while RowLayout::executeLayout records layoutStats. Only checked
+    // on the thread that runs the layout pass.
+    bool recordingLayoutStats;
+
+    // The stats of the last recorded layout pass.
+    LayoutStats layoutStats;
+
+    // True if this layout changed since the last layout pass.
+    bool layoutPending;
+
+    // Incremented every time this layout changes. A LayoutResult can only be
+    // committed if it was computed from a snapshot of the current revision.
+    std::size_t layoutRevision;
+
+    // The threads that measure the uiComponents and lay out the rows during
+    // a layout pass.
+    LayoutThreadPool layoutThreadPool;
+
+    // The uiComponents that are measured on the threads of layoutThreadPool
+    // during the current layout pass. Kept between layout passes to reuse the
+    // memory.
+    std::vector<UiComponentWrapper *> threadSafeMeasurements;
+
+    // How the label of the uiComponent at the same index of
+    // threadSafeMeasurements gets its size, a LabelMeasurement value.
+    std::vector<unsigned char> threadSafeLabelMeasurements;
+
+    // The metrics of the DPI this layout lays out at.
+    const LayoutMetrics * layoutMetrics;
+
+    // The measured sizes at every other DPI this layout was laid out at.
+    std::map<int, MeasuredSizes> measuredSizesByDpi;
+
+    // The sizes of the labels that implement IMeasurableText, keyed by font
+    // and text, for every DPI this layout was laid out at. Text measures
+    // differently at each DPI.
+    std::map<int, LabelMeasurementCache> labelMeasurementCaches;
+
+    // The label measurement cache of the current DPI.
+    LabelMeasurementCache * labelMeasurementCache;
+
+    std::size_t labelMeasurementCacheCapacity;
+
     RowLayout::Row * currentRow;
 
     std::vector<RowLayout::Row *> rows;
 
+    // The layout state of every uiComponent in this layout, indexed by
+    // UiComponentWrapper::id.
+    UiComponentInternals uiComponentInternals;
+
+    // True if the ids of the uiComponents in each row are contiguous and
+    // in row order. See RowLayoutPrivate::compactUiComponentIds.
+    bool uiComponentIdsInRowOrder;
+
+    // Maps every uiComponent and every label in this layout to its wrapper,
+    // which knows the row and the slot within the row.
+    std::unordered_map<const UiComponent *, UiComponentWrapper *> uiComponentIndex;
+
     // Key   - The size group id - Tip: Clients of RowLayout should use an
     //                               enumeration to specify groups.
     //
-    // Value - Collection of UiComponents that will have the same dimensions
-    //         The first value of the pair specifies the UiComponent from the
-    //         wrapper that is part of the size group
-    std::map<int, std::vector<std::pair<SizeGroupIdentifier, UiComponentWrapper *> > > sizeGroups;
+    // Value - The index of the size group within sizeGroups
+    //
+    // Only used when uiComponents are added, the layout passes use the index
+    // stored in each wrapper.
+    std::map<int, std::size_t> sizeGroupIndices;
+
+    // Every size group in this layout, each a collection of UiComponents that
+    // will have the same dimensions.
+    std::vector<SizeGroup> sizeGroups;
+
+    // The indices of the size groups whose SizeGroup::changed flag is set.
+    std::vector<std::size_t> changedSizeGroups;
 
     int verticalSpaceBetweenRows;
+
+    // True if the vertical space between rows changed since the last layout
+    // pass.
+    bool verticalSpaceBetweenRowsChanged;
+
+    // The number of setSize and setLocation calls that were skipped because
+    // the bounds of the label or uiComponent did not change.
+    std::size_t skippedBoundsCallCount;
+
+    // The bounds of the labels and uiComponents that changed during the
+    // current layout pass. Kept between layout passes to reuse the memory.
+    std::vector<UiComponentBounds> changedBounds;
+
+    // The number of uiComponents in this layout that grow vertically. Growing
+    // vertically depends on the height of every row, so every row is laid out
+    // again while this is greater than 0.
+    std::size_t growYCount;
+
+    // True if any uiComponent grew vertically during the last layout pass.
+    bool grewVertically;
+
+    // True if only the rows that intersect the vertical range [viewportY,
+    // viewportY + viewportHeight) of the container are laid out. See
+    // RowLayout::setViewport.
+    bool hasViewport;
+    int viewportY;
+    int viewportHeight;
+
+    // The height of the rows that were never laid out while a viewport is set
+    // or 0 to use the average height of the rows that were laid out.
+    int estimatedRowHeight;
+
+    // The height of every row as of the last layout pass, the vertical space
+    // above each row but the first included. The first row starts at
+    // rowOffsetOrigin and the rows that were never laid out take up
+    // indexedEstimatedRowHeight.
+    RowOffsetIndex rowOffsetIndex;
+    int rowOffsetOrigin;
+    int indexedEstimatedRowHeight;
+
+    // The sum and the number of the heights in rowOffsetIndex of the rows
+    // that had uiComponents when they were indexed. Their average is the
+    // estimated row height unless estimatedRowHeight is set.
+    long long indexedRowHeightSum;
+    std::size_t indexedRowHeightCount;
+
+    // The number of rows in rowOffsetIndex of each width. The largest width
+    // is the width of the widest row.
+    std::map<int, std::size_t> indexedRowWidthCounts;
+
+    // The rows that are moved and applied by a layout pass with a viewport:
+    // the rows in view and the rows laid out during the layout pass. Kept
+    // between layout passes to reuse the memory.
+    std::vector<std::size_t> viewportRowIndices;
+
+    // The container and its metrics during the last layout pass. If any of
+    // these change, every row is laid out again.
+    UiComponent * lastContainer;
+    int lastContainerClientWidth;
+    int lastContainerClientHeight;
+    Padding lastContainerPadding;
 };
 
 
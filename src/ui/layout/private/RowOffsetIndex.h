@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: RowOffsetIndex.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_PRIVATE_ROWOFFSETINDEX_H_
+#define UI_LAYOUT_PRIVATE_ROWOFFSETINDEX_H_
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * The heights of the rows of a layout kept as prefix sums (a Fenwick tree),
+ * so that the y-offset of a row and the row at a y-offset are found in
+ * logarithmic time and a single height is changed in logarithmic time.
+ *
+ * The height of a row may be unknown, in which case an estimated height that
+ * is supplied with each query is used instead. Heights must not be negative.
+ */
+class RowOffsetIndex
+{
+  public:
+
+    RowOffsetIndex();
+
+    ~RowOffsetIndex();
+
+    std::size_t size() const;
+
+    /**
+     * Add a row with an unknown height after the last row.
+     */
+    void append();
+
+    /**
+     * Set the height of the specified row.
+     *
+     * @param[in] index the index of the row.
+     *
+     * @param[in] height the height of the row in pixels.
+     */
+    void setHeight(std::size_t index,
+                   int height);
+
+    /**
+     * Forget the height of the specified row.
+     *
+     * @param[in] index the index of the row.
+     */
+    void setUnknown(std::size_t index);
+
+    /**
+     * Return the sum of the heights of the rows before the specified row.
+     *
+     * @param[in] index the index of the row, may be size() to get the height
+     * of every row.
+     *
+     * @param[in] estimatedHeight the height of each row whose height is
+     * unknown.
+     *
+     * @return the y-offset of the specified row relative to the first row.
+     */
+    int getOffset(std::size_t index,
+                  int estimatedHeight) const;
+
+    /**
+     * Return the index of the row that contains the specified y-offset.
+     *
+     * @param[in] offset the y-offset relative to the first row.
+     *
+     * @param[in] estimatedHeight the height of each row whose height is
+     * unknown.
+     *
+     * @return the index of the row or size() if no row contains the specified
+     * offset.
+     */
+    std::size_t find(int offset,
+                     int estimatedHeight) const;
+
+  private:
+
+    void add(std::size_t index,
+             int height,
+             int unknownCount);
+
+    // The partial sums of the known heights and of the number of rows whose
+    // height is unknown. Element i - 1 holds the sum over the rows
+    // [i - (i & -i), i).
+    std::vector<int> heightTree;
+    std::vector<int> unknownCountTree;
+
+    // The height of each row, only valid if known is set.
+    std::vector<int> heights;
+    std::vector<unsigned char> known;
+};
+#endif /* UI_LAYOUT_PRIVATE_ROWOFFSETINDEX_H_ */
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: SizeGroup.h
+//
+// Author: Raynard Brown
+//
+// Copyright (c) 2020 Raynard Brown
+//
+// All rights reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UI_LAYOUT_PRIVATE_SIZEGROUP_H_
+#define UI_LAYOUT_PRIVATE_SIZEGROUP_H_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+struct UiComponentWrapper;
+
+// Which UiComponent in the UiComponent wrapper is part of the size group
+enum SizeGroupIdentifier
+{
+  LabelGroup,
+  UiComponentGroup
+};
+
+/**
+ * The members of one size group together with the largest measured width and
+ * height among them.
+ *
+ * The measured sizes of the members are the leaves of a max tree, so changing
+ * the size of one member updates the maximum of the group in O(log n) without
+ * looking at the other members.
+ */
+class SizeGroup
+{
+  public:
+
+    SizeGroup();
+
+    /**
+     * Add a member to this size group. The member starts out with a size of
+     * zero until it is updated.
+     *
+     * @param[in] sizeGroupIdentifier specifies whether the label or the
+     * uiComponent of the wrapper is the member.
+     *
+     * @param[in] uiComponentWrapper the wrapper of the member.
+     *
+     * @return the slot of the new member within this size group.
+     */
+    std::size_t add(SizeGroupIdentifier sizeGroupIdentifier,
+                    UiComponentWrapper * uiComponentWrapper);
+
+    /**
+     * Remove the member in the specified slot. The last member takes the place
+     * of the removed member and its slot in the wrapper is updated.
+     *
+     * @param[in] slot the slot of the member to remove.
+     */
+    void remove(std::size_t slot);
+
+    /**
+     * Set the measured size of the member in the specified slot.
+     *
+     * @param[in] slot the slot of the member.
+     *
+     * @param[in] width the measured width of the member.
+     *
+     * @param[in] height the measured height of the member.
+     *
+     * @return true if the size of the member changed, false otherwise.
+     */
+    bool update(std::size_t slot, int width, int height);
+
+    int getMaxWidth() const;
+
+    int getMaxHeight() const;
+
+    std::size_t getMemberCount() const;
+
+    SizeGroupIdentifier getSizeGroupIdentifierAt(std::size_t slot) const;
+
+    UiComponentWrapper * getUiComponentWrapperAt(std::size_t slot) const;
+
+    // The width and height that were given to the members of this size group
+    // during the last layout pass.
+    int lastMaxWidth;
+    int lastMaxHeight;
+
+    // True if the size of a member changed or a member was removed since the
+    // last layout pass. Maintained by the owner of this size group.
+    bool changed;
+
+  private:
+
+    void grow();
+
+    std::vector<std::pair<SizeGroupIdentifier, UiComponentWrapper *> > members;
+
+    // The max trees of the widths and heights. Node i is the maximum of nodes
+    // 2i and 2i + 1, the leaves start at index capacity and the root is at
+    // index 1.
+    std::vector<int> maxWidths;
+    std::vector<int> maxHeights;
+
+    std::size_t capacity;
+};
+#endif /* UI_LAYOUT_PRIVATE_SIZEGROUP_H_ */
@@ -13,25 +13,129 @@
 #ifndef UI_LAYOUT_PRIVATE_UICOMPONENTINTERNALS_H_
 #define UI_LAYOUT_PRIVATE_UICOMPONENTINTERNALS_H_
 
+#include <climits>
+#include <cstddef>
+#include <vector>
+
+class UiComponent;
+class Label;
+class IMeasurableText;
+class IThreadSafeMeasurable;
+
+/**
+ * The layout state of every uiComponent in a RowLayout, stored as one
+ * contiguous array per field. The state of a uiComponent lives at the index
+ * given by UiComponentWrapper::id in every array.
+ *
+ * During a layout pass the ids of the uiComponents in each row are contiguous
+ * and in row order, so the layout passes are linear scans over these arrays.
+ */
 struct UiComponentInternals
 {
-    int labelPreferredHeight;
-    int labelPreferredWidth;
+    enum
+    {
+      // The applied bounds of a uiComponent that was never applied.
+      NotApplied = INT_MIN
+    };
+
+    /**
+     * Add the state for a new uiComponent and its associated label, if any.
+     *
+     * @param[in] uiComponent the uiComponent.
+     *
+     * @param[in] labelPeer the label associated with the uiComponent or nullptr
+     * if there is no associated label.
+     *
+     * @return the id of the new uiComponent.
+     */
+    std::size_t add(UiComponent * uiComponent, Label * labelPeer);
+
+    /**
+     * Append a copy of the state of the uiComponent with the specified id in
+     * the specified source.
+     *
+     * @param[in] source the state to copy from.
+     *
+     * @param[in] id the id of the uiComponent within the source.
+     *
+     * @return the id of the copy.
+     */
+    std::size_t addCopy(const UiComponentInternals& source, std::size_t id);
+
+    /**
+     * Forget the uiComponent with the specified id. The id is not reused until
+     * the ids are compacted.
+     *
+     * @param[in] id the id of the uiComponent to forget.
+     */
+    void remove(std::size_t id);
+
+    /**
+     * Forget the bounds that were last applied to every label and uiComponent
+     * so that the next layout pass applies all of them again.
+     */
+    void forgetAppliedBounds();
+
+    std::size_t size() const;
+
+    void reserve(std::size_t capacity);
+
+    void clear();
+
+    void swap(UiComponentInternals& other);
 
-    int uiComponentPreferredWidth;
-    int uiComponentPreferredHeight;
+    std::vector<UiComponent *> uiComponent;
+    std::vector<Label *> labelPeer;
+
+    // The uiComponent and the label as IThreadSafeMeasurable or nullptr if
+    // they do not implement it.
+    std::vector<IThreadSafeMeasurable *> uiComponentMeasurable;
+    std::vector<IThreadSafeMeasurable *> labelMeasurable;
+
+    // The label as IMeasurableText or nullptr if it does not implement it.
+    std::vector<IMeasurableText *> labelText;
+
+    // The last size reported by the label and the uiComponent. These are only
+    // refreshed when the uiComponent needs to be measured again.
+    std::vector<int> labelMeasuredWidth;
+    std::vector<int> labelMeasuredHeight;
+
+    std::vector<int> uiComponentMeasuredWidth;
+    std::vector<int> uiComponentMeasuredHeight;
+
+    // Non-zero if the label and the uiComponent must be measured again during
+    // the next layout pass.
+    std::vector<unsigned char> needsMeasure;
+
+    std::vector<int> labelPreferredHeight;
+    std::vector<int> labelPreferredWidth;
+
+    std::vector<int> uiComponentPreferredWidth;
+    std::vector<int> uiComponentPreferredHeight;
 
     // used as a cache to avoid flickering
-    int labelX;
+    std::vector<int> labelX;
     // used as a cache to avoid flickering
-    int labelY;
+    std::vector<int> labelY;
 
     // used as a cache to avoid flickering
-    int uiComponentX;
+    std::vector<int> uiComponentX;
     // used as a cache to avoid flickering
-    int uiComponentY;
+    std::vector<int> uiComponentY;
+
+    std::vector<int> horizontalGapLeft;
+    std::vector<int> horizontalGapRight;
+
+    // The bounds that were last applied to the label and the uiComponent or
+    // NotApplied if none were applied yet.
+    std::vector<int> labelAppliedX;
+    std::vector<int> labelAppliedY;
+    std::vector<int> labelAppliedWidth;
+    std::vector<int> labelAppliedHeight;
 
-    int horizontalGapLeft;
-    int horizontalGapRight;
+    std::vector<int> uiComponentAppliedX;
+    std::vector<int> uiComponentAppliedY;
+    std::vector<int> uiComponentAppliedWidth;
+    std::vector<int> uiComponentAppliedHeight;
 };
 #endif /* UI_LAYOUT_PRIVATE_UICOMPONENTINTERNALS_H_ */
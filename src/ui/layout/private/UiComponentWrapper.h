@@ -13,16 +13,38 @@
 #ifndef UI_LAYOUT_PRIVATE_UICOMPONENTWRAPPER_H_
 #define UI_LAYOUT_PRIVATE_UICOMPONENTWRAPPER_H_
 
+#include <cstddef>
+
+#include "ui/layout/RowLayout.h"
+
 class UiComponent;
 class Label;
 struct UiComponentConstraints;
-struct UiComponentInternals;
 
 struct UiComponentWrapper
 {
     UiComponent * uiComponent;
     Label * labelPeer;
     UiComponentConstraints * uiComponentConstraints;
-    UiComponentInternals * uiComponentInternals;
+
+    // The index of the layout state of this wrapper within
+    // RowLayoutPrivate::uiComponentInternals.
+    std::size_t id;
+
+    // The row that owns this wrapper.
+    RowLayout::Row * row;
+
+    // The index of this wrapper within the uiComponents of its row, which may
+    // still contain the holes left by removed uiComponents.
+    std::size_t slot;
+
+    // The index of the size group and the label size group of this wrapper
+    // within RowLayoutPrivate::sizeGroups and the index of this wrapper within
+    // each of them. Only valid if the constraints specify the respective
+    // group.
+    std::size_t sizeGroupIndex;
+    std::size_t sizeGroupSlot;
+    std::size_t labelSizeGroupIndex;
+    std::size_t labelSizeGroupSlot;
 };
 #endif /* UI_LAYOUT_PRIVATE_UICOMPONENTWRAPPER_H_ */
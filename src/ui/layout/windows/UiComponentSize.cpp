@@ -45,3 +45,15 @@ UiComponentSize::~UiComponentSize()
    */
   return 15;
 }
+
+/*static*/ int UiComponentSize::getVerticalSpaceBetweenRows()
+{
+  // The UXGuide.pdf spacing between unrelated controls, 11 pixels at 96 DPI.
+  return 11;
+}
+
+/*static*/ int UiComponentSize::getHorizontalGap()
+{
+  // The UXGuide.pdf spacing between related controls, 7 pixels at 96 DPI.
+  return 7;
+}